@@ -0,0 +1,158 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.hpp"
+#include "allocation_hooks.hpp"
+#include "stream_flag_guard.hpp"
+#include <sys/resource.h>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <ios>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::ostream;
+using std::right;
+using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+namespace bench
+{
+
+namespace
+{
+    int const k_name_width = 40;
+    int const k_column_width = 14;
+
+    volatile size_t s_sink = 0;
+
+    double peak_rss_megabytes()
+    {
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+        return usage.ru_maxrss / 1024.0;  // ru_maxrss is in kilobytes on Linux
+    }
+
+    void print_duration(ostream& p_os, double p_seconds)
+    {
+        StreamFlagGuard guard(p_os);
+        p_os << fixed << setprecision(2) << setw(k_column_width - 3) << right;
+        if (p_seconds >= 1.0) p_os << p_seconds << " s ";
+        else if (p_seconds >= 1e-3) p_os << p_seconds * 1e3 << " ms";
+        else if (p_seconds >= 1e-6) p_os << p_seconds * 1e6 << " us";
+        else p_os << p_seconds * 1e9 << " ns";
+        p_os << "   ";
+    }
+
+}  // end anonymous namespace
+
+Harness::Harness
+(   ostream& p_os,
+    vector<string> const& p_filters,
+    double p_min_seconds
+):
+    m_os(p_os),
+    m_filters(p_filters),
+    m_min_seconds(p_min_seconds)
+{
+#   ifndef __OPTIMIZE__
+        m_os << "Warning: benchmarks were built without optimization; "
+             << "configure with -D CMAKE_BUILD_TYPE=Release." << endl;
+#   endif
+    StreamFlagGuard guard(m_os);
+    m_os << left << setw(k_name_width) << "benchmark" << right
+         << setw(k_column_width) << "iterations"
+         << setw(k_column_width) << "time/iter"
+         << setw(k_column_width) << "items/s"
+         << setw(k_column_width) << "allocs/iter"
+         << setw(k_column_width) << "bytes/iter"
+         << setw(k_column_width) << "peak RSS MB"
+         << endl;
+}
+
+Harness::~Harness() = default;
+
+bool
+Harness::is_selected(string const& p_name) const
+{
+    if (m_filters.empty()) return true;
+    for (auto const& filter: m_filters)
+    {
+        if (p_name.find(filter) != string::npos) return true;
+    }
+    return false;
+}
+
+void
+Harness::run(string const& p_name, Setup const& p_setup)
+{
+    if (!is_selected(p_name)) return;
+    auto const body = p_setup();
+
+    // One untimed iteration, to warm caches and trigger any lazy
+    // initialization.
+    do_not_optimize(body());
+
+    auto const allocations_before = allocation_counts();
+    auto const start = chrono::steady_clock::now();
+    size_t iterations = 0;
+    size_t items = 0;
+    double elapsed = 0.0;
+    do
+    {
+        items += body();
+        ++iterations;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    while (elapsed < m_min_seconds);
+    auto const allocations_after = allocation_counts();
+
+    StreamFlagGuard guard(m_os);
+    m_os << left << setw(k_name_width) << p_name << right
+         << setw(k_column_width) << iterations;
+    print_duration(m_os, elapsed / iterations);
+    m_os << fixed << setprecision(0)
+         << setw(k_column_width) << (items / elapsed)
+         << setw(k_column_width)
+         << (allocations_after.allocations - allocations_before.allocations) /
+                static_cast<double>(iterations)
+         << setw(k_column_width)
+         << (allocations_after.bytes - allocations_before.bytes) /
+                static_cast<double>(iterations)
+         << setw(k_column_width) << setprecision(1) << peak_rss_megabytes()
+         << endl;
+}
+
+void
+do_not_optimize(size_t p_value)
+{
+    s_sink = s_sink + p_value;
+}
+
+}  // namespace bench
+}  // namespace swx
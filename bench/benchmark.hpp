@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_benchmark_hpp_3390185267741036
+#define GUARD_benchmark_hpp_3390185267741036
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+namespace bench
+{
+
+/**
+ * Runs benchmarks and prints a line of results for each of them.
+ */
+class Harness
+{
+// nested types
+public:
+
+    /**
+     * Performs one iteration of a benchmark, returning the number of items
+     * (entries, stints, calls, etc.) it processed.
+     */
+    using Body = std::function<std::size_t()>;
+
+    /**
+     * Performs any set-up required by a benchmark, returning its Body.
+     */
+    using Setup = std::function<Body()>;
+
+// special member functions
+public:
+
+    /**
+     * Only benchmarks whose names contain one of \e p_filters as a
+     * substring will be run (all are run if \e p_filters is empty). Each
+     * is iterated for at least \e p_min_seconds, and at least once.
+     */
+    Harness
+    (   std::ostream& p_os,
+        std::vector<std::string> const& p_filters,
+        double p_min_seconds
+    );
+    Harness(Harness const& rhs) = delete;
+    Harness(Harness&& rhs) = delete;
+    Harness& operator=(Harness const& rhs) = delete;
+    Harness& operator=(Harness&& rhs) = delete;
+    ~Harness();
+
+// ordinary member functions
+public:
+
+    /**
+     * If the benchmark is selected, call \e p_setup and run the Body it
+     * returns, printing the mean time per iteration, throughput, mean
+     * allocations per iteration and the peak resident set size of the
+     * process so far. Set-up is not timed.
+     */
+    void run(std::string const& p_name, Setup const& p_setup);
+
+private:
+    bool is_selected(std::string const& p_name) const;
+
+// member variables
+private:
+    std::ostream& m_os;
+    std::vector<std::string> m_filters;
+    double m_min_seconds;
+
+};  // class Harness
+
+/**
+ * Prevents the compiler from discarding a computation whose result is
+ * otherwise unused.
+ */
+void do_not_optimize(std::size_t p_value);
+
+}  // namespace bench
+}  // namespace swx
+
+#endif  // GUARD_benchmark_hpp_3390185267741036
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_benchmarks_hpp_5268300917465243
+#define GUARD_benchmarks_hpp_5268300917465243
+
+#include "benchmark.hpp"
+#include "synthetic_logs.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+namespace bench
+{
+
+/**
+ * @returns a short label for a log size, e.g. "100k" for 100000.
+ */
+std::string size_label(std::size_t p_num_entries);
+
+/**
+ * Benchmarks loading a TimeLog of each of \e p_sizes entries, and
+ * extracting stints from the largest of them with each type of
+ * ActivityFilter.
+ */
+void run_time_log_benchmarks
+(   Harness& p_harness,
+    SyntheticLogs& p_logs,
+    std::vector<std::size_t> const& p_sizes
+);
+
+/**
+ * Benchmarks ActivityTree construction and each kind of ReportWriter, over
+ * the stints of a log of \e p_num_entries entries.
+ */
+void run_report_benchmarks
+(   Harness& p_harness,
+    SyntheticLogs& p_logs,
+    std::size_t p_num_entries
+);
+
+/**
+ * Benchmarks timestamp formatting and parsing, CsvRow and the string
+ * utilities.
+ */
+void run_string_benchmarks(Harness& p_harness, SyntheticLogs& p_logs);
+
+}  // namespace bench
+}  // namespace swx
+
+#endif  // GUARD_benchmarks_hpp_5268300917465243
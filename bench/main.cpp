@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.hpp"
+#include "benchmarks.hpp"
+#include "synthetic_logs.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::stringstream;
+using std::vector;
+using swx::bench::Harness;
+using swx::bench::SyntheticLogs;
+using swx::bench::run_report_benchmarks;
+using swx::bench::run_string_benchmarks;
+using swx::bench::run_time_log_benchmarks;
+
+namespace
+{
+    string const k_usage =
+        "Usage: swx_bench [--min-time SECONDS] [--max-entries N] [FILTER...]\n"
+        "\n"
+        "Runs the benchmarks whose names contain any FILTER (or all of them,\n"
+        "if none is given), iterating each for at least SECONDS (default 0.5).\n"
+        "Synthetic logs of up to N entries (default 1000000) are used.";
+
+    // Should match the defaults in Config.
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    unsigned int const k_formatted_buf_len = 50;
+
+    // Size of the log used by benchmarks other than loading.
+    size_t const k_reporting_entries = 100000;
+
+    template <typename T>
+    T parse_arg(string const& p_option, string const& p_arg)
+    {
+        T ret;
+        stringstream ss(p_arg);
+        ss >> ret;
+        if (!ss || !ss.eof())
+        {
+            throw runtime_error("Could not parse argument to " + p_option + ": " + p_arg);
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Results should not depend on the local time zone, nor on
+        // whether the synthetic logs span daylight saving transitions.
+        setenv("TZ", "UTC", 1);
+        tzset();
+
+        double min_seconds = 0.5;
+        size_t max_entries = 1000000;
+        vector<string> filters;
+        for (int i = 1; i < argc; ++i)
+        {
+            string const arg(argv[i]);
+            if ((arg == "--min-time" || arg == "--max-entries") && (i + 1 < argc))
+            {
+                string const value(argv[++i]);
+                if (arg == "--min-time") min_seconds = parse_arg<double>(arg, value);
+                else max_entries = parse_arg<size_t>(arg, value);
+            }
+            else if (arg == "-h" || arg == "--help")
+            {
+                cout << k_usage << endl;
+                return EXIT_SUCCESS;
+            }
+            else if (!arg.empty() && arg[0] == '-')
+            {
+                cerr << k_usage << endl;
+                return EXIT_FAILURE;
+            }
+            else
+            {
+                filters.push_back(arg);
+            }
+        }
+
+        vector<size_t> sizes;
+        for (size_t const size: {1000, 100000, 1000000})
+        {
+            if (size <= max_entries) sizes.push_back(size);
+        }
+        auto const reporting_entries =
+            (max_entries < k_reporting_entries ? max_entries : k_reporting_entries);
+
+        SyntheticLogs logs(k_time_format, k_formatted_buf_len);
+        Harness harness(cout, filters, min_seconds);
+        run_time_log_benchmarks(harness, logs, sizes);
+        run_report_benchmarks(harness, logs, reporting_entries);
+        run_string_benchmarks(harness, logs);
+        return EXIT_SUCCESS;
+    }
+    catch (runtime_error& e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+}
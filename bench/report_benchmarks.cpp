@@ -0,0 +1,169 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmarks.hpp"
+#include "activity_filter.hpp"
+#include "activity_stats.hpp"
+#include "activity_tree.hpp"
+#include "benchmark.hpp"
+#include "interval.hpp"
+#include "report_writer.hpp"
+#include "stint.hpp"
+#include "synthetic_logs.hpp"
+#include "time_log.hpp"
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::make_shared;
+using std::map;
+using std::ostream;
+using std::ostringstream;
+using std::shared_ptr;
+using std::size_t;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+namespace bench
+{
+
+namespace
+{
+    // Holds a TimeLog together with its stints, which refer to activity
+    // names owned by the TimeLog.
+    struct StintData
+    {
+        StintData(SyntheticLogs& p_logs, size_t p_num_entries):
+            time_log
+            (   p_logs.filepath(p_num_entries),
+                p_logs.time_format(),
+                p_logs.formatted_buf_len()
+            ),
+            filter(ActivityFilter::create("", ActivityFilter::Type::always_true)),
+            stints(time_log.get_stints(*filter, nullptr, nullptr))
+        {
+        }
+
+        TimeLog time_log;
+        unique_ptr<ActivityFilter> const filter;
+        vector<Stint> const stints;
+    };
+
+    map<string, ActivityStats> stats_by_activity(vector<Stint> const& p_stints)
+    {
+        map<string, ActivityStats> ret;
+        for (auto const& stint: p_stints)
+        {
+            auto const interval = stint.interval();
+            auto const seconds = interval.duration().count();
+            auto const beginning = interval.beginning();
+            auto const ending = beginning + chrono::seconds(seconds);
+            ret[stint.activity()] += ActivityStats(seconds, beginning, ending);
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+void
+run_report_benchmarks
+(   Harness& p_harness,
+    SyntheticLogs& p_logs,
+    size_t p_num_entries
+)
+{
+    auto const label = size_label(p_num_entries);
+    shared_ptr<StintData> data;
+    auto const get_data = [&]()
+    {
+        if (!data) data = make_shared<StintData>(p_logs, p_num_entries);
+        return data;
+    };
+
+    p_harness.run
+    (   "report/activity_tree/" + label,
+        [&]()
+        {
+            auto const stats = make_shared<map<string, ActivityStats>>
+            (   stats_by_activity(get_data()->stints)
+            );
+            return [stats]()
+            {
+                ActivityTree const tree(*stats);
+                do_not_optimize(stats->size());
+                return stats->size();
+            };
+        }
+    );
+
+    struct WriterCase
+    {
+        string name;
+        ReportWriter::Flags::Type flags;
+    };
+    using Flags = ReportWriter::Flags;
+    vector<WriterCase> const writer_cases
+    {   {"summary", Flags::none},
+        {"summary_flat", Flags::verbose},
+        {"summary_succinct", Flags::succinct},
+        {"summary_csv", Flags::csv},
+        {"list", Flags::show_stints},
+        {"list_csv", Flags::show_stints | Flags::csv}
+    };
+    for (auto const& writer_case: writer_cases)
+    {
+        p_harness.run
+        (   "report/" + writer_case.name + "/" + label,
+            [&]()
+            {
+                auto const stint_data = get_data();
+                auto const options = make_shared<ReportWriter::Options>
+                (   1,
+                    4,
+                    1,
+                    6,
+                    p_logs.formatted_buf_len(),
+                    p_logs.time_format(),
+                    0
+                );
+                auto const flags = writer_case.flags;
+                return [stint_data, options, flags]()
+                {
+                    ostringstream oss;
+                    unique_ptr<ReportWriter> const writer
+                    (   ReportWriter::create(stint_data->stints, *options, flags)
+                    );
+                    writer->write(oss);
+                    do_not_optimize(oss.str().size());
+                    return stint_data->stints.size();
+                };
+            }
+        );
+    }
+}
+
+}  // namespace bench
+}  // namespace swx
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmarks.hpp"
+#include "benchmark.hpp"
+#include "csv_row.hpp"
+#include "string_utilities.hpp"
+#include "synthetic_logs.hpp"
+#include "time_point.hpp"
+#include <chrono>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::istringstream;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+namespace bench
+{
+
+namespace
+{
+    size_t const k_batch_size = 1000;
+
+}  // end anonymous namespace
+
+void
+run_string_benchmarks(Harness& p_harness, SyntheticLogs& p_logs)
+{
+    auto const& time_format = p_logs.time_format();
+    auto const buf_len = p_logs.formatted_buf_len();
+
+    p_harness.run
+    (   "time_point/time_point_to_stamp",
+        [&]()
+        {
+            auto const start = now();
+            return [&, start]()
+            {
+                for (size_t i = 0; i != k_batch_size; ++i)
+                {
+                    auto const time_point = start - chrono::minutes(i * 17);
+                    auto const stamp = time_point_to_stamp(time_point, time_format, buf_len);
+                    do_not_optimize(stamp.size());
+                }
+                return k_batch_size;
+            };
+        }
+    );
+
+    p_harness.run
+    (   "time_point/long_time_stamp_to_point",
+        [&]()
+        {
+            vector<string> stamps;
+            auto const start = now();
+            for (size_t i = 0; i != k_batch_size; ++i)
+            {
+                stamps.push_back
+                (   time_point_to_stamp(start - chrono::minutes(i * 17), time_format, buf_len)
+                );
+            }
+            return [&time_format, stamps]()
+            {
+                for (auto const& stamp: stamps)
+                {
+                    auto const time_point = long_time_stamp_to_point(stamp, time_format);
+                    do_not_optimize(time_point.time_since_epoch().count());
+                }
+                return stamps.size();
+            };
+        }
+    );
+
+    p_harness.run
+    (   "string/csv_row/write",
+        [&]()
+        {
+            return []()
+            {
+                for (size_t i = 0; i != k_batch_size; ++i)
+                {
+                    CsvRow row;
+                    row << "2018-01-01T09:00" << "2018-01-01T10:30"
+                        << 1.5 << "client3 project12 \"urgent\", task7";
+                    do_not_optimize(row.str().size());
+                }
+                return k_batch_size;
+            };
+        }
+    );
+
+    p_harness.run
+    (   "string/csv_row/read",
+        [&]()
+        {
+            string text;
+            for (size_t i = 0; i != k_batch_size; ++i)
+            {
+                text += "2018-01-01T09:00,2018-01-01T10:30,1.5,"
+                    "\"client3 project12 \"\"urgent\"\", task7\"\n";
+            }
+            return [text]()
+            {
+                istringstream iss(text);
+                vector<string> cells;
+                size_t rows = 0;
+                while (read_csv_row(iss, cells)) ++rows;
+                return rows;
+            };
+        }
+    );
+
+    string const activity = "  client3   project12 \t task7 subtask2  ";
+    p_harness.run
+    (   "string/split",
+        [&]()
+        {
+            return [&activity]()
+            {
+                for (size_t i = 0; i != k_batch_size; ++i)
+                {
+                    do_not_optimize(split(activity).size());
+                }
+                return k_batch_size;
+            };
+        }
+    );
+    p_harness.run
+    (   "string/trim",
+        [&]()
+        {
+            return [&activity]()
+            {
+                for (size_t i = 0; i != k_batch_size; ++i)
+                {
+                    do_not_optimize(trim(activity).size());
+                }
+                return k_batch_size;
+            };
+        }
+    );
+}
+
+}  // namespace bench
+}  // namespace swx
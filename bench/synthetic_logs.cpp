@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "synthetic_logs.hpp"
+#include "log_generator.hpp"
+#include <unistd.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::getenv;
+using std::ofstream;
+using std::remove;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+namespace bench
+{
+
+namespace
+{
+    unsigned int const k_seed = 20180101;
+
+    string temporary_filepath()
+    {
+        char const* const tmpdir = getenv("TMPDIR");
+        string pattern = string(tmpdir ? tmpdir : "/tmp") + "/swx_bench_XXXXXX";
+        vector<char> buf(pattern.begin(), pattern.end());
+        buf.push_back('\0');
+        auto const fd = mkstemp(buf.data());
+        if (fd == -1)
+        {
+            throw runtime_error("Could not create temporary file.");
+        }
+        close(fd);
+        return string(buf.data());
+    }
+
+}  // end anonymous namespace
+
+SyntheticLogs::SyntheticLogs
+(   string const& p_time_format,
+    unsigned int p_formatted_buf_len
+):
+    m_time_format(p_time_format),
+    m_formatted_buf_len(p_formatted_buf_len)
+{
+}
+
+SyntheticLogs::~SyntheticLogs()
+{
+    for (auto const& pair: m_filepaths) remove(pair.second.c_str());
+}
+
+string const&
+SyntheticLogs::filepath(size_t p_num_entries)
+{
+    auto const it = m_filepaths.find(p_num_entries);
+    if (it != m_filepaths.end())
+    {
+        return it->second;
+    }
+
+    LogGenerator::Options options;
+    options.num_entries = p_num_entries;
+    options.seed = k_seed;
+    options.time_format = m_time_format;
+    options.formatted_buf_len = m_formatted_buf_len;
+    auto const path = temporary_filepath();
+    ofstream ofs(path.c_str());
+    try
+    {
+        LogGenerator(options).write(ofs);
+    }
+    catch (...)
+    {
+        remove(path.c_str());
+        throw;
+    }
+    return m_filepaths[p_num_entries] = path;
+}
+
+string const&
+SyntheticLogs::time_format() const
+{
+    return m_time_format;
+}
+
+unsigned int
+SyntheticLogs::formatted_buf_len() const
+{
+    return m_formatted_buf_len;
+}
+
+}  // namespace bench
+}  // namespace swx
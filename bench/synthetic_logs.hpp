@@ -0,0 +1,68 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_synthetic_logs_hpp_7720581934462215
+#define GUARD_synthetic_logs_hpp_7720581934462215
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace swx
+{
+namespace bench
+{
+
+/**
+ * Creates time logs of synthetic entries in temporary files, on demand,
+ * and removes them on destruction.
+ */
+class SyntheticLogs
+{
+// special member functions
+public:
+    SyntheticLogs(std::string const& p_time_format, unsigned int p_formatted_buf_len);
+    SyntheticLogs(SyntheticLogs const& rhs) = delete;
+    SyntheticLogs(SyntheticLogs&& rhs) = delete;
+    SyntheticLogs& operator=(SyntheticLogs const& rhs) = delete;
+    SyntheticLogs& operator=(SyntheticLogs&& rhs) = delete;
+    ~SyntheticLogs();
+
+// ordinary member functions
+public:
+
+    /**
+     * @returns the path to a time log of \e p_num_entries entries, created
+     * using LogGenerator if this has not already been done. The same
+     * entries are generated on every run.
+     */
+    std::string const& filepath(std::size_t p_num_entries);
+
+    std::string const& time_format() const;
+    unsigned int formatted_buf_len() const;
+
+// member variables
+private:
+    std::string const m_time_format;
+    unsigned int const m_formatted_buf_len;
+    std::map<std::size_t, std::string> m_filepaths;
+
+};  // class SyntheticLogs
+
+}  // namespace bench
+}  // namespace swx
+
+#endif  // GUARD_synthetic_logs_hpp_7720581934462215
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmarks.hpp"
+#include "activity_filter.hpp"
+#include "benchmark.hpp"
+#include "stint.hpp"
+#include "synthetic_logs.hpp"
+#include "time_log.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using std::make_shared;
+using std::shared_ptr;
+using std::size_t;
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace swx
+{
+namespace bench
+{
+
+string
+size_label(size_t p_num_entries)
+{
+    if (p_num_entries % 1000000 == 0) return to_string(p_num_entries / 1000000) + "M";
+    if (p_num_entries % 1000 == 0) return to_string(p_num_entries / 1000) + "k";
+    return to_string(p_num_entries);
+}
+
+void
+run_time_log_benchmarks
+(   Harness& p_harness,
+    SyntheticLogs& p_logs,
+    vector<size_t> const& p_sizes
+)
+{
+    for (auto const size: p_sizes)
+    {
+        p_harness.run
+        (   "time_log/load/" + size_label(size),
+            [&p_logs, size]()
+            {
+                auto const& filepath = p_logs.filepath(size);
+                return [&p_logs, &filepath, size]()
+                {
+                    // A fresh TimeLog is needed each time, since it caches
+                    // its entries once loaded.
+                    TimeLog time_log
+                    (   filepath,
+                        p_logs.time_format(),
+                        p_logs.formatted_buf_len()
+                    );
+                    do_not_optimize(time_log.is_active());
+                    return size;
+                };
+            }
+        );
+    }
+
+    if (p_sizes.empty()) return;
+    auto const size = p_sizes.back();
+    struct FilterCase
+    {
+        string name;
+        string comparitor;
+        ActivityFilter::Type type;
+    };
+    vector<FilterCase> const filter_cases
+    {   {"always_true", "", ActivityFilter::Type::always_true},
+        {"ordinary", "area1 project2", ActivityFilter::Type::ordinary},
+        {"exact", "area1 project2 task3", ActivityFilter::Type::exact},
+        {"regex", "project[1-3] task1$", ActivityFilter::Type::regex}
+    };
+    for (auto const& filter_case: filter_cases)
+    {
+        p_harness.run
+        (   "time_log/get_stints/" + filter_case.name + "/" + size_label(size),
+            [&p_logs, &filter_case, size]()
+            {
+                auto const time_log = make_shared<TimeLog>
+                (   p_logs.filepath(size),
+                    p_logs.time_format(),
+                    p_logs.formatted_buf_len()
+                );
+                shared_ptr<ActivityFilter> const filter
+                (   ActivityFilter::create(filter_case.comparitor, filter_case.type)
+                );
+                return [time_log, filter, size]()
+                {
+                    auto const stints = time_log->get_stints(*filter, nullptr, nullptr);
+                    do_not_optimize(stints.size());
+                    return size;
+                };
+            }
+        );
+    }
+}
+
+}  // namespace bench
+}  // namespace swx
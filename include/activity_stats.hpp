@@ -17,6 +17,7 @@
 #ifndef GUARD_activity_stats_hpp_743408902428769
 #define GUARD_activity_stats_hpp_743408902428769
 
+#include "duration_sketch.hpp"
 #include "time_point.hpp"
 
 namespace swx
@@ -32,6 +33,9 @@ namespace swx
  *
  * \b ending latest time at which activity was conducted during the
  * reported period
+ *
+ * \b durations the lengths of the individual stints spent on the
+ * activity, if these were recorded (empty otherwise)
  */
 struct ActivityStats
 {
@@ -43,6 +47,7 @@ struct ActivityStats
     unsigned long long seconds;
     TimePoint beginning;
     TimePoint ending;
+    DurationSketch durations;
 
 };  // struct ActivityStats
 
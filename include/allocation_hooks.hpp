@@ -0,0 +1,41 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_allocation_hooks_hpp_7804790750682815
+#define GUARD_allocation_hooks_hpp_7804790750682815
+
+namespace swx
+{
+
+/**
+ * Running totals of the allocations made through the global operator new.
+ * These are kept by the replacement allocation functions in the
+ * swx_allocation_hooks library, which also report each allocation to the
+ * Profiler. Only executables linked with that library (swx_bench always,
+ * and swx when built with SWX_ALLOC_STATS) may call allocation_counts().
+ */
+struct AllocationCounts
+{
+    unsigned long long allocations = 0;
+    unsigned long long bytes = 0;
+};
+
+AllocationCounts allocation_counts();
+
+}  // namespace swx
+
+#endif  // GUARD_allocation_hooks_hpp_7804790750682815
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_analyze_command_hpp_0606146079344778
+#define GUARD_analyze_command_hpp_0606146079344778
+
+#include "activity_filter.hpp"
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class AnalyzeCommand: public Command
+{
+// special member functions
+public:
+    AnalyzeCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    AnalyzeCommand(AnalyzeCommand const& rhs) = delete;
+    AnalyzeCommand(AnalyzeCommand&& rhs) = delete;
+    AnalyzeCommand& operator=(AnalyzeCommand const& rhs) = delete;
+    AnalyzeCommand& operator=(AnalyzeCommand&& rhs) = delete;
+    virtual ~AnalyzeCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// member variables
+private:
+    ActivityFilter::Type m_activity_filter_type = ActivityFilter::Type::ordinary;
+    std::string m_top_str = "10";
+    std::string m_since_str;
+    std::string m_until_str;
+    TimeLog& m_time_log;
+
+};  // class AnalyzeCommand
+
+}  // namespace swx
+
+#endif  // GUARD_analyze_command_hpp_0606146079344778
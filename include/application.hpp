@@ -22,6 +22,7 @@
 #include "exit_code.hpp"
 #include "stream_flag_guard.hpp"
 #include "time_log.hpp"
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -41,8 +42,31 @@ namespace swx
  */
 class Application {
 // nested types
-private: using CommandMap = std::map<std::string, std::shared_ptr<Command>>; using Commands =
-std::vector<std::shared_ptr<Command>>;
+private:
+
+    /**
+     * Holds a factory for a Command, which is only called when the Command
+     * is first needed, so that commands not being run need not be
+     * constructed.
+     */
+    class CommandEntry
+    {
+    public:
+        using Factory = std::function<std::shared_ptr<Command>()>;
+        explicit CommandEntry(Factory const& p_factory);
+        CommandEntry(CommandEntry const& rhs) = delete;
+        CommandEntry(CommandEntry&& rhs) = delete;
+        CommandEntry& operator=(CommandEntry const& rhs) = delete;
+        CommandEntry& operator=(CommandEntry&& rhs) = delete;
+        ~CommandEntry();
+        Command& command() const;
+    private:
+        Factory const m_factory;
+        mutable std::shared_ptr<Command> m_command;
+    };
+
+    using CommandMap = std::map<std::string, std::shared_ptr<CommandEntry>>;
+    using Commands = std::vector<std::shared_ptr<CommandEntry>>;
 
     struct CommandGroup
     {
@@ -60,6 +84,19 @@ public:
         std::ostream& p_ordinary_ostream = std::cout,
         std::ostream& p_error_ostream = std::cerr
     );
+
+    /**
+     * Constructs an Application that operates on \e p_time_log, rather
+     * than on a TimeLog of its own. The caller retains ownership of \e
+     * p_time_log, which must outlive the Application.
+     */
+    Application
+    (   Config const& p_config,
+        TimeLog& p_time_log,
+        std::ostream& p_ordinary_ostream,
+        std::ostream& p_error_ostream
+    );
+
     Application(Application const& rhs) = delete;
     Application(Application&& rhs) = delete;
     Application& operator=(Application const& rhs) = delete;
@@ -69,6 +106,7 @@ public:
 // ordinary and static member functions
 private:
     void populate_command_map();
+    void create_commands();
 
 public:
 
@@ -106,12 +144,23 @@ private:
     std::ostream& ordinary_ostream() const;
     std::ostream& error_ostream() const;
 
+    /**
+     * Register a command of type CommandT, to be constructed when first
+     * needed with \e p_command_word, \e p_aliases and \e p_args as
+     * arguments. \e p_args are held by reference, and must outlive the
+     * Application.
+     */
     template <typename CommandT, typename ... Args>
-    void create_command(CommandGroup& p_command_group, Args&& ... p_args);
+    void create_command
+    (   CommandGroup& p_command_group,
+        std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        Args& ... p_args
+    );
 
     void register_command_word
     (   std::string const& p_word,
-        std::shared_ptr<Command> const& p_cp
+        std::shared_ptr<CommandEntry> const& p_entry
     );
 
 // member variables
@@ -119,7 +168,8 @@ private:
     std::ostream& m_ordinary_ostream;
     std::ostream& m_error_ostream;
     Config m_config;
-    TimeLog m_time_log;
+    std::unique_ptr<TimeLog> m_owned_time_log;
+    TimeLog& m_time_log;
     CommandMap m_command_map;
     std::vector<CommandGroup> m_command_groups;
 
@@ -130,15 +180,25 @@ private:
 
 template <typename CommandT, typename ... Args>
 void
-Application::create_command(CommandGroup& p_command_group, Args&& ... p_args)
+Application::create_command
+(   CommandGroup& p_command_group,
+    std::string const& p_command_word,
+    std::vector<std::string> const& p_aliases,
+    Args& ... p_args
+)
 {
-    auto command = std::make_shared<CommandT>(std::forward<Args>(p_args) ...);
-    register_command_word(command->command_word(), command);
-    for (auto const& alias: command->aliases())
+    auto const entry = std::make_shared<CommandEntry>
+    (   [p_command_word, p_aliases, &p_args ...]()
+        {
+            return std::make_shared<CommandT>(p_command_word, p_aliases, p_args ...);
+        }
+    );
+    register_command_word(p_command_word, entry);
+    for (auto const& alias: p_aliases)
     {
-        register_command_word(alias, command);
+        register_command_word(alias, entry);
     }
-    p_command_group.commands.push_back(command);
+    p_command_group.commands.push_back(entry);
 }
 
 }  // namespace swx
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_at_command_hpp_0769365898924667
+#define GUARD_at_command_hpp_0769365898924667
+
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class AtCommand: public Command
+{
+// special member functions
+public:
+    AtCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    AtCommand(AtCommand const& rhs) = delete;
+    AtCommand(AtCommand&& rhs) = delete;
+    AtCommand& operator=(AtCommand const& rhs) = delete;
+    AtCommand& operator=(AtCommand&& rhs) = delete;
+    virtual ~AtCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+// ordinary member functions
+private:
+    ErrorMessages process_lines
+    (   Config const& p_config,
+        std::istream& p_is,
+        std::ostream& p_ordinary_ostream
+    );
+
+// member variables
+private:
+    bool m_csv = false;
+    TimeLog& m_time_log;
+
+};  // class AtCommand
+
+}  // namespace swx
+
+#endif  // GUARD_at_command_hpp_0769365898924667
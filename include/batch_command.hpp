@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_batch_command_hpp_3315846094026715
+#define GUARD_batch_command_hpp_3315846094026715
+
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Reads a sequence of commands, one per line, and executes each of them
+ * against a single, shared TimeLog, so that the log is loaded only once, and
+ * any changes to it are saved only once (or once per group of lines).
+ */
+class BatchCommand: public Command
+{
+// special member functions
+public:
+    BatchCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log,
+        std::ostream& p_error_ostream
+    );
+    BatchCommand(BatchCommand const& rhs) = delete;
+    BatchCommand(BatchCommand&& rhs) = delete;
+    BatchCommand& operator=(BatchCommand const& rhs) = delete;
+    BatchCommand& operator=(BatchCommand&& rhs) = delete;
+    virtual ~BatchCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+// ordinary member functions
+private:
+    ErrorMessages process_lines
+    (   Config const& p_config,
+        std::istream& p_is,
+        std::ostream& p_ordinary_ostream
+    );
+
+// member variables
+private:
+    bool m_stop_on_error = false;
+    std::string m_group_size_str = "0";
+    TimeLog& m_time_log;
+    std::ostream& m_error_ostream;
+
+};  // class BatchCommand
+
+}  // namespace swx
+
+#endif  // GUARD_batch_command_hpp_3315846094026715
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_bucket_report_writer_hpp_3306817295540716
+#define GUARD_bucket_report_writer_hpp_3306817295540716
+
+#include "report_writer.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Summarizes the time spent on each activity in each calendar day, week
+ * or month (according to whether Flags::by_day, Flags::by_week or
+ * Flags::by_month is set), in a single pass over the stints. Stints that
+ * cross from one period into another are split between them.
+ */
+class BucketReportWriter: public ReportWriter
+{
+// nested types
+protected:
+
+    /**
+     * Maps each activity to the seconds spent on it in each bucket. A
+     * row may be shorter than the number of buckets, in which case the
+     * missing trailing entries are zero.
+     */
+    using Rows = std::map<std::string, std::vector<unsigned long long>>;
+
+// special member functions
+public:
+    BucketReportWriter
+    (   std::vector<Stint> const& p_stints,
+        Options const& p_options,
+        Flags::Type p_flags
+    );
+    BucketReportWriter(BucketReportWriter const& rhs) = delete;
+    BucketReportWriter(BucketReportWriter&& rhs) = delete;
+    BucketReportWriter& operator=(BucketReportWriter const& rhs) = delete;
+    BucketReportWriter& operator=(BucketReportWriter&& rhs) = delete;
+    virtual ~BucketReportWriter();
+
+// inherited virtual member functions
+private:
+    virtual void do_preprocess_stints
+    (   std::ostream& p_os,
+        std::vector<Stint> const& p_stints
+    ) override;
+
+    virtual void do_process_stint
+    (   std::ostream& p_os,
+        Stint const& p_stint
+    ) override;
+
+    virtual void do_postprocess_stints
+    (   std::ostream& p_os,
+        std::vector<Stint> const& p_stints
+    ) override;
+
+// other virtual member functions
+private:
+
+    /**
+     * @param p_labels the label of each bucket, in order
+     */
+    virtual void do_write_matrix
+    (   std::ostream& p_os,
+        std::vector<std::string> const& p_labels,
+        Rows const& p_rows
+    ) = 0;
+
+// ordinary member functions
+protected:
+    bool has_flag(Flags::Type p_flag) const;
+
+private:
+    TimePoint bucket_begin(TimePoint const& p_time_point, int p_diff = 0) const;
+    std::size_t bucket_index(TimePoint const& p_time_point);
+
+// member variables
+private:
+    Flags::Type const m_flags;
+    std::size_t m_current_bucket = 0;
+
+    // The beginning of each bucket, followed by the end of the last
+    std::vector<TimePoint> m_boundaries;
+
+    Rows m_rows;
+
+};  // class BucketReportWriter
+
+}  // namespace swx
+
+#endif  // GUARD_bucket_report_writer_hpp_3306817295540716
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_columnar_writer_hpp_4418290157736620
+#define GUARD_columnar_writer_hpp_4418290157736620
+
+#include "stint.hpp"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Writes stints in a compact binary format, as a set of columns, for
+ * consumption by analytics tools. Stints of inactivity are omitted.
+ *
+ * All integers are little-endian, and every block begins at an offset that
+ * is a multiple of 8 bytes, so that a reader can memory-map the file and
+ * use the blocks in place. With N stints and K distinct activities, the
+ * layout is:
+ *
+ * <pre>
+ * Header (32 bytes):
+ *   0   char[4]     magic: "SWXC"
+ *   4   uint32      format version: 1
+ *   8   uint64      N
+ *   16  uint64      K
+ *   24  uint64      B, the total length in bytes of the activity names
+ * Blocks (each padded with zero bytes to a multiple of 8 bytes):
+ *   int64[N]        beginning of each stint, in seconds since the Unix epoch
+ *   uint32[N]       duration of each stint, in seconds
+ *   uint32[N]       activity id of each stint, indexing the dictionary
+ *   uint64[K + 1]   dictionary offsets: activity id i names the bytes
+ *                   [offsets[i], offsets[i + 1]) of the dictionary names
+ *   char[B]         dictionary names, UTF-8, not terminated
+ * </pre>
+ *
+ * Activity ids are assigned in order of each activity's first stint.
+ */
+class ColumnarWriter
+{
+// special member functions
+public:
+    explicit ColumnarWriter(std::vector<Stint> const& p_stints);
+    ColumnarWriter(ColumnarWriter const& rhs) = delete;
+    ColumnarWriter(ColumnarWriter&& rhs) = delete;
+    ColumnarWriter& operator=(ColumnarWriter const& rhs) = delete;
+    ColumnarWriter& operator=(ColumnarWriter&& rhs) = delete;
+    ~ColumnarWriter();
+
+// ordinary member functions
+public:
+
+    /**
+     * Write the stints to \e p_os, which should be opened in binary mode.
+     *
+     * @returns the number of bytes written.
+     */
+    std::size_t write(std::ostream& p_os) const;
+
+// member variables
+private:
+    std::vector<Stint> const& m_stints;
+
+};  // class ColumnarWriter
+
+}  // namespace swx
+
+#endif  // GUARD_columnar_writer_hpp_4418290157736620
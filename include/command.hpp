@@ -83,6 +83,17 @@ protected:
         std::string* p_arg_target = nullptr
     );
 
+    /**
+     * Like the other overload, but adds an option that requires an
+     * argument and may be passed more than once; each argument
+     * encountered during parsing is appended to <em>*p_arg_list_target</em>.
+     */
+    void add_option
+    (   std::vector<std::string> const& p_aliases,
+        HelpLine const& p_help_line,
+        std::vector<std::string>* p_arg_list_target
+    );
+
 public:
     ExitCode process
     (   Config const& p_config,
@@ -33,6 +33,26 @@ namespace swx
 class Config
 {
 // nested types
+public:
+
+    /**
+     * The value of every option, parsed once when the Config is loaded.
+     */
+    struct Settings
+    {
+        unsigned int output_rounding_numerator = 0;
+        unsigned int output_rounding_denominator = 0;
+        unsigned int output_precision = 0;
+        unsigned int output_width = 0;
+        std::string short_time_format;
+        std::string time_format;
+        unsigned int formatted_buf_len = 0;
+        std::string editor;
+        std::string path_to_log;
+        std::string path_to_goals;
+        std::string path_to_notes;
+    };
+
 private:
     struct OptionData
     {
@@ -47,6 +67,15 @@ private:
 
 // special member functions
 public:
+
+    /**
+     * Load the configuration from the file at \e p_filepath, creating the
+     * file, with every option commented out, if it does not exist.
+     *
+     * @exception std::runtime_error if the file cannot be parsed, or if it
+     * sets an option to a value of the wrong type or outside its valid
+     * range.
+     */
     explicit Config(std::string const& p_filepath);
     Config(Config const& rhs);
     Config(Config&& rhs);
@@ -57,15 +86,18 @@ public:
 // ordinary member functions
 public:
     std::string filepath() const;
+    Settings const& settings() const;
     unsigned int output_rounding_numerator() const;
     unsigned int output_rounding_denominator() const;
     unsigned int output_precision() const;
     unsigned int output_width() const;
-    std::string short_time_format() const;
-    std::string time_format() const;
+    std::string const& short_time_format() const;
+    std::string const& time_format() const;
     unsigned int formatted_buf_len() const;
-    std::string editor() const;
-    std::string path_to_log() const;
+    std::string const& editor() const;
+    std::string const& path_to_log() const;
+    std::string const& path_to_goals() const;
+    std::string const& path_to_notes() const;
 
     /**
      * @returns a printable summary of configuration settings.
@@ -86,11 +118,13 @@ private:
     std::string get_raw_option_value(std::string const& p_key) const;
     void set_defaults();
     void initialize_config_file();
+    void parse_settings();
 
 // member variables
 private:
     std::string m_filepath;
     std::map<std::string, OptionData> m_map;
+    Settings m_settings;
 
 };  // class Config
 
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_csv_bucket_report_writer_hpp_3084614747413856
+#define GUARD_csv_bucket_report_writer_hpp_3084614747413856
+
+#include "bucket_report_writer.hpp"
+#include "stint.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class CsvBucketReportWriter: public BucketReportWriter
+{
+// special member functions
+public:
+    CsvBucketReportWriter
+    (   std::vector<Stint> const& p_stints,
+        Options const& p_options,
+        Flags::Type p_flags
+    );
+    CsvBucketReportWriter(CsvBucketReportWriter const& rhs) = delete;
+    CsvBucketReportWriter(CsvBucketReportWriter&& rhs) = delete;
+    CsvBucketReportWriter& operator=(CsvBucketReportWriter const& rhs) = delete;
+    CsvBucketReportWriter& operator=(CsvBucketReportWriter&& rhs) = delete;
+    virtual ~CsvBucketReportWriter();
+
+// inherited virtual member functions
+private:
+    virtual void do_write_matrix
+    (   std::ostream& p_os,
+        std::vector<std::string> const& p_labels,
+        Rows const& p_rows
+    ) override;
+
+};  // class CsvBucketReportWriter
+
+}  // namespace swx
+
+#endif  // GUARD_csv_bucket_report_writer_hpp_3084614747413856
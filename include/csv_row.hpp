@@ -17,9 +17,11 @@
 #ifndef GUARD_csv_row_hpp_40090279206675605
 #define GUARD_csv_row_hpp_40090279206675605
 
+#include <istream>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <vector>
 #include "stream_utilities.hpp"
 
 namespace swx
@@ -56,6 +58,17 @@ private:
 
 std::ostream& operator<<(std::ostream& p_os, CsvRow const& p_csv_row);
 
+/**
+ * Reads a single row of CSV, in the format written by CsvRow, from \e p_is,
+ * placing its cells in \e p_cells. A quoted cell may span multiple lines.
+ *
+ * @returns \e false if there was no row to read (i.e. \e p_is was already
+ * exhausted), otherwise \e true.
+ *
+ * @exception std::runtime_error if the input ends within a quoted cell.
+ */
+bool read_csv_row(std::istream& p_is, std::vector<std::string>& p_cells);
+
 
 // FUNCTION TEMPLATE IMPLEMENTATIONS
 
@@ -50,6 +50,12 @@ private:
         std::map<std::string, ActivityStats> const& p_activity_stats_map
     ) override;
 
+    virtual void do_write_comparison
+    (   std::ostream& p_os,
+        std::vector<std::map<std::string, ActivityStats>> const&
+            p_activity_stats_maps
+    ) override;
+
 };  // class CsvSummaryReportWriter
 
 }  // namespace swx
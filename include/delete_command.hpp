@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_delete_command_hpp_00832559136204625
+#define GUARD_delete_command_hpp_00832559136204625
+
+#include "config_fwd.hpp"
+#include "recording_command.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Deletes the entry at a given time, anywhere in the time log, so that
+ * the stint before it runs on in its place.
+ */
+class DeleteCommand: public RecordingCommand
+{
+// special member functions
+public:
+    DeleteCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    DeleteCommand(DeleteCommand const& rhs) = delete;
+    DeleteCommand(DeleteCommand&& rhs) = delete;
+    DeleteCommand& operator=(DeleteCommand const& rhs) = delete;
+    DeleteCommand& operator=(DeleteCommand&& rhs) = delete;
+    virtual ~DeleteCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+// member variables
+private:
+    std::string m_time_stamp;
+
+};  // class DeleteCommand
+
+}  // namespace swx
+
+#endif  // GUARD_delete_command_hpp_00832559136204625
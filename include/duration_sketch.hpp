@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_duration_sketch_hpp_9677457707626820
+#define GUARD_duration_sketch_hpp_9677457707626820
+
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Summarizes the distribution of a collection of durations, in seconds,
+ * without storing them individually, so that quantiles such as the median
+ * can be estimated in a single pass. Durations are counted in buckets whose
+ * bounds grow geometrically, so that any quantile is estimated to within
+ * k_relative_accuracy of a duration in the collection, while the number of
+ * buckets grows only with the logarithm of the longest duration. Sketches
+ * can be merged by adding their buckets, so a sketch for a collection can
+ * be formed from sketches of its parts without revisiting the durations.
+ */
+class DurationSketch
+{
+// static data members
+public:
+    static double const k_relative_accuracy;
+
+// special member functions
+public:
+    DurationSketch() = default;
+    DurationSketch(DurationSketch const& rhs) = default;
+    DurationSketch(DurationSketch&& rhs) = default;
+    DurationSketch& operator=(DurationSketch const& rhs) = default;
+    DurationSketch& operator=(DurationSketch&& rhs) = default;
+    ~DurationSketch() = default;
+
+// ordinary member functions
+public:
+    void add(unsigned long long p_seconds);
+
+    /**
+     * @returns the number of durations added.
+     */
+    unsigned long long count() const;
+
+    /**
+     * @returns the total of the durations added.
+     */
+    unsigned long long total() const;
+
+    /**
+     * @returns the mean of the durations added, or zero if there are none.
+     */
+    double mean() const;
+
+    /**
+     * @returns the longest duration added, or zero if there are none.
+     */
+    unsigned long long max() const;
+
+    /**
+     * @returns an estimate of the \e p_quantile quantile of the durations
+     * added, where \e p_quantile is between 0 and 1; or zero if there are
+     * none. The estimate is within k_relative_accuracy of a duration at that
+     * rank, except that 0 and 1 give the shortest and longest durations
+     * exactly.
+     */
+    double quantile(double p_quantile) const;
+
+// member operators
+public:
+    DurationSketch& operator+=(DurationSketch const& rhs);
+
+// member variables
+private:
+    unsigned long long m_count = 0;
+    unsigned long long m_total = 0;
+    unsigned long long m_min = 0;
+    unsigned long long m_max = 0;
+    unsigned long long m_zero_count = 0;
+
+    // m_buckets[i] counts the positive durations in the bucket with index
+    // m_first_index + i.
+    int m_first_index = 0;
+    std::vector<unsigned long long> m_buckets;
+
+};  // class DurationSketch
+
+}  // namespace swx
+
+#endif  // GUARD_duration_sketch_hpp_9677457707626820
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_entry_sorter_hpp_5216934702881147
+#define GUARD_entry_sorter_hpp_5216934702881147
+
+#include "time_point.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Sorts entries, each consisting of an activity, a TimePoint and tags, into
+ * time order. Whenever the entries held in memory exceed a given size, they are
+ * sorted and spilled to a temporary file as a "run"; and the runs are merged
+ * as the entries are read back. This allows sets of entries too large to fit
+ * in memory to be sorted.
+ *
+ * Entries with the same TimePoint are read back in the order in which they
+ * were added, except that "provisional" entries come after all other entries
+ * with the same TimePoint, and are dropped altogether if any entry with the
+ * same TimePoint has already been read back.
+ *
+ * TimePoints are stored to a precision of one second.
+ */
+class EntrySorter
+{
+// nested types
+private:
+    struct Record
+    {
+        long long seconds;
+        unsigned long long sequence;
+        bool provisional;
+        std::string activity;
+        std::string tags;
+        bool operator<(Record const& rhs) const;
+    };
+    class Run;
+
+// special member functions
+public:
+    /**
+     * @param p_max_buffered_bytes the approximate number of bytes of entries
+     * to hold in memory before spilling them to a temporary file.
+     */
+    explicit EntrySorter(std::size_t p_max_buffered_bytes);
+    EntrySorter(EntrySorter const& rhs) = delete;
+    EntrySorter(EntrySorter&& rhs) = delete;
+    EntrySorter& operator=(EntrySorter const& rhs) = delete;
+    EntrySorter& operator=(EntrySorter&& rhs) = delete;
+    ~EntrySorter();
+
+// ordinary member functions
+public:
+
+    /**
+     * Add an entry. Must not be called once next() has been called.
+     *
+     * @param p_tags the tags of the entry, separated by spaces, or an empty
+     * string if it has none. They are stored as given.
+     */
+    void add
+    (   std::string const& p_activity,
+        TimePoint const& p_time_point,
+        std::string const& p_tags = std::string(),
+        bool p_provisional = false
+    );
+
+    /**
+     * Read back the next entry in sorted order, assigning its activity,
+     * TimePoint and tags to \e p_activity, \e p_time_point and \e p_tags,
+     * and to \e p_provisional whether it was added as provisional.
+     *
+     * @returns \e false if there are no more entries, otherwise \e true.
+     */
+    bool next
+    (   std::string& p_activity,
+        TimePoint& p_time_point,
+        std::string& p_tags,
+        bool& p_provisional
+    );
+
+    /**
+     * @returns the number of runs that have been spilled to temporary files.
+     */
+    std::size_t num_runs() const;
+
+private:
+    void spill();
+    void start_reading();
+    bool next_record(Record& p_record);
+
+// member variables
+private:
+    bool m_reading = false;
+    bool m_has_last_time = false;
+    long long m_last_time = 0;
+    unsigned long long m_next_sequence = 0;
+    std::size_t const m_max_buffered_bytes;
+    std::size_t m_buffered_bytes = 0;
+    std::size_t m_buffer_position = 0;
+    std::vector<Record> m_buffer;
+    std::vector<std::unique_ptr<Run>> m_runs;
+    std::vector<Run*> m_heap;
+
+};  // class EntrySorter
+
+}  // namespace swx
+
+#endif  // GUARD_entry_sorter_hpp_5216934702881147
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_export_command_hpp_6027719435880164
+#define GUARD_export_command_hpp_6027719435880164
+
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class ExportCommand: public Command
+{
+// special member functions
+public:
+    ExportCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    ExportCommand(ExportCommand const& rhs) = delete;
+    ExportCommand(ExportCommand&& rhs) = delete;
+    ExportCommand& operator=(ExportCommand const& rhs) = delete;
+    ExportCommand& operator=(ExportCommand&& rhs) = delete;
+    virtual ~ExportCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// member variables
+private:
+    std::string m_format_str = "columnar";
+    std::string m_output_filepath;
+    std::string m_since_str;
+    std::string m_until_str;
+    TimeLog& m_time_log;
+
+};  // class ExportCommand
+
+}  // namespace swx
+
+#endif  // GUARD_export_command_hpp_6027719435880164
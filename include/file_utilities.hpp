@@ -18,6 +18,7 @@
 #define GUARD_file_utilties_hpp_21582711730889376
 
 #include <string>
+#include <vector>
 
 namespace swx
 {
@@ -27,6 +28,45 @@ namespace swx
  */
 bool file_exists_at(std::string const& p_filepath);
 
+/**
+ * Identifies a version of the contents of a file, sufficiently for
+ * detecting whether the file has been changed or replaced.
+ */
+struct FileStatus
+{
+    unsigned long long inode = 0;
+    unsigned long long size = 0;
+    long long modification_nanoseconds = 0;
+};
+
+bool operator==(FileStatus const& lhs, FileStatus const& rhs);
+bool operator!=(FileStatus const& lhs, FileStatus const& rhs);
+
+/**
+ * Populates \e p_status with the status of the regular file at \e
+ * p_filepath, and returns true; or returns false (leaving \e p_status
+ * unchanged) if there is no regular file there.
+ */
+bool get_file_status(std::string const& p_filepath, FileStatus& p_status);
+
+/**
+ * Returns the names of the entries in the directory at \e p_dirpath,
+ * excluding "." and "..", in lexicographical order.
+ *
+ * @exception std::runtime_error if the directory cannot be read.
+ */
+std::vector<std::string> directory_entries(std::string const& p_dirpath);
+
+/**
+ * Appends \e p_contents to the existing file at \e p_filepath, and flushes
+ * the change to disk. Unlike AtomicWriter, this is not atomic: a crash part
+ * way through can leave only part of \e p_contents appended; but nothing
+ * already in the file can be lost.
+ *
+ * @exception std::runtime_error if the file cannot be opened or written.
+ */
+void append_to_file(std::string const& p_filepath, std::string const& p_contents);
+
 }  // namespace swx
 
 #endif  // GUARD_file_utilties_hpp_21582711730889376
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_goal_tracker_hpp_9115801162849669
+#define GUARD_goal_tracker_hpp_9115801162849669
+
+#include "activity_filter.hpp"
+#include "file_utilities.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Tracks progress towards the goals set in a goals file. Each goal sets a
+ * maximum (a budget) or a minimum for the time spent on an activity and its
+ * subactivities in each day, week or month, and is given on a line of the
+ * file in the form "ACTIVITY <= HOURSh/PERIOD" or "ACTIVITY >= HOURSh/PERIOD";
+ * for example, "meetings <= 8h/week". Blank lines, and lines beginning with
+ * '#', are ignored.
+ *
+ * The total for the current period of each goal is kept in a state file
+ * beside the goals file, together with the time up to which stints have
+ * been counted, so that after an entry is recorded only the stints since
+ * then need be counted: the cost of an update depends on the number of
+ * goals, not the length of the time log. If the time log or the goals file
+ * has been changed since the state was saved, other than by the caller
+ * between constructing a GoalTracker and calling update(), then the totals
+ * are counted afresh from the beginning of each period.
+ */
+class GoalTracker
+{
+// nested types
+public:
+    enum class Period
+    {
+        day,
+        week,
+        month
+    };
+
+    struct Goal
+    {
+        std::string activity;
+        bool is_maximum = true;
+        unsigned long long seconds = 0;
+        Period period = Period::week;
+        std::string description;
+    };
+
+    struct Status
+    {
+        Goal const* goal = nullptr;
+        TimePoint period_beginning;
+        unsigned long long seconds = 0;
+
+        /**
+         * @returns \e true if a maximum has been exceeded, or a minimum
+         * reached.
+         */
+        bool is_crossed() const;
+    };
+
+private:
+    struct Total
+    {
+        TimePoint period_beginning;
+        unsigned long long seconds = 0;
+    };
+
+// special member functions
+public:
+
+    /**
+     * Reads the goals in the file at \e p_goals_filepath (if there is one),
+     * and any state saved from a previous update. This must be called
+     * before any change is made to \e p_time_log that is to be counted
+     * incrementally by update().
+     *
+     * @exception std::runtime_error if the goals file cannot be parsed.
+     */
+    GoalTracker
+    (   std::string const& p_goals_filepath,
+        std::string const& p_log_filepath,
+        TimeLog& p_time_log
+    );
+    GoalTracker(GoalTracker const& rhs) = delete;
+    GoalTracker(GoalTracker&& rhs) = delete;
+    GoalTracker& operator=(GoalTracker const& rhs) = delete;
+    GoalTracker& operator=(GoalTracker&& rhs) = delete;
+    ~GoalTracker();
+
+// ordinary member functions
+public:
+    std::vector<Goal> const& goals() const;
+
+    /**
+     * Brings the totals up to date with the time log, as at \e p_now,
+     * and saves them. Since construction, the time log may have had at
+     * most one entry appended, or its last entry amended; anything else
+     * should be followed by a fresh GoalTracker. Does nothing if there
+     * are no goals.
+     */
+    void update(TimePoint const& p_now);
+
+    /**
+     * @returns the status of each goal as at \e p_now, counting the
+     * current stint up to \e p_now. Call update() first.
+     */
+    std::vector<Status> statuses(TimePoint const& p_now);
+
+private:
+    void parse_goals();
+    bool load_state();
+    void save_state();
+    void reset_totals(TimePoint const& p_now);
+
+    /**
+     * Adds \e p_sign times the part of the stint from \e p_beginning to
+     * \e p_ending spent on \e p_activity to the total of each goal for
+     * which it counts, within the current period of the goal as at
+     * \e p_now.
+     */
+    void count
+    (   std::string const& p_activity,
+        TimePoint const& p_beginning,
+        TimePoint const& p_ending,
+        TimePoint const& p_now,
+        int p_sign = 1
+    );
+
+    TimePoint period_beginning(std::size_t p_index, TimePoint const& p_now) const;
+
+// member variables
+private:
+    std::string const m_goals_filepath;
+    std::string const m_state_filepath;
+    std::string const m_log_filepath;
+    TimeLog& m_time_log;
+    std::vector<Goal> m_goals;
+    std::vector<std::unique_ptr<ActivityFilter>> m_filters;
+    FileStatus m_goals_status;
+    bool m_is_state_valid = false;
+    TimePoint m_checkpoint;
+    std::vector<Total> m_totals;
+
+};  // class GoalTracker
+
+}  // namespace swx
+
+#endif  // GUARD_goal_tracker_hpp_9115801162849669
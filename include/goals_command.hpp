@@ -0,0 +1,63 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_goals_command_hpp_5172799875040420
+#define GUARD_goals_command_hpp_5172799875040420
+
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class GoalsCommand: public Command
+{
+// special member functions
+public:
+    GoalsCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    GoalsCommand(GoalsCommand const& rhs) = delete;
+    GoalsCommand(GoalsCommand&& rhs) = delete;
+    GoalsCommand& operator=(GoalsCommand const& rhs) = delete;
+    GoalsCommand& operator=(GoalsCommand&& rhs) = delete;
+    virtual ~GoalsCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+// member variables
+private:
+    bool m_csv = false;
+    TimeLog& m_time_log;
+
+};  // class GoalsCommand
+
+}  // namespace swx
+
+#endif  // GUARD_goals_command_hpp_5172799875040420
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_heatmap_hpp_7719204365581382
+#define GUARD_heatmap_hpp_7719204365581382
+
+#include "time_point.hpp"
+#include <array>
+#include <cstddef>
+#include <ctime>
+
+namespace swx
+{
+
+/**
+ * Accumulates time into the 168 hours of the week (in local time),
+ * Monday 00:00-01:00 being the first.
+ */
+class Heatmap
+{
+// nested types
+public:
+    static std::size_t constexpr k_days_per_week = 7;
+    static std::size_t constexpr k_hours_per_day = 24;
+    static std::size_t constexpr k_num_bins = k_days_per_week * k_hours_per_day;
+
+// special member functions
+public:
+    Heatmap();
+    Heatmap(Heatmap const& rhs) = default;
+    Heatmap(Heatmap&& rhs) = default;
+    Heatmap& operator=(Heatmap const& rhs) = default;
+    Heatmap& operator=(Heatmap&& rhs) = default;
+    ~Heatmap();
+
+// ordinary member functions
+public:
+
+    /**
+     * Add the time from \e p_beginning to \e p_ending to the bins it
+     * falls in. A period spanning a change to or from daylight saving
+     * time is counted according to the local time at each moment.
+     */
+    void add(TimePoint const& p_beginning, TimePoint const& p_ending);
+
+    /**
+     * @returns the seconds accumulated in hour \e p_hour (0 to 23) of day
+     * \e p_day of the week (0 for Monday to 6 for Sunday).
+     */
+    unsigned long long seconds(std::size_t p_day, std::size_t p_hour) const;
+
+private:
+    long utc_offset(std::time_t p_time);
+    void add_local(long long p_local_beginning, long long p_duration);
+
+// member variables
+private:
+    std::array<unsigned long long, k_num_bins> m_bins;
+
+    // The UTC offset last looked up, which is usually that wanted next,
+    // since each stint begins when the previous one ends.
+    std::time_t m_offset_time = 0;
+    long m_offset = 0;
+    bool m_has_offset = false;
+
+};  // class Heatmap
+
+}  // namespace swx
+
+#endif  // GUARD_heatmap_hpp_7719204365581382
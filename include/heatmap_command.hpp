@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_heatmap_command_hpp_5230847719063628
+#define GUARD_heatmap_command_hpp_5230847719063628
+
+#include "activity_filter.hpp"
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "heatmap.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class HeatmapCommand: public Command
+{
+// special member functions
+public:
+    HeatmapCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    HeatmapCommand(HeatmapCommand const& rhs) = delete;
+    HeatmapCommand(HeatmapCommand&& rhs) = delete;
+    HeatmapCommand& operator=(HeatmapCommand const& rhs) = delete;
+    HeatmapCommand& operator=(HeatmapCommand&& rhs) = delete;
+    virtual ~HeatmapCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// ordinary member functions
+private:
+    void write_grid
+    (   std::ostream& p_os,
+        Config const& p_config,
+        Heatmap const& p_heatmap
+    ) const;
+
+    void write_csv
+    (   std::ostream& p_os,
+        Config const& p_config,
+        Heatmap const& p_heatmap
+    ) const;
+
+// member variables
+private:
+    bool m_csv = false;
+    ActivityFilter::Type m_activity_filter_type = ActivityFilter::Type::ordinary;
+    std::string m_since_str;
+    std::string m_until_str;
+    TimeLog& m_time_log;
+
+};  // class HeatmapCommand
+
+}  // namespace swx
+
+#endif  // GUARD_heatmap_command_hpp_5230847719063628
@@ -19,6 +19,7 @@
 
 #include "summary_report_writer.hpp"
 #include "activity_stats.hpp"
+#include "duration_sketch.hpp"
 #include "stint_fwd.hpp"
 #include "time_point.hpp"
 #include <map>
@@ -51,6 +52,12 @@ private:
         std::map<std::string, ActivityStats> const& p_activity_stats_map
     ) override;
 
+    virtual void do_write_comparison
+    (   std::ostream& p_os,
+        std::vector<std::map<std::string, ActivityStats>> const&
+            p_activity_stats_maps
+    ) override;
+
 // ordinary member functions
 private:
     void print_label_and_rounded_hours
@@ -59,7 +66,19 @@ private:
         unsigned long long p_seconds,
         TimePoint const* p_beginning,
         TimePoint const* p_ending,
-        unsigned int p_left_col_width = 0
+        DurationSketch const* p_durations,
+        unsigned int p_left_col_width = 0,
+        std::string::size_type p_count_width = 0
+    ) const;
+
+    /**
+     * Writes the number of stints in \e p_durations, and statistics of their
+     * lengths, right-aligning the number in a field of \e p_count_width.
+     */
+    void write_durations
+    (   std::ostream& p_os,
+        DurationSketch const& p_durations,
+        std::string::size_type p_count_width
     ) const;
 
     void write_succinct_summary
@@ -77,6 +96,38 @@ private:
         std::map<std::string, ActivityStats> const& p_activity_stats_map
     );
 
+    /**
+     * Writes the headings "[1]", and "[N]" and "[1]-[N]" for each other of
+     * \e p_num_periods, aligned with the columns written by
+     * write_comparison_values, after \e p_indent spaces.
+     */
+    void write_comparison_header
+    (   std::ostream& p_os,
+        std::string::size_type p_indent,
+        std::size_t p_num_periods
+    ) const;
+
+    /**
+     * Writes the hours in the first of \e p_seconds, followed by the hours
+     * in each of the others and the change from each of those to the first.
+     */
+    void write_comparison_values
+    (   std::ostream& p_os,
+        std::vector<unsigned long long> const& p_seconds
+    ) const;
+
+    void write_flat_comparison
+    (   std::ostream& p_os,
+        std::vector<std::map<std::string, ActivityStats>> const&
+            p_activity_stats_maps
+    );
+
+    void write_tree_comparison
+    (   std::ostream& p_os,
+        std::vector<std::map<std::string, ActivityStats>> const&
+            p_activity_stats_maps
+    );
+
 };  // class HumanSummaryReportWriter
 
 }  // namespace swx
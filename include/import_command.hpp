@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_import_command_hpp_8841302715590263
+#define GUARD_import_command_hpp_8841302715590263
+
+#include "config_fwd.hpp"
+#include "entry_sorter.hpp"
+#include "recording_command.hpp"
+#include "time_log.hpp"
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class ImportCommand: public RecordingCommand
+{
+// special member functions
+public:
+    ImportCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    ImportCommand(ImportCommand const& rhs) = delete;
+    ImportCommand(ImportCommand&& rhs) = delete;
+    ImportCommand& operator=(ImportCommand const& rhs) = delete;
+    ImportCommand& operator=(ImportCommand&& rhs) = delete;
+    virtual ~ImportCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+// ordinary member functions
+private:
+
+    // Read entries from \e p_is into \e p_sorter, returning the number of
+    // entries read, and appending to \e p_errors a message for each line
+    // that cannot be parsed.
+    std::size_t read_log_lines
+    (   std::istream& p_is,
+        std::string const& p_source_name,
+        EntrySorter& p_sorter,
+        ErrorMessages& p_errors
+    );
+    std::size_t read_csv_rows
+    (   std::istream& p_is,
+        std::string const& p_source_name,
+        std::string const& p_time_format,
+        EntrySorter& p_sorter,
+        ErrorMessages& p_errors
+    );
+
+// member variables
+private:
+    bool m_csv = false;
+    std::string m_buffer_size_str = "64";
+
+};  // class ImportCommand
+
+}  // namespace swx
+
+#endif  // GUARD_import_command_hpp_8841302715590263
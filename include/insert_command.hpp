@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_insert_command_hpp_73096605192690824
+#define GUARD_insert_command_hpp_73096605192690824
+
+#include "config_fwd.hpp"
+#include "recording_command.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Inserts a switch to an activity at an earlier time, anywhere in the
+ * time log, such as to record a switch that was forgotten at the time.
+ */
+class InsertCommand: public RecordingCommand
+{
+// special member functions
+public:
+    InsertCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    InsertCommand(InsertCommand const& rhs) = delete;
+    InsertCommand(InsertCommand&& rhs) = delete;
+    InsertCommand& operator=(InsertCommand const& rhs) = delete;
+    InsertCommand& operator=(InsertCommand&& rhs) = delete;
+    virtual ~InsertCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// member variables
+private:
+    std::string m_time_stamp;
+    std::vector<std::string> m_tags;
+
+};  // class InsertCommand
+
+}  // namespace swx
+
+#endif  // GUARD_insert_command_hpp_73096605192690824
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_merged_time_logs_hpp_1593620487365127
+#define GUARD_merged_time_logs_hpp_1593620487365127
+
+#include "activity_filter_fwd.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Presents several time log files as a single sequence of stints, for
+ * reporting on them together.
+ */
+class MergedTimeLogs
+{
+// nested types
+public:
+    struct Source
+    {
+        /**
+         * If not empty, prefixed (followed by a space) to the name of each
+         * activity from this source, so that the activities of each
+         * source are grouped under their label in reports.
+         */
+        std::string label;
+
+        std::string filepath;
+    };
+
+// static member functions
+public:
+
+    /**
+     * Parse \e p_spec, of the form "FILE" or "LABEL=FILE", into a Source.
+     * LABEL may not contain '/'; so any '=' after a '/' is considered part
+     * of FILE.
+     */
+    static Source parse_source(std::string const& p_spec);
+
+// special member functions
+public:
+    MergedTimeLogs
+    (   std::vector<Source> const& p_sources,
+        std::string const& p_time_format,
+        unsigned int p_formatted_buf_len
+    );
+    MergedTimeLogs(MergedTimeLogs const& rhs) = delete;
+    MergedTimeLogs(MergedTimeLogs&& rhs) = delete;
+    MergedTimeLogs& operator=(MergedTimeLogs const& rhs) = delete;
+    MergedTimeLogs& operator=(MergedTimeLogs&& rhs) = delete;
+    ~MergedTimeLogs();
+
+// ordinary member functions
+public:
+
+    /**
+     * Load the logs, each on its own thread, and pass the stints of all
+     * of them to \e p_sink in order of their beginning (ties being broken
+     * by the order of the sources), filtered as for TimeLog::get_stints
+     * (including by \e p_tags). The filter is applied to activity names
+     * after any label has been prefixed to them.
+     *
+     * Each log is loaded on its own thread. The stints are then merged
+     * through a cursor over each log (see TimeLog::StintCursor), so that
+     * only the next stint of each log is held at any time, and labelled as
+     * they are passed on; so beyond the logs themselves, memory use does
+     * not grow with the number of stints. The stints passed to \e p_sink
+     * are only valid for the duration of the call to this function.
+     *
+     * @exception std::runtime_error if any of the logs does not exist or
+     * cannot be loaded; the message names the file.
+     */
+    void for_each_stint
+    (   ActivityFilter const& p_activity_filter,
+        TimePoint const* p_begin,
+        TimePoint const* p_end,
+        std::vector<std::string> const& p_tags,
+        std::function<void(Stint const&)> const& p_sink
+    ) const;
+
+// member variables
+private:
+    std::vector<Source> const m_sources;
+    std::string const m_time_format;
+    unsigned int const m_formatted_buf_len;
+
+};  // class MergedTimeLogs
+
+}  // namespace swx
+
+#endif  // GUARD_merged_time_logs_hpp_1593620487365127
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_note_store_hpp_7825096965799016
+#define GUARD_note_store_hpp_7825096965799016
+
+#include "file_utilities.hpp"
+#include "time_point.hpp"
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Holds free-text notes on stints, out of line from the time log, in a
+ * notes file of its own. Each note is keyed by the time of the log entry
+ * that began its stint, and is recorded on a line of the notes file in the
+ * form "TIMESTAMP TEXT". A stint may have several notes.
+ *
+ * Beside the notes file is an index file, which lists the key of each note
+ * in key order, together with the offset in the notes file at which its
+ * text begins, so that the notes on a few stints can be read without
+ * reading the whole notes file. Nothing is read until notes are first
+ * asked for or added; and if the notes file has been changed since the
+ * index was saved, other than by a NoteStore, then the index is rebuilt
+ * from it.
+ */
+class NoteStore
+{
+// nested types
+private:
+    struct IndexEntry
+    {
+        long long key_seconds;
+        unsigned long long offset;
+    };
+
+// special member functions
+public:
+    NoteStore
+    (   std::string const& p_filepath,
+        std::string const& p_time_format,
+        unsigned int p_formatted_buf_len
+    );
+    NoteStore(NoteStore const& rhs) = delete;
+    NoteStore(NoteStore&& rhs) = delete;
+    NoteStore& operator=(NoteStore const& rhs) = delete;
+    NoteStore& operator=(NoteStore&& rhs) = delete;
+    ~NoteStore();
+
+// ordinary member functions
+public:
+
+    /**
+     * Records \e p_text as a note on the stint that began at \e p_key,
+     * appending it to the notes file, and updates the index. If the notes
+     * file does not end with a newline, one is written before the note.
+     *
+     * @exception std::runtime_error if \e p_text is empty or spans more
+     * than one line, or if the notes file cannot be written.
+     */
+    void add(TimePoint const& p_key, std::string const& p_text);
+
+    /**
+     * @returns the notes with keys no earlier than \e p_beginning and
+     * earlier than \e p_ending, in order of key, and then of addition.
+     *
+     * @exception std::runtime_error if the notes file cannot be read or
+     * parsed.
+     */
+    std::vector<std::string> notes_within
+    (   TimePoint const& p_beginning,
+        TimePoint const& p_ending
+    );
+
+private:
+    void load_index();
+    bool read_index();
+    void rebuild_index();
+    void save_index();
+
+// member variables
+private:
+    bool m_index_loaded = false;
+    std::string const m_filepath;
+    std::string const m_index_filepath;
+    std::string const m_time_format;
+    unsigned int const m_formatted_buf_len;
+    std::string::size_type const m_stamp_length;
+    FileStatus m_status;
+    std::vector<IndexEntry> m_index;
+
+};  // class NoteStore
+
+}  // namespace swx
+
+#endif  // GUARD_note_store_hpp_7825096965799016
@@ -25,6 +25,12 @@
 namespace swx
 {
 
+/**
+ * @returns \e true if \e p_str is a placeholder, which
+ * expand_placeholders would expand in the context of a time log.
+ */
+bool is_placeholder(std::string const& p_str);
+
 /**
  * Takes \e p_components, expands any that are placeholders, in the
  * context of \e p_time_log, and returns the resulting activity name,
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_profiler_hpp_5038362718144096
+#define GUARD_profiler_hpp_5038362718144096
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace swx
+{
+
+/**
+ * Records the time spent in named phases of the program, together with
+ * various counters, for diagnosing slow commands. Profiling is disabled
+ * unless enable() is called, in which case each of the recording functions
+ * does nothing beyond testing a single flag.
+ */
+class Profiler
+{
+// nested types
+public:
+    enum class Counter
+    {
+        bytes_read,
+        lines_parsed,
+        strptime_calls,
+        distinct_activities,
+        stints_produced,
+        bytes_written,
+        allocations,  // only counted when built with SWX_ALLOC_STATS
+        bytes_allocated,  // only counted when built with SWX_ALLOC_STATS
+        num_counters  // not a counter; must be last
+    };
+
+    /**
+     * Records the time between its construction and destruction as a
+     * phase named \e p_name, if profiling is enabled. \e p_name should
+     * be a string literal. Phases may be nested. When built with
+     * SWX_ALLOC_STATS, the heap allocations made by the thread during the
+     * phase are also attributed to it.
+     */
+    class Phase
+    {
+    public:
+        explicit Phase(char const* p_name)
+        {
+            if (is_enabled()) begin(p_name);
+        }
+        Phase(Phase const& rhs) = delete;
+        Phase(Phase&& rhs) = delete;
+        Phase& operator=(Phase const& rhs) = delete;
+        Phase& operator=(Phase&& rhs) = delete;
+        ~Phase()
+        {
+            if (m_index != k_none) end();
+        }
+
+    private:
+        friend class Profiler;
+        static std::size_t constexpr k_none = static_cast<std::size_t>(-1);
+        void begin(char const* p_name);
+        void end();
+        std::size_t m_index = k_none;
+        Phase* m_parent = nullptr;
+        unsigned long long m_allocations = 0;
+        unsigned long long m_bytes_allocated = 0;
+    };
+
+// special member functions
+public:
+    Profiler() = delete;
+
+// static member functions
+public:
+    static bool is_enabled()
+    {
+        return s_enabled;
+    }
+
+    /**
+     * Enable profiling for the remainder of the process.
+     */
+    static void enable();
+
+    /**
+     * Add \e p_amount to \e p_counter.
+     */
+    static void count(Counter p_counter, unsigned long long p_amount = 1)
+    {
+        if (is_enabled()) do_count(p_counter, p_amount);
+    }
+
+    /**
+     * Raise \e p_counter to \e p_value, if it is currently lower; for
+     * counters that record a level reached rather than a total.
+     */
+    static void count_peak(Counter p_counter, unsigned long long p_value)
+    {
+        if (is_enabled()) do_count_peak(p_counter, p_value);
+    }
+
+    /**
+     * Record a heap allocation of \e p_size bytes, against the counters
+     * and the innermost Phase of the calling thread. Called by the
+     * replacement operator new installed when built with SWX_ALLOC_STATS;
+     * must not itself allocate.
+     */
+    static void count_allocation(std::size_t p_size) noexcept
+    {
+        if (is_enabled()) do_count_allocation(p_size);
+    }
+
+    /**
+     * Print the total time spent in each phase, and the counters, as a
+     * table.
+     */
+    static void write_summary(std::ostream& p_os);
+
+    /**
+     * Write the phases and counters to \e p_filepath as JSON in the Chrome
+     * trace-event format, for viewing in chrome://tracing or similar.
+     *
+     * @exception std::runtime_error if the file cannot be written.
+     */
+    static void write_trace(std::string const& p_filepath);
+
+    /**
+     * @returns the current value of \e p_counter.
+     */
+    static unsigned long long counter_value(Counter p_counter);
+
+private:
+    static void do_count(Counter p_counter, unsigned long long p_amount);
+    static void do_count_peak(Counter p_counter, unsigned long long p_value);
+    static void do_count_allocation(std::size_t p_size) noexcept;
+
+// static member variables
+private:
+    static bool s_enabled;
+
+};  // class Profiler
+
+}  // namespace swx
+
+#endif  // GUARD_profiler_hpp_5038362718144096
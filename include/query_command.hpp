@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_query_command_hpp_2742120968294395
+#define GUARD_query_command_hpp_2742120968294395
+
+#include "config_fwd.hpp"
+#include "reporting_command.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class QueryCommand: public ReportingCommand
+{
+// special member functions
+public:
+    QueryCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    QueryCommand(QueryCommand const& rhs) = delete;
+    QueryCommand(QueryCommand&& rhs) = delete;
+    QueryCommand& operator=(QueryCommand const& rhs) = delete;
+    QueryCommand& operator=(QueryCommand&& rhs) = delete;
+    virtual ~QueryCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// member variables
+private:
+    std::string m_since_str;
+    std::string m_until_str;
+
+};  // class QueryCommand
+
+}  // namespace swx
+
+#endif  // GUARD_query_command_hpp_2742120968294395
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_rank_command_hpp_2950716648328104
+#define GUARD_rank_command_hpp_2950716648328104
+
+#include "activity_filter.hpp"
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class RankCommand: public Command
+{
+// special member functions
+public:
+    RankCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    RankCommand(RankCommand const& rhs) = delete;
+    RankCommand(RankCommand&& rhs) = delete;
+    RankCommand& operator=(RankCommand const& rhs) = delete;
+    RankCommand& operator=(RankCommand&& rhs) = delete;
+    virtual ~RankCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// member variables
+private:
+    bool m_csv = false;
+    ActivityFilter::Type m_activity_filter_type = ActivityFilter::Type::ordinary;
+    std::string m_top_str = "10";
+    std::string m_window_str = "30";
+    std::string m_step_str;
+    std::string m_since_str;
+    std::string m_until_str;
+    TimeLog& m_time_log;
+
+};  // class RankCommand
+
+}  // namespace swx
+
+#endif  // GUARD_rank_command_hpp_2950716648328104
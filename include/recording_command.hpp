@@ -18,10 +18,14 @@
 #define GUARD_recording_command_hpp_9906369540796788
 
 #include "command.hpp"
+#include "config_fwd.hpp"
+#include "goal_tracker.hpp"
 #include "help_line.hpp"
 #include "result_fwd.hpp"
 #include "time_log.hpp"
 #include "time_point.hpp"
+#include <memory>
+#include <ostream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -57,6 +61,29 @@ protected:
     TimeLog& time_log();
     std::string time_stamp(TimePoint const& p_time_point) const;
 
+    /**
+     * Reads the goals in the goals file, if any, so that they may be
+     * brought up to date by report_goals() once the time log has been
+     * changed. Call this before changing the time log. If the goals
+     * file cannot be parsed, a warning is written to \e p_ostream, and
+     * null is returned.
+     */
+    std::unique_ptr<GoalTracker> track_goals
+    (   Config const& p_config,
+        std::ostream& p_ostream
+    );
+
+    /**
+     * Updates the totals of \e p_goal_tracker (if it is not null) with the
+     * change just made to the time log, and writes a warning to \e p_ostream
+     * for each maximum that has now been exceeded.
+     */
+    void report_goals
+    (   Config const& p_config,
+        std::unique_ptr<GoalTracker> const& p_goal_tracker,
+        std::ostream& p_ostream
+    );
+
 // member variables
 private:
     TimeLog& m_time_log;    
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_recurring_window_hpp_3962113829262851
+#define GUARD_recurring_window_hpp_3962113829262851
+
+#include "time_point.hpp"
+#include <string>
+
+namespace swx
+{
+
+/**
+ * A window of time that recurs on certain days of the week, such as
+ * "Mon-Fri 09:00-17:30" (working hours) or "12:30-13:30" (lunch, every day).
+ * A specification consists of the days, the times, or both, separated by
+ * whitespace. The days are given as a comma-separated list of days of the
+ * week ("Mon", "Tue" and so on, in any case) or ranges of them such as
+ * "Mon-Fri" or "Fri-Mon"; if omitted, the window recurs every day. The
+ * times are given as "HH:MM-HH:MM"; if omitted, the window spans the whole
+ * day. A window whose ending is not later than its beginning, such as
+ * "22:00-06:00", runs on past midnight into the next day.
+ */
+class RecurringWindow
+{
+// special member functions
+public:
+
+    /**
+     * @exception std::runtime_error if \e p_spec cannot be parsed.
+     */
+    explicit RecurringWindow(std::string const& p_spec);
+
+    RecurringWindow(RecurringWindow const& rhs) = default;
+    RecurringWindow(RecurringWindow&& rhs) = default;
+    RecurringWindow& operator=(RecurringWindow const& rhs) = default;
+    RecurringWindow& operator=(RecurringWindow&& rhs) = default;
+    ~RecurringWindow() = default;
+
+// ordinary member functions
+public:
+
+    /**
+     * If the window begins on the day beginning at \e p_day_beginning,
+     * assigns the beginning and ending of that occurrence to
+     * \e p_beginning and \e p_ending, and returns \e true; otherwise
+     * returns \e false.
+     */
+    bool occurs_on
+    (   TimePoint const& p_day_beginning,
+        TimePoint& p_beginning,
+        TimePoint& p_ending
+    ) const;
+
+// member variables
+private:
+    unsigned int m_days = 0;  // bit n set for day n, counting from Sunday
+    int m_beginning_minutes = 0;
+    int m_ending_minutes = 24 * 60;
+
+};  // class RecurringWindow
+
+}  // namespace swx
+
+#endif  // GUARD_recurring_window_hpp_3962113829262851
@@ -19,8 +19,11 @@
 
 #include "interval_fwd.hpp"
 #include "stint.hpp"
+#include "time_point.hpp"
+#include <functional>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace swx
@@ -30,6 +33,26 @@ class ReportWriter
 {
 // nested types
 public:
+
+    /**
+     * A callable that passes each of a sequence of stints, in time order,
+     * to the callable it is given.
+     */
+    using StintStream =
+        std::function<void(std::function<void(Stint const&)> const&)>;
+
+    /**
+     * The beginning and end of a period of time. TimePoint::min() and
+     * TimePoint::max() stand for the period being unbounded at that end.
+     */
+    using Period = std::pair<TimePoint, TimePoint>;
+
+    /**
+     * A callable that returns the notes on the stint with the given
+     * interval, or an empty vector if it has none.
+     */
+    using NoteLookup = std::function<std::vector<std::string>(Interval const&)>;
+
     struct Options
     {
         /* Holds various options for use by ReportWriter.
@@ -42,6 +65,13 @@ public:
          *
          * @todo MEDIUM PRIORITY Do we really need this when we already have
          * Config?
+         *
+         * If p_comparison_periods is non-empty, a summary report compares
+         * the time spent on each activity within each of these periods,
+         * rather than summarizing all the stints.
+         *
+         * If p_note_lookup is non-empty, a list report shows the notes on
+         * each stint, as returned by it.
          */
         Options
         (   unsigned int p_output_rounding_numerator,
@@ -50,7 +80,10 @@ public:
             unsigned int p_output_width,
             unsigned int p_formatted_buf_len,
             std::string const& p_time_format,
-            unsigned int p_depth
+            unsigned int p_depth,
+            std::vector<Period> const& p_comparison_periods =
+                std::vector<Period>(),
+            NoteLookup const& p_note_lookup = NoteLookup()
         );
         unsigned int const output_rounding_numerator;
         unsigned int const output_rounding_denominator;
@@ -59,6 +92,8 @@ public:
         unsigned int const formatted_buf_len;
         std::string const time_format;
         unsigned int const depth;
+        std::vector<Period> const comparison_periods;
+        NoteLookup const note_lookup;
     };
 
     /**
@@ -74,6 +109,15 @@ public:
         static Type constexpr succinct          = (1 << 3);
         static Type constexpr csv               = (1 << 4);
         static Type constexpr show_stints       = (1 << 5);
+
+        // Summarize by calendar period, in a matrix of activities against
+        // periods. At most one of these should be set.
+        static Type constexpr by_day            = (1 << 6);
+        static Type constexpr by_week           = (1 << 7);
+        static Type constexpr by_month          = (1 << 8);
+        static Type constexpr by_period         = (by_day | by_week | by_month);
+
+        static Type constexpr durations         = (1 << 9);
     };
 
 // static factory function
@@ -103,6 +147,13 @@ public:
 public:
     void write(std::ostream& p_os);
 
+    /**
+     * Write a report on the stints produced by \e p_stints, rather than
+     * on the stints passed to the constructor, without requiring them to
+     * be held in memory together.
+     */
+    void write(std::ostream& p_os, StintStream const& p_stints);
+
 protected:
 
     unsigned int output_precision() const;
@@ -112,6 +163,18 @@ protected:
     std::string const& time_format() const;
     unsigned int formatted_buf_len() const;
     unsigned int depth() const;
+    std::vector<Period> const& comparison_periods() const;
+
+    /**
+     * @returns \e true if the notes on stints are to be shown.
+     */
+    bool shows_notes() const;
+
+    /**
+     * @returns the notes on the stint with interval \e p_interval, if
+     * shows_notes(); otherwise an empty vector.
+     */
+    std::vector<std::string> notes(Interval const& p_interval) const;
 
     /**
      * Converts a number of seconds to a double representing a number
@@ -21,6 +21,7 @@
 #include "command.hpp"
 #include "config_fwd.hpp"
 #include "help_line.hpp"
+#include "stint_query.hpp"
 #include "summary_report_writer.hpp"
 #include "time_log.hpp"
 #include "time_point.hpp"
@@ -60,6 +61,11 @@ protected:
      * activity. This parameter will have any placeholders expanded before
      * further processing.
      *
+     * Pass a non-null \e p_query to include only the stints that it
+     * matches, instead of filtering by activity (in which case
+     * \e p_activity_args is ignored). Periods of inactivity are then
+     * excluded.
+     *
      * Returns non-empty ErrorMessages if anything goes wrong (but does
      * not rule out throwing an exception).
      */
@@ -69,11 +75,26 @@ protected:
         std::vector<std::string> const& p_activity_args =
             std::vector<std::string>(),
         TimePoint const* p_begin = nullptr,
-        TimePoint const* p_end = nullptr
+        TimePoint const* p_end = nullptr,
+        StintQuery* p_query = nullptr
     );
 
     std::string const& time_format() const;
 
+private:
+
+    /**
+     * Parses \e p_spec, of the form FROM..TO, into \e p_period.
+     *
+     * @returns \e false if \e p_spec could not be parsed, or if the period
+     * is empty.
+     */
+    bool parse_period
+    (   std::string const& p_spec,
+        Config const& p_config,
+        ReportWriter::Period& p_period
+    ) const;
+
 // inherited virtual functions
 private:
     virtual bool does_support_placeholders() const override;
@@ -83,6 +104,13 @@ private:
     ReportWriter::Flags::Type m_report_flags = ReportWriter::Flags::none;
     ActivityFilter::Type m_activity_filter_type = ActivityFilter::Type::ordinary;
     std::string m_depth_str = "0";
+    std::string m_bucket_str;
+    std::vector<std::string> m_log_specs;
+    std::vector<std::string> m_compare_specs;
+    std::vector<std::string> m_within_specs;
+    std::vector<std::string> m_except_specs;
+    std::vector<std::string> m_tags;
+    bool m_show_notes = false;
     TimeLog& m_time_log;
 
 };  // class ReportingCommand
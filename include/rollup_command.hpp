@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_rollup_command_hpp_8820173469251043
+#define GUARD_rollup_command_hpp_8820173469251043
+
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "report_writer.hpp"
+#include "team_rollup.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class RollupCommand: public Command
+{
+// special member functions
+public:
+    RollupCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases
+    );
+    RollupCommand(RollupCommand const& rhs) = delete;
+    RollupCommand(RollupCommand&& rhs) = delete;
+    RollupCommand& operator=(RollupCommand const& rhs) = delete;
+    RollupCommand& operator=(RollupCommand&& rhs) = delete;
+    virtual ~RollupCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+// ordinary member functions
+private:
+    void write_rollups
+    (   std::ostream& p_os,
+        TeamRollup::Rollups const& p_rollups,
+        ReportWriter::Options const& p_options
+    ) const;
+
+// member variables
+private:
+    bool m_label_by_user = false;
+    ReportWriter::Flags::Type m_report_flags = ReportWriter::Flags::none;
+    std::string m_depth_str = "0";
+    std::string m_watch_str;
+    std::string m_output_filepath;
+
+};  // class RollupCommand
+
+}  // namespace swx
+
+#endif  // GUARD_rollup_command_hpp_8820173469251043
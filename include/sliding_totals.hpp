@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_sliding_totals_hpp_6018374420985571
+#define GUARD_sliding_totals_hpp_6018374420985571
+
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Maintains the time spent on each activity within a window of time that
+ * slides forward over a sequence of stints. Each move of the window adds
+ * the time entering it and subtracts the time leaving it, rather than
+ * totalling the whole window again.
+ */
+class SlidingTotals
+{
+// nested types
+public:
+    using Entry = std::pair<std::string const*, unsigned long long>;
+
+// special member functions
+public:
+
+    /**
+     * @param p_stints stints in order of beginning, not overlapping one
+     * another, as returned by TimeLog::get_stints. The stints must outlive
+     * the SlidingTotals.
+     */
+    explicit SlidingTotals(std::vector<Stint> const& p_stints);
+
+    SlidingTotals(SlidingTotals const& rhs) = delete;
+    SlidingTotals(SlidingTotals&& rhs) = delete;
+    SlidingTotals& operator=(SlidingTotals const& rhs) = delete;
+    SlidingTotals& operator=(SlidingTotals&& rhs) = delete;
+    ~SlidingTotals();
+
+// ordinary member functions
+public:
+
+    /**
+     * Move the window to run from \e p_beginning up to \e p_ending. Neither
+     * may be earlier than on the previous call.
+     */
+    void move_to(TimePoint const& p_beginning, TimePoint const& p_ending);
+
+    /**
+     * @returns the (at most) \e p_k activities on which most time was
+     * spent within the window, with the seconds spent on each, from most
+     * to least (ties being in order of activity name).
+     */
+    std::vector<Entry> top(std::size_t p_k) const;
+
+private:
+    void accumulate
+    (   TimePoint const& p_beginning,
+        TimePoint const& p_ending,
+        std::size_t& p_cursor,
+        bool p_subtract
+    );
+
+// member variables
+private:
+    bool m_is_positioned = false;
+    std::size_t m_entering_cursor = 0;
+    std::size_t m_leaving_cursor = 0;
+    TimePoint m_beginning;
+    TimePoint m_ending;
+    std::vector<Stint> const& m_stints;
+    std::unordered_map<std::string const*, unsigned long long> m_totals;
+
+};  // class SlidingTotals
+
+}  // namespace swx
+
+#endif  // GUARD_sliding_totals_hpp_6018374420985571
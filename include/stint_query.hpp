@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_stint_query_hpp_8211418606477255
+#define GUARD_stint_query_hpp_8211418606477255
+
+#include "activity_filter.hpp"
+#include "interval_fwd.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * A test of stints, written in a small expression language, such as
+ *
+ *   (under "client a" or under "client b") and not under meetings and duration > 15m
+ *
+ * The tests that can be combined are:
+ *
+ *   activity = NAME       the activity is NAME
+ *   activity ~ REGEX      the activity matches the regular expression REGEX
+ *   under NAME            the activity is NAME or one of its subactivities
+ *   tag TAG               the stint is tagged TAG
+ *   duration OP DURATION  the length of the stint compares with DURATION,
+ *                         given in hours, minutes and/or seconds, such as
+ *                         "1h30m" or "90s"
+ *   start OP TIMESTAMP    the beginning of the stint compares with TIMESTAMP
+ *
+ * where OP is one of <, <=, > and >=. Tests are combined with "and", "or"
+ * and "not", in increasing order of precedence, and parentheses. NAME, REGEX
+ * and TAG are quoted if they contain whitespace or any of "()=~<>".
+ *
+ * The expression is compiled once into a flat program in postfix form,
+ * which is run for each stint against a small stack. The results of the
+ * tests of the activity are cached for each distinct activity, and of the
+ * tags for each distinct set of tags, keyed by the address of the string
+ * passed for them, as TimeLog::get_stints allows.
+ */
+class StintQuery
+{
+// nested types
+private:
+    enum class Opcode
+    {
+        test_activity,
+        test_tag,
+        compare_duration,
+        compare_start,
+        conjunction,
+        disjunction,
+        negation
+    };
+
+    enum class Comparison
+    {
+        less,
+        less_or_equal,
+        greater,
+        greater_or_equal
+    };
+
+    struct Instruction
+    {
+        Opcode opcode;
+        Comparison comparison;
+        std::size_t operand;  // index of the test of the activity or the tag
+        long long value;  // seconds
+    };
+
+    class Parser;
+    friend class Parser;
+
+// special member functions
+public:
+
+    /**
+     * Timestamps in \e p_expression are parsed as for time_stamp_to_point,
+     * with \e p_time_format and \e p_short_time_format.
+     *
+     * @exception std::runtime_error if \e p_expression cannot be parsed.
+     */
+    StintQuery
+    (   std::string const& p_expression,
+        std::string const& p_time_format,
+        std::string const& p_short_time_format
+    );
+    StintQuery(StintQuery const& rhs) = delete;
+    StintQuery(StintQuery&& rhs) = delete;
+    StintQuery& operator=(StintQuery const& rhs) = delete;
+    StintQuery& operator=(StintQuery&& rhs) = delete;
+    ~StintQuery();
+
+// ordinary member functions
+public:
+
+    /**
+     * @returns \e true if the stint with activity \e p_activity, interval
+     * \e p_interval and tags \e p_tags (as passed to a
+     * TimeLog::StintPredicate) passes the test.
+     *
+     * A StintQuery should be used for the stints of only a single call to
+     * TimeLog::get_stints, as its caches are keyed by address.
+     */
+    bool matches
+    (   std::string const& p_activity,
+        Interval const& p_interval,
+        std::string const* p_tags
+    );
+
+private:
+    std::vector<char> const& activity_results(std::string const& p_activity);
+    std::vector<char> const& tag_results(std::string const* p_tags);
+
+// member variables
+private:
+    std::vector<Instruction> m_program;
+    std::vector<std::unique_ptr<ActivityFilter>> m_activity_tests;
+    std::vector<std::string> m_tag_tests;
+    std::unordered_map<std::string const*, std::vector<char>> m_activity_results;
+    std::unordered_map<std::string const*, std::vector<char>> m_tag_results;
+    std::vector<char> m_stack;
+
+};  // class StintQuery
+
+}  // namespace swx
+
+#endif  // GUARD_stint_query_hpp_8211418606477255
@@ -62,6 +62,17 @@ std::string squash(std::string const& p_string);
  */
 std::vector<std::string> split(std::string const& p_str, char p_delimiter = ' ');
 
+/**
+ * Splits \e p_line into arguments in the manner of a (very) simple shell:
+ * arguments are separated by whitespace, except where the whitespace is
+ * enclosed in single or double quotes, or escaped with a backslash. The
+ * quotes and escaping backslashes are not included in the returned
+ * arguments.
+ *
+ * @exception std::runtime_error if \e p_line contains an unterminated quote.
+ */
+std::vector<std::string> split_command_line(std::string const& p_line);
+
 /**
  * @returns a string derived from \e p_string by inserting newline characters
  * at positions between words such that each resulting line does not exceed \e p_width
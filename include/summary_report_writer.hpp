@@ -21,8 +21,10 @@
 #include "report_writer.hpp"
 #include "stint.hpp"
 #include "time_point.hpp"
+#include <cstddef>
 #include <map>
 #include <ostream>
+#include <string>
 #include <vector>
 
 namespace swx
@@ -67,14 +69,32 @@ private:
         std::map<std::string, ActivityStats> const& p_activity_stats_map
     ) = 0;
 
+    /**
+     * Called instead of do_write_summary when comparison periods were
+     * passed in the Options. \e p_activity_stats_maps holds the stats for
+     * each period, in the same order as the periods.
+     */
+    virtual void do_write_comparison
+    (   std::ostream& p_os,
+        std::vector<std::map<std::string, ActivityStats>> const&
+            p_activity_stats_maps
+    ) = 0;
+
 // ordinary member functions
 protected:
     bool has_flag(Flags::Type p_flag) const;
 
+    /**
+     * @returns a description of the \e p_index-th comparison period, in the
+     * form "FROM to TO".
+     */
+    std::string describe_period(std::size_t p_index) const;
+
 // member variables
 private:
     Flags::Type const m_flags;
     std::map<std::string, ActivityStats> m_activity_stats_map;
+    std::vector<std::map<std::string, ActivityStats>> m_period_stats_maps;
 
 };  // class SummaryReportWriter
 
@@ -59,6 +59,7 @@ private:
     bool m_use_regex = false;
     bool m_time_stamp_provided = false;
     std::string m_time_stamp;
+    std::vector<std::string> m_tags;
 
 };  // class SwitchCommand
 
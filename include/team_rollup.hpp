@@ -0,0 +1,151 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_team_rollup_hpp_4482937150638221
+#define GUARD_team_rollup_hpp_4482937150638221
+
+#include "file_utilities.hpp"
+#include "seconds.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Maintains the total time spent on each activity on each day, summed
+ * over all the time logs in a directory (being the files in it named
+ * "*.swx").
+ *
+ * The logs are parsed incrementally: on each refresh, a log whose
+ * inode, size and modification time are unchanged is not read at all,
+ * and a log that has grown is read only from where its previous parse
+ * ended, provided the last line parsed is still in place (swx replaces
+ * rather than appends to a log when saving, so the inode alone cannot be
+ * relied on). Any other change causes the log to be parsed afresh.
+ */
+class TeamRollup
+{
+// nested types
+public:
+
+    /**
+     * Maps the beginning of each day to the seconds spent on each
+     * activity during it.
+     */
+    using Rollups = std::map<TimePoint, std::map<std::string, Seconds>>;
+
+private:
+
+    // How far a log has been parsed, and what is needed to resume.
+    struct Position
+    {
+        unsigned long long parsed_size = 0;
+        std::size_t line_count = 0;
+        std::string last_line;
+        bool has_entry = false;
+        std::string last_activity;
+        TimePoint last_time_point;
+    };
+
+    struct FileState
+    {
+        FileStatus status;
+        Position position;
+        Rollups rollups;
+    };
+
+// special member functions
+public:
+
+    /**
+     * If \e p_label_by_user is true, the activities from each log are
+     * reported as subactivities of the name of the log, less its ".swx"
+     * extension.
+     */
+    TeamRollup
+    (   std::string const& p_dirpath,
+        std::string const& p_time_format,
+        unsigned int p_formatted_buf_len,
+        bool p_label_by_user = false
+    );
+    TeamRollup(TeamRollup const& rhs) = delete;
+    TeamRollup(TeamRollup&& rhs) = delete;
+    TeamRollup& operator=(TeamRollup const& rhs) = delete;
+    TeamRollup& operator=(TeamRollup&& rhs) = delete;
+    ~TeamRollup();
+
+// ordinary member functions
+public:
+
+    /**
+     * Bring the rollups up to date with the logs currently in the
+     * directory.
+     *
+     * @returns a message for each log that could not be parsed; such logs
+     * are left out of the rollups until they can be.
+     *
+     * @exception std::runtime_error if the directory cannot be read.
+     */
+    std::vector<std::string> refresh();
+
+    /**
+     * @returns the rollups as at the last refresh, plus the time spent
+     * up to \e p_now on the activities that were then current.
+     */
+    Rollups rollups(TimePoint const& p_now) const;
+
+    /**
+     * @returns the number of bytes of log read by the last refresh.
+     */
+    unsigned long long bytes_read_by_last_refresh() const;
+
+private:
+    void parse
+    (   std::string const& p_filename,
+        std::string const& p_buffer,
+        unsigned long long p_buffer_position,
+        std::string::size_type p_offset,
+        Position& p_position,
+        Rollups& p_delta
+    ) const;
+
+    void add_stint
+    (   Rollups& p_rollups,
+        std::string const& p_filename,
+        std::string const& p_activity,
+        TimePoint const& p_beginning,
+        TimePoint const& p_ending
+    ) const;
+
+// member variables
+private:
+    bool const m_label_by_user;
+    unsigned int const m_formatted_buf_len;
+    unsigned long long m_bytes_read_by_last_refresh = 0;
+    std::string const m_dirpath;
+    std::string const m_time_format;
+    std::map<std::string, FileState> m_files;
+    Rollups m_combined;
+
+};  // class TeamRollup
+
+}  // namespace swx
+
+#endif  // GUARD_team_rollup_hpp_4482937150638221
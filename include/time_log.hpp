@@ -18,10 +18,14 @@
 #define GUARD_time_log_hpp_6591341885082117
 
 #include "activity_filter_fwd.hpp"
+#include "interval_fwd.hpp"
 #include "stint_fwd.hpp"
 #include "time_point.hpp"
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace swx
@@ -30,12 +34,81 @@ namespace swx
 /**
  * Represents a record of time spent on various activities, persisted to a
  * plain text file.
+ *
+ * The log never holds consecutive entries with the same activity. Where a
+ * change would leave two such entries, the later of them is removed, and
+ * any tags it bore are added to those of the earlier; so that the stint
+ * they make up together bears the tags of both.
  */
 class TimeLog
 {
 // nested types
 private:
     class Impl;
+    class StintScan;
+public:
+    /**
+     * A callable that on each call either assigns the next of a sequence of
+     * entries to its arguments and returns \e true, or returns \e false
+     * to indicate that there are no more entries. The entry is given by its
+     * activity, its TimePoint, its tags (separated by spaces, as in the log
+     * file, or an empty string if it has none), and whether it is
+     * "provisional": that is, to be dropped if there is already an entry at
+     * its TimePoint.
+     */
+    using EntrySource = std::function
+    <   bool(std::string&, TimePoint&, std::string&, bool&)
+    >;
+
+    /**
+     * A callable that is passed the activity, the interval and the tags of
+     * a stint, and returns \e true if the stint is to be included. The
+     * tags are passed sorted and separated by spaces, or as a null pointer
+     * if the stint has none. Throughout a single call to get_stints, the
+     * strings passed for the same activity, or the same set of tags, are
+     * the same string (at the same address), so that results can be
+     * cached by address.
+     */
+    using StintPredicate = std::function
+    <   bool(std::string const&, Interval const&, std::string const*)
+    >;
+
+    /**
+     * Yields, one at a time, the stints that get_stints would return for
+     * the same arguments, each being found only when the cursor reaches
+     * it; so that the stints of a log can be consumed without first being
+     * gathered. A StintCursor is valid only for as long as the TimeLog
+     * from which it was obtained is not changed.
+     */
+    class StintCursor
+    {
+    public:
+        explicit StintCursor(std::unique_ptr<StintScan> p_scan);
+        StintCursor(StintCursor const& rhs) = delete;
+        StintCursor(StintCursor&& rhs);
+        StintCursor& operator=(StintCursor const& rhs) = delete;
+        StintCursor& operator=(StintCursor&& rhs);
+        ~StintCursor();
+
+        /**
+         * @returns \e true if the cursor is past the last stint.
+         */
+        bool done() const;
+
+        /**
+         * @returns the stint at the cursor, which must not be done(). Its
+         * activity persists for as long as the TimeLog is not changed.
+         */
+        Stint current() const;
+
+        /**
+         * Move the cursor to the next stint. It must not be done().
+         */
+        void advance();
+
+    private:
+        std::unique_ptr<StintScan> m_scan;
+    };
 
 // special member functions
 public:
@@ -54,34 +127,109 @@ public:
 // ordinary member functions
 public:
 
+    /**
+     * Cause changes subsequently made to the log to be held in memory,
+     * rather than being persisted to file immediately, until
+     * save_deferred() is called. If a change fails while saving is
+     * deferred, only that change is discarded: the changes that may fail
+     * part way through (renaming and merging) first persist any changes
+     * already held in memory, and the others are validated before
+     * anything is changed.
+     */
+    void defer_saving();
+
+    /**
+     * Persist to file any changes held in memory since defer_saving() was
+     * called (or since the last call to this function), in a single
+     * write. Subsequent changes will be persisted immediately again,
+     * unless defer_saving() is called again.
+     */
+    void save_deferred();
+
     /**
      * Push a new record onto the log. The new record will be immediately
-     * persisted to file.
+     * persisted to file: by appending it to the file, if that still ends
+     * with the previous record as it would be written; and otherwise by
+     * rewriting the whole file. An append cut short leaves an unreadable
+     * final line without a newline, which is ignored when the log is loaded.
      *
      * It is the caller's reponsibility that this will not leave the log with 
      * entries that are out of time order.
      *
-     * @exception std::runtime_error if p_time_point is future dated.
+     * @param p_tags tags to attach to the new record, such as "billable" or
+     *   "client:acme". If the activity of the new record is the same as that
+     *   of the last record, no record is added and \e p_tags are discarded.
+     *
+     * @exception std::runtime_error if p_time_point is future dated, or if
+     * any of \e p_tags is empty or contains whitespace.
      */
-    void append_entry(std::string const& p_activity, TimePoint const& p_time_point);
+    void append_entry
+    (   std::string const& p_activity,
+        TimePoint const& p_time_point,
+        std::vector<std::string> const& p_tags = std::vector<std::string>()
+    );
 
     /**
      * Amend the activity of the last entry in the log to \e p_activity, with
-     * TimePoint \e p_time_point. If there are no entries in the log, this does
-     * nothing. The change will be immediately persisted to file.
+     * TimePoint \e p_time_point and tags \e p_tags. If there are no entries in
+     * the log, this does nothing. The change will be immediately persisted to
+     * file.
      *
      * It is the caller's reponsibility that this will not leave the log with 
      * entries that are out of time order.
      *
      * @return the previous activity, or an empty string if inactive (including if
      *   there are no entries in the log).
-     * @exception std::runtime_error if p_time_point is future dated.
+     * @exception std::runtime_error if p_time_point is future dated, or if
+     * any of \e p_tags is empty or contains whitespace.
      */
-    std::string amend_last(std::string const& p_activity, TimePoint const& p_time_point);
+    std::string amend_last
+    (   std::string const& p_activity,
+        TimePoint const& p_time_point,
+        std::vector<std::string> const& p_tags = std::vector<std::string>()
+    );
+
+    /**
+     * Insert an entry recording a switch to \e p_activity at \e
+     * p_time_point, which may be anywhere in the log, with tags \e p_tags.
+     * If \e p_activity is already the activity at \e p_time_point, nothing
+     * is changed and \e p_tags are discarded. If the entry following the
+     * new one has the same activity as it, the following entry is removed,
+     * so that the log never has consecutive entries with the same activity.
+     * The change will be immediately persisted to file, by rewriting the
+     * whole file; unless the new entry is the last in the log, in which
+     * case it is appended as by append_entry().
+     *
+     * @return the activity that was current at \e p_time_point before
+     *   the insertion, or an empty string if inactive then.
+     * @exception std::runtime_error if \e p_time_point is future dated, if
+     *   there is already an entry at \e p_time_point, or if any of \e p_tags
+     *   is empty or contains whitespace.
+     */
+    std::string insert_entry
+    (   std::string const& p_activity,
+        TimePoint const& p_time_point,
+        std::vector<std::string> const& p_tags = std::vector<std::string>()
+    );
+
+    /**
+     * Delete the entry at exactly \e p_time_point, so that the stint
+     * preceding it is extended to cover the deleted one. If the entries
+     * either side of the deleted one then have the same activity, the later
+     * of them is removed too. The change will be immediately persisted to
+     * file, by rewriting the whole file.
+     *
+     * @return the activity of the deleted entry.
+     * @exception std::runtime_error if there is no entry at \e
+     *   p_time_point.
+     */
+    std::string delete_entry(TimePoint const& p_time_point);
 
     /**
      * Apply <em>p_activity_filter.replace(activity, p_new)</em> to every
-     * activity matched by \e p_activity_filter. The changes will be immediately
+     * activity matched by \e p_activity_filter. Where this leaves an entry
+     * with the same activity as the entry before it, the two are collapsed
+     * into one, which bears the tags of both. The changes will be immediately
      * persisted to file.
      *
      * @return the number of stints for which a change was made.
@@ -91,17 +239,82 @@ public:
         std::string const& p_new
     );
 
+    /**
+     * Merge the entries yielded by \e p_source into the log, preserving
+     * time order. Where an existing entry and a merged entry have the same
+     * TimePoint, the existing entry is placed first; unless the merged entry
+     * is provisional, in which case it is dropped. Consecutive entries
+     * with the same activity are collapsed into one, which bears the tags
+     * of both. The changes will be
+     * persisted to file in a single write once all the entries have been
+     * merged.
+     *
+     * \e p_source must yield entries in non-descending time order.
+     *
+     * @return the number of entries by which the log has grown.
+     *
+     * @exception std::runtime_error if \e p_source yields an entry that is
+     * future-dated or out of order, in which case the log is left unchanged.
+     */
+    std::size_t merge_entries(EntrySource const& p_source);
+
+    /**
+     * Parse \e p_line as a line of the log file, returning a pair of the
+     * activity and TimePoint it records. If \e p_tags is non-null, any tags
+     * on the line are assigned to it, without their markers and separated
+     * by single spaces.
+     *
+     * @exception std::runtime_error if \e p_line cannot be parsed, or if
+     * its tags are not well formed; in which case \e p_line_number is
+     * included in the error message.
+     */
+    std::pair<std::string, TimePoint> parse_entry
+    (   std::string const& p_line,
+        std::size_t p_line_number,
+        std::string* p_tags = nullptr
+    ) const;
+
     /**
      * Provide \e p_activity_filter to filter by activity name.
      * Provide non-null pointers to TimePoints to filter by date range,
      * or null pointers to ignore one or both ends of the range.
+     * Provide \e p_tags to include only stints whose entries bear all of
+     * those tags; only the entries bearing the rarest of them are then
+     * visited, by way of an index from each tag to the entries bearing it.
      * 
      * The stints are ordered in ascending date order.
      */
     std::vector<Stint> get_stints
     (   ActivityFilter const& p_activity_filter,
         TimePoint const* p_begin,
-        TimePoint const* p_end
+        TimePoint const* p_end,
+        std::vector<std::string> const& p_tags = std::vector<std::string>()
+    );
+
+    /**
+     * As for the other overload of get_stints, but with stints included
+     * only if \e p_predicate returns \e true for them, as they are
+     * encountered in the scan. The interval passed to \e p_predicate is
+     * that of the stint as returned, so limited to the date range.
+     */
+    std::vector<Stint> get_stints
+    (   StintPredicate const& p_predicate,
+        TimePoint const* p_begin,
+        TimePoint const* p_end,
+        std::vector<std::string> const& p_tags = std::vector<std::string>()
+    );
+
+    /**
+     * As for the overload of get_stints taking \e p_predicate, but
+     * returning a cursor at the first of the stints, rather than the
+     * stints themselves. \e p_predicate is called as the cursor advances,
+     * so must persist for as long as the cursor is used.
+     */
+    StintCursor stint_cursor
+    (   StintPredicate const& p_predicate,
+        TimePoint const* p_begin,
+        TimePoint const* p_end,
+        std::vector<std::string> const& p_tags = std::vector<std::string>()
     );
 
     /**
@@ -136,6 +349,15 @@ public:
      */
     TimePoint last_entry_time(std::size_t p_ago = 0);
 
+    /**
+     * @returns the activity ongoing at each of \e p_time_points, in the same
+     * order, being the activity of the latest entry no later than it; or the
+     * empty string where there is no such entry, or the log was inactive.
+     * A small number of time points are each found by binary search; a large
+     * number are sorted and found in a single pass over the log.
+     */
+    std::vector<std::string> activities_at(std::vector<TimePoint> const& p_time_points);
+
     /**
      * @returns \e true if and only if there is an activity recorded in the log
      * that is ongoing as at \e p_time_point.
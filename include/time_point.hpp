@@ -47,6 +47,20 @@ TimePoint day_begin(TimePoint const& p_time_point, int p_days_diff = 0);
  */
 TimePoint day_end(TimePoint const& p_time_point, int p_days_diff = 0);
 
+/**
+ * The first TimePoint of the week (beginning on Monday) in which \e
+ * p_time_point falls; or of the week \e p_weeks_diff weeks after (or, if
+ * negative, before) that week.
+ */
+TimePoint week_begin(TimePoint const& p_time_point, int p_weeks_diff = 0);
+
+/**
+ * The first TimePoint of the calendar month in which \e p_time_point falls;
+ * or of the month \e p_months_diff months after (or, if negative, before)
+ * that month.
+ */
+TimePoint month_begin(TimePoint const& p_time_point, int p_months_diff = 0);
+
 std::tm time_point_to_tm(TimePoint const& p_time_point);
 
 TimePoint tm_to_time_point(std::tm const& p_tm);
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_time_windows_hpp_3981694544579541
+#define GUARD_time_windows_hpp_3981694544579541
+
+#include "recurring_window.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Restricts stints to the times within any of a set of recurring windows
+ * (or to all times, if there are none), and not within any of another set.
+ *
+ * The windows are not expanded in advance: their occurrences are generated
+ * a day at a time, only as far as the stints passed so far reach, and
+ * discarded once the stints have passed them. The allowed intervals and the
+ * stints are then swept together, so the cost is linear in the number of
+ * stints plus the number of occurrences of the windows over the time they
+ * span.
+ */
+class TimeWindows
+{
+// special member functions
+public:
+    TimeWindows
+    (   std::vector<RecurringWindow> const& p_within,
+        std::vector<RecurringWindow> const& p_except
+    );
+    TimeWindows(TimeWindows const& rhs) = delete;
+    TimeWindows(TimeWindows&& rhs) = delete;
+    TimeWindows& operator=(TimeWindows const& rhs) = delete;
+    TimeWindows& operator=(TimeWindows&& rhs) = delete;
+    ~TimeWindows();
+
+// ordinary member functions
+public:
+
+    /**
+     * @returns \e true if there are no windows, so that stints are passed
+     * through unchanged.
+     */
+    bool is_unrestricted() const;
+
+    /**
+     * Pass to \e p_sink, in order, a stint for each part of \e p_stint
+     * that falls within the allowed times. The stints passed on successive
+     * calls must be in order of beginning, though they may overlap, as are
+     * those passed by TimeLog::get_stints and MergedTimeLogs::for_each_stint.
+     * A part of a live stint is live only if it runs to the end of it.
+     */
+    void restrict
+    (   Stint const& p_stint,
+        std::function<void(Stint const&)> const& p_sink
+    );
+
+private:
+
+    /**
+     * Appends to m_allowed the allowed intervals beginning on the day
+     * beginning at m_next_day, and moves m_next_day on to the next day.
+     */
+    void generate_day();
+
+    /**
+     * Appends the interval from \e p_beginning to \e p_ending to
+     * m_allowed, merging it with the last interval there if they overlap
+     * or touch. \e p_beginning may be earlier than the beginning of the
+     * last interval only if the time between them is already allowed.
+     */
+    void append(TimePoint const& p_beginning, TimePoint const& p_ending);
+
+// member variables
+private:
+    std::vector<RecurringWindow> const m_within;
+    std::vector<RecurringWindow> const m_except;
+    bool m_is_started = false;
+    TimePoint m_next_day;
+    std::deque<std::pair<TimePoint, TimePoint>> m_allowed;
+
+};  // class TimeWindows
+
+}  // namespace swx
+
+#endif  // GUARD_time_windows_hpp_3981694544579541
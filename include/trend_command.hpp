@@ -0,0 +1,72 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_trend_command_hpp_0369012218652288
+#define GUARD_trend_command_hpp_0369012218652288
+
+#include "activity_filter.hpp"
+#include "command.hpp"
+#include "config_fwd.hpp"
+#include "time_log.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace swx
+{
+
+class TrendCommand: public Command
+{
+// special member functions
+public:
+    TrendCommand
+    (   std::string const& p_command_word,
+        std::vector<std::string> const& p_aliases,
+        TimeLog& p_time_log
+    );
+    TrendCommand(TrendCommand const& rhs) = delete;
+    TrendCommand(TrendCommand&& rhs) = delete;
+    TrendCommand& operator=(TrendCommand const& rhs) = delete;
+    TrendCommand& operator=(TrendCommand&& rhs) = delete;
+    virtual ~TrendCommand();
+
+// inherited virtual functions
+private:
+    virtual ErrorMessages do_process
+    (   Config const& p_config,
+        std::vector<std::string> const& p_ordinary_args,
+        std::ostream& p_ordinary_ostream
+    ) override;
+
+    virtual bool does_support_placeholders() const override;
+
+// member variables
+private:
+    bool m_csv = false;
+    bool m_combine = false;
+    ActivityFilter::Type m_activity_filter_type = ActivityFilter::Type::ordinary;
+    std::vector<std::string> m_period_strs;
+    std::string m_span_str = "7";
+    std::string m_since_str;
+    std::string m_until_str;
+    TimeLog& m_time_log;
+
+};  // class TrendCommand
+
+}  // namespace swx
+
+#endif  // GUARD_trend_command_hpp_0369012218652288
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_trend_series_hpp_7981286938379136
+#define GUARD_trend_series_hpp_7981286938379136
+
+#include <cstddef>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Tracks a series of daily totals, pushed one day at a time, together with
+ * moving averages over one or more periods and an exponentially smoothed
+ * average. Each moving average is kept as a running sum, updated from a
+ * ring buffer holding the days of the longest period, so that pushing a day
+ * costs the same however long the periods are.
+ */
+class TrendSeries
+{
+// special member functions
+public:
+
+    /**
+     * @param p_periods the number of days over which each moving average is
+     * taken. Each must be positive.
+     *
+     * @param p_smoothing_span the span, in days, of the exponentially smoothed
+     * average, which gives each day a weight of 2 / (span + 1) relative to
+     * the smoothed average of the days before. Must be positive.
+     *
+     * @param p_leading_days the number of days, on each of which the total
+     * was zero, that are to be treated as already pushed.
+     *
+     * @exception std::invalid_argument if any period, or the span, is zero.
+     */
+    TrendSeries
+    (   std::vector<std::size_t> const& p_periods,
+        std::size_t p_smoothing_span,
+        std::size_t p_leading_days = 0
+    );
+
+    TrendSeries(TrendSeries const& rhs) = default;
+    TrendSeries(TrendSeries&& rhs) = default;
+    TrendSeries& operator=(TrendSeries const& rhs) = default;
+    TrendSeries& operator=(TrendSeries&& rhs) = default;
+    ~TrendSeries() = default;
+
+// ordinary member functions
+public:
+
+    /**
+     * Add the total, \e p_seconds, for the day after the last one pushed.
+     */
+    void push(unsigned long long p_seconds);
+
+    /**
+     * @returns the number of days pushed so far, including any leading days.
+     */
+    std::size_t days() const;
+
+    /**
+     * @returns the total for the last day pushed, or zero if none has been.
+     */
+    unsigned long long latest() const;
+
+    /**
+     * @returns the sum of the daily totals over the \e p_index-th period (in
+     * the order the periods were passed to the constructor), ending with the
+     * last day pushed.
+     */
+    unsigned long long sum(std::size_t p_index) const;
+
+    /**
+     * @returns the mean daily total over the \e p_index-th period, ending
+     * with the last day pushed; or, if fewer days than that have been pushed,
+     * over the days pushed so far.
+     */
+    double moving_average(std::size_t p_index) const;
+
+    /**
+     * @returns the exponentially smoothed average of the daily totals. This
+     * starts at the first day pushed (so is zero if that day was a leading
+     * day).
+     */
+    double smoothed_average() const;
+
+// member variables
+private:
+    std::size_t m_days = 0;
+    double m_smoothing_factor;
+    double m_smoothed_average = 0.0;
+    std::vector<std::size_t> m_periods;
+    std::vector<unsigned long long> m_sums;
+    std::vector<unsigned long long> m_ring;
+
+};  // class TrendSeries
+
+}  // namespace swx
+
+#endif  // GUARD_trend_series_hpp_7981286938379136
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef GUARD_work_pattern_hpp_0757059223229028
+#define GUARD_work_pattern_hpp_0757059223229028
+
+#include "duration_sketch.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace swx
+{
+
+/**
+ * Measures how fragmented time has been, from a sequence of stints passed
+ * to it one at a time: the number of switches between activities on each
+ * day, the lengths of the uninterrupted stints on an activity ("focus
+ * blocks"), the lengths of the inactive stints between active ones ("idle
+ * gaps"), and the pairs of activities switched between most often.
+ *
+ * A switch is counted where a stint on one activity is followed directly
+ * by a stint on another, and is attributed to the day on which the second
+ * stint begins.
+ */
+class WorkPattern
+{
+// nested types
+public:
+    struct SwitchCount
+    {
+        std::string const* first;   // the lesser of the two, by name
+        std::string const* second;
+        unsigned long long count;
+    };
+
+private:
+    using ActivityPair = std::pair<std::string const*, std::string const*>;
+
+    struct ActivityPairHash
+    {
+        std::size_t operator()(ActivityPair const& p_pair) const;
+    };
+
+// special member functions
+public:
+    WorkPattern() = default;
+    WorkPattern(WorkPattern const& rhs) = delete;
+    WorkPattern(WorkPattern&& rhs) = delete;
+    WorkPattern& operator=(WorkPattern const& rhs) = delete;
+    WorkPattern& operator=(WorkPattern&& rhs) = delete;
+    ~WorkPattern() = default;
+
+// ordinary member functions
+public:
+
+    /**
+     * Count \e p_stint, which must follow directly on from the stint
+     * passed on the previous call (if any), as do those returned by
+     * TimeLog::get_stints for an ActivityFilter that is always true.
+     * Activities are identified by address, so the activity of
+     * \e p_stint must outlive the WorkPattern, and must be the same
+     * string wherever the same activity recurs.
+     *
+     * @param p_is_included whether \e p_stint is on one of the activities
+     * of interest; only these are counted as focus blocks, and only
+     * switches to or from these are counted. Ignored for inactive stints.
+     */
+    void add(Stint const& p_stint, bool p_is_included = true);
+
+    /**
+     * @returns the number of days on which a stint on an activity of
+     * interest, or a switch, began.
+     */
+    std::size_t days() const;
+
+    unsigned long long switches() const;
+
+    /**
+     * @returns the mean, median and greatest number of switches on each
+     * of days(); or zero if there are no such days.
+     */
+    double mean_daily_switches() const;
+    double median_daily_switches() const;
+    unsigned long long most_daily_switches() const;
+
+    DurationSketch const& focus_blocks() const;
+    DurationSketch const& idle_gaps() const;
+
+    /**
+     * @returns the (at most) \e p_k pairs of activities switched between
+     * most often, in either direction, from most to least (ties being in
+     * order of activity name).
+     */
+    std::vector<SwitchCount> top_switches(std::size_t p_k) const;
+
+private:
+    void begin_day(TimePoint const& p_day_beginning);
+    std::vector<unsigned long long> daily_switches() const;
+
+// member variables
+private:
+    bool m_has_been_active = false;
+    std::string const* m_previous_activity = nullptr;
+    bool m_is_previous_included = false;
+    bool m_has_pending_gap = false;
+    unsigned long long m_pending_gap = 0;
+    bool m_is_day_open = false;
+    TimePoint m_day_beginning;
+    unsigned long long m_day_switches = 0;
+    std::vector<unsigned long long> m_closed_daily_switches;
+    unsigned long long m_switches = 0;
+    DurationSketch m_focus_blocks;
+    DurationSketch m_idle_gaps;
+    std::unordered_map<ActivityPair, unsigned long long, ActivityPairHash> m_pair_counts;
+
+};  // class WorkPattern
+
+}  // namespace swx
+
+#endif  // GUARD_work_pattern_hpp_0757059223229028
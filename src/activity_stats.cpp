@@ -48,6 +48,7 @@ operator+=(ActivityStats& lhs, ActivityStats const& rhs)
     lhs.seconds += rhs.seconds;
     lhs.beginning = min(lhs.beginning, rhs.beginning);
     lhs.ending = max(lhs.ending, rhs.ending);
+    lhs.durations += rhs.durations;
     return lhs;
 }
 
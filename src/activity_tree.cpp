@@ -18,6 +18,7 @@
 #include "activity_stats.hpp"
 #include "activity_node.hpp"
 #include "arithmetic.hpp"
+#include "profiler.hpp"
 #include "string_utilities.hpp"
 #include <cassert>
 #include <map>
@@ -40,6 +41,7 @@ namespace swx
 ActivityTree::ActivityTree(map<string, ActivityStats> const& p_stats):
     m_root(ActivityNode())
 {
+    Profiler::Phase const phase("activity_tree");
     // Calculate the greatest number of components of any activity
     vector<string>::size_type depth = 0;
     for (auto const& p: p_stats) depth = max(depth, split(p.first).size());
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Replacements for the global allocation functions, which keep running
+// totals of allocations and report each allocation to the Profiler. This
+// file forms the swx_allocation_hooks library, which is linked only into
+// the executables that want allocations counted.
+
+#include "allocation_hooks.hpp"
+#include "profiler.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+using std::atomic;
+using std::bad_alloc;
+using std::free;
+using std::malloc;
+using std::memory_order_relaxed;
+using std::nothrow_t;
+using std::size_t;
+using swx::AllocationCounts;
+using swx::Profiler;
+
+namespace
+{
+    atomic<unsigned long long> s_allocations(0);
+    atomic<unsigned long long> s_bytes(0);
+
+    void* counted_allocate(size_t p_size) noexcept
+    {
+        s_allocations.fetch_add(1, memory_order_relaxed);
+        s_bytes.fetch_add(p_size, memory_order_relaxed);
+        Profiler::count_allocation(p_size);
+        return malloc(p_size == 0 ? 1 : p_size);
+    }
+
+}  // end anonymous namespace
+
+void* operator new(size_t p_size)
+{
+    if (auto const ret = counted_allocate(p_size)) return ret;
+    throw bad_alloc();
+}
+
+void* operator new[](size_t p_size)
+{
+    if (auto const ret = counted_allocate(p_size)) return ret;
+    throw bad_alloc();
+}
+
+void* operator new(size_t p_size, nothrow_t const&) noexcept
+{
+    return counted_allocate(p_size);
+}
+
+void* operator new[](size_t p_size, nothrow_t const&) noexcept
+{
+    return counted_allocate(p_size);
+}
+
+void operator delete(void* p_ptr) noexcept
+{
+    free(p_ptr);
+}
+
+void operator delete[](void* p_ptr) noexcept
+{
+    free(p_ptr);
+}
+
+void operator delete(void* p_ptr, size_t) noexcept
+{
+    free(p_ptr);
+}
+
+void operator delete[](void* p_ptr, size_t) noexcept
+{
+    free(p_ptr);
+}
+
+namespace swx
+{
+
+AllocationCounts
+allocation_counts()
+{
+    AllocationCounts ret;
+    ret.allocations = s_allocations.load(memory_order_relaxed);
+    ret.bytes = s_bytes.load(memory_order_relaxed);
+    return ret;
+}
+
+}  // namespace swx
@@ -0,0 +1,263 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "analyze_command.hpp"
+#include "activity_filter.hpp"
+#include "arithmetic.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "duration_sketch.hpp"
+#include "help_line.hpp"
+#include "placeholder.hpp"
+#include "stint.hpp"
+#include "stream_flag_guard.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include "work_pattern.hpp"
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::ostream;
+using std::right;
+using std::runtime_error;
+using std::setprecision;
+using std::setw;
+using std::string;
+using std::stringstream;
+using std::to_string;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    bool parse_positive(string const& p_str, unsigned int& p_value)
+    {
+        stringstream ss(p_str);
+        ss >> p_value;
+        return ss && ss.eof() && (p_value != 0);
+    }
+
+}  // end anonymous namespace
+
+AnalyzeCommand::AnalyzeCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Print measures of how fragmented time has been",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print the number of switches between activities per day, the "
+                    "lengths of uninterrupted stints on an activity and of idle "
+                    "gaps between them, and the activities switched between "
+                    "most often"
+            ),
+            HelpLine
+            (   "Print the same, but counting only stints on ACTIVITY and its "
+                    "subactivities, and switches to or from them",
+                "<ACTIVITY>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"x", "exact"},
+        "Include only the exact ACTIVITY given; not its subactivities",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::exact; }
+    );
+    add_option
+    (   vector<string>{"r", "regex"},
+        "Treat ACTIVITY as a regular expression, and include all activities "
+            "that match it",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::regex; }
+    );
+    add_option
+    (   vector<string>{"n", "top"},
+        HelpLine("Show the N pairs of activities switched between most (default 10)", "<N>"),
+        nullptr,
+        &m_top_str
+    );
+    add_option
+    (   vector<string>{"f", "from"},
+        HelpLine("Include only time from TIMESTAMP onwards", "<TIMESTAMP>"),
+        nullptr,
+        &m_since_str
+    );
+    add_option
+    (   vector<string>{"t", "to"},
+        HelpLine("Include only time before TIMESTAMP", "<TIMESTAMP>"),
+        nullptr,
+        &m_until_str
+    );
+}
+
+AnalyzeCommand::~AnalyzeCommand() = default;
+
+bool
+AnalyzeCommand::does_support_placeholders() const
+{
+    return true;
+}
+
+Command::ErrorMessages
+AnalyzeCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    ErrorMessages ret;
+    unsigned int top = 0;
+    if (!parse_positive(m_top_str, top))
+    {
+        ret.push_back("Could not parse \"" + m_top_str + "\" as positive numeric argument.");
+    }
+    auto const long_time_fmt = p_config.time_format();
+    auto const short_time_fmt = p_config.short_time_format();
+    unique_ptr<TimePoint> since_time_point_ptr;
+    unique_ptr<TimePoint> until_time_point_ptr;
+    if (!m_since_str.empty())
+    {
+        try
+        {
+            since_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_since_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_since_str);
+        }
+    }
+    if (!m_until_str.empty())
+    {
+        try
+        {
+            until_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_until_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_until_str);
+        }
+    }
+    if (!ret.empty())
+    {
+        return ret;
+    }
+
+    string comparitor;
+    auto filter_type = m_activity_filter_type;
+    if (p_ordinary_args.empty())
+    {
+        filter_type = ActivityFilter::Type::always_true;
+    }
+    else
+    {
+        comparitor = expand_placeholders(p_ordinary_args, m_time_log);
+    }
+    unique_ptr<ActivityFilter> const
+        filter(ActivityFilter::create(comparitor, filter_type));
+
+    // Every stint is needed, so that switches and idle gaps are seen whatever
+    // the activities of interest; each is tested against the filter once.
+    unique_ptr<ActivityFilter> const
+        all(ActivityFilter::create(string(), ActivityFilter::Type::always_true));
+    WorkPattern pattern;
+    for (auto const& stint: m_time_log.get_stints
+        (*all, since_time_point_ptr.get(), until_time_point_ptr.get()))
+    {
+        auto const& activity = stint.activity();
+        pattern.add(stint, !activity.empty() && filter->matches(activity));
+    }
+
+    auto const to_rounded_hours = [&p_config](double p_seconds)
+    {
+        return round
+        (   p_seconds / 60.0 / 60.0,
+            p_config.output_rounding_numerator(),
+            p_config.output_rounding_denominator()
+        );
+    };
+    auto const count_width = to_string(pattern.switches()).length();
+    auto const label_width = 15;
+    StreamFlagGuard guard(p_ordinary_ostream);
+    p_ordinary_ostream << fixed << setprecision(1);
+    p_ordinary_ostream << left << setw(label_width) << "Days:" << right
+                       << setw(count_width) << pattern.days() << endl;
+    p_ordinary_ostream << left << setw(label_width) << "Switches:" << right
+                       << setw(count_width) << pattern.switches()
+                       << "; per day: mean " << pattern.mean_daily_switches()
+                       << ", median " << pattern.median_daily_switches()
+                       << ", most " << pattern.most_daily_switches() << endl;
+    auto const write_durations = [&](char const* p_label, DurationSketch const& p_sketch)
+    {
+        p_ordinary_ostream << left << setw(label_width) << p_label << right
+                           << setw(count_width) << p_sketch.count() << ';'
+                           << setprecision(p_config.output_precision());
+        auto const write_hours = [&](char const* p_name, double p_seconds)
+        {
+            p_ordinary_ostream << ' ' << p_name << ' ' << setw(p_config.output_width())
+                               << to_rounded_hours(p_seconds);
+        };
+        write_hours("mean", p_sketch.mean());
+        p_ordinary_ostream << ',';
+        write_hours("median", p_sketch.quantile(0.5));
+        p_ordinary_ostream << ',';
+        write_hours("p90", p_sketch.quantile(0.9));
+        p_ordinary_ostream << ',';
+        write_hours("max", p_sketch.max());
+        p_ordinary_ostream << " hours" << endl;
+    };
+    write_durations("Focus blocks:", pattern.focus_blocks());
+    write_durations("Idle gaps:", pattern.idle_gaps());
+
+    auto const top_switches = pattern.top_switches(top);
+    if (!top_switches.empty())
+    {
+        p_ordinary_ostream << endl << "Most frequent switches:" << endl;
+        auto const top_width = to_string(top_switches.front().count).length();
+        for (auto const& entry: top_switches)
+        {
+            p_ordinary_ostream << "  " << setw(top_width) << entry.count << "  "
+                               << *entry.first << " <-> " << *entry.second << endl;
+        }
+    }
+    return ret;
+}
+
+}  // namespace swx
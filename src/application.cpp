@@ -15,23 +15,37 @@
  */
 
 #include "application.hpp"
+#include "analyze_command.hpp"
+#include "at_command.hpp"
+#include "batch_command.hpp"
 #include "command.hpp"
 #include "config.hpp"
 #include "config_command.hpp"
 #include "current_command.hpp"
 #include "day_command.hpp"
+#include "delete_command.hpp"
 #include "edit_command.hpp"
 #include "exit_code.hpp"
+#include "export_command.hpp"
+#include "goals_command.hpp"
+#include "heatmap_command.hpp"
 #include "help_command.hpp"
+#include "import_command.hpp"
 #include "info.hpp"
+#include "insert_command.hpp"
+#include "note_command.hpp"
 #include "placeholder.hpp"
 #include "print_command.hpp"
+#include "query_command.hpp"
+#include "rank_command.hpp"
 #include "rename_command.hpp"
 #include "resume_command.hpp"
+#include "rollup_command.hpp"
 #include "stream_utilities.hpp"
 #include "string_utilities.hpp"
 #include "switch_command.hpp"
 #include "time_log.hpp"
+#include "trend_command.hpp"
 #include "version_command.hpp"
 #include <cassert>
 #include <cstdlib>
@@ -82,25 +96,95 @@ Application::Application
     m_ordinary_ostream(p_ordinary_ostream),
     m_error_ostream(p_error_ostream),
     m_config(p_config),
-    m_time_log(p_config.path_to_log(), p_config.time_format(), p_config.formatted_buf_len())
+    m_owned_time_log
+    (   new TimeLog
+        (   p_config.path_to_log(),
+            p_config.time_format(),
+            p_config.formatted_buf_len()
+        )
+    ),
+    m_time_log(*m_owned_time_log)
+{
+    create_commands();
+}
+
+Application::Application
+(   Config const& p_config,
+    TimeLog& p_time_log,
+    ostream& p_ordinary_ostream,
+    ostream& p_error_ostream
+):
+    m_ordinary_ostream(p_ordinary_ostream),
+    m_error_ostream(p_error_ostream),
+    m_config(p_config),
+    m_time_log(p_time_log)
+{
+    create_commands();
+}
+
+Application::~Application() = default;
+
+Application::CommandEntry::CommandEntry(Factory const& p_factory):
+    m_factory(p_factory)
+{
+}
+
+Application::CommandEntry::~CommandEntry() = default;
+
+Command&
+Application::CommandEntry::command() const
+{
+    if (!m_command)
+    {
+        m_command = m_factory();
+        assert (m_command);
+    }
+    return *m_command;
+}
+
+void
+Application::create_commands()
 {
     using V = vector<string>;
 
     CommandGroup rec("Recording commands");
     create_command<SwitchCommand>(rec, "switch", V{"s"}, m_time_log);
     create_command<ResumeCommand>(rec, "resume", V{}, m_time_log);
+    create_command<NoteCommand>(rec, "note", V{}, m_time_log);
     m_command_groups.push_back(move(rec));
 
     CommandGroup rep("Reporting commands");
     create_command<PrintCommand>(rep, "print", V{"p"}, m_time_log);
     create_command<DayCommand>(rep, "day", V{"d"}, m_time_log);
+    create_command<GoalsCommand>(rep, "goals", V{}, m_time_log);
+    create_command<HeatmapCommand>(rep, "heatmap", V{}, m_time_log);
+    create_command<RankCommand>(rep, "rank", V{}, m_time_log);
+    create_command<AnalyzeCommand>(rep, "analyze", V{}, m_time_log);
+    create_command<AtCommand>(rep, "at", V{}, m_time_log);
+    create_command<QueryCommand>(rep, "query", V{}, m_time_log);
+    create_command<RollupCommand>(rep, "rollup", V{});
+    create_command<TrendCommand>(rep, "trend", V{}, m_time_log);
     m_command_groups.push_back(move(rep));
 
     CommandGroup edit("Editing commands");
     create_command<RenameCommand>(edit, "rename", V{}, m_time_log);
+    create_command<InsertCommand>(edit, "insert", V{}, m_time_log);
+    create_command<DeleteCommand>(edit, "delete", V{}, m_time_log);
     create_command<EditCommand>(edit, "edit", V{"e"});
     m_command_groups.push_back(move(edit));
 
+    CommandGroup bulk("Bulk commands");
+    create_command<BatchCommand>
+    (   bulk,
+        "batch",
+        V{},
+        m_time_log,
+        m_error_ostream
+    );
+    create_command<ImportCommand>(bulk, "import", V{}, m_time_log);
+    create_command<ExportCommand>(bulk, "export", V{}, m_time_log);
+    m_command_groups.push_back(move(bulk));
+
     CommandGroup misc("Miscellaneous commands");
     create_command<CurrentCommand>(misc, "current", V{"c"}, m_time_log);
     create_command<ConfigCommand>(misc, "config", V{});
@@ -116,8 +200,6 @@ Application::Application
 #   endif
 }
 
-Application::~Application() = default;
-
 ExitCode
 Application::process_command(string const& p_command, vector<string> const& p_args) const
 {
@@ -129,8 +211,7 @@ Application::process_command(string const& p_command, vector<string> const& p_ar
     else
     {
         assert (it->second);
-        auto const command_ptr = it->second;
-        auto const ret = command_ptr->process
+        auto const ret = it->second->command().process
         (   m_config,
             p_args,
             ordinary_ostream(),
@@ -154,7 +235,7 @@ Application::help_information(string const& p_command) const
         (   error_message_for_unrecognized_command(p_command)
         );
     }
-    return it->second->usage_descriptor();
+    return it->second->command().usage_descriptor();
 }
 
 string
@@ -168,9 +249,9 @@ Application::help_information() const
     string::size_type width = 0;
     for (auto const& group: m_command_groups)
     {
-        for (auto const& command_ptr: group.commands)
+        for (auto const& entry: group.commands)
         {
-            auto const& command = *command_ptr;
+            auto const& command = entry->command();
             string::size_type current_width = command.command_word().size();
             for (auto const& alias: command.aliases())
             {
@@ -184,9 +265,9 @@ Application::help_information() const
     for (auto const& group: m_command_groups)
     {
         oss << '\n' << group.label << ":\n\n";
-        for (auto const& command_ptr: group.commands)
+        for (auto const& entry: group.commands)
         {
-            auto const& command = *command_ptr;
+            auto const& command = entry->command();
             StreamFlagGuard guard(oss);
             ostringstream oss2;
             enable_exceptions(oss2);
@@ -267,7 +348,7 @@ Application::error_ostream() const
 void
 Application::register_command_word
 (   string const& p_word,
-    shared_ptr<Command> const& p_cp
+    shared_ptr<CommandEntry> const& p_entry
 )
 {
     if (m_command_map.find(p_word) != m_command_map.end())
@@ -279,7 +360,7 @@ Application::register_command_word
             << "\" has already been registered.";
         throw runtime_error(oss.str());
     }
-    m_command_map[p_word] = p_cp;
+    m_command_map[p_word] = p_entry;
 }
 
 }  // namespace swx
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "at_command.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "csv_row.hpp"
+#include "help_line.hpp"
+#include "string_utilities.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::cin;
+using std::getline;
+using std::ifstream;
+using std::istream;
+using std::ostream;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    string const k_stdin_filepath = "-";
+
+}  // end anonymous namespace
+
+AtCommand::AtCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Print the activity that was ongoing at each of a list of times",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Read timestamps from standard input, one per line, and print "
+                    "each, in the same order, followed by the activity that was "
+                    "ongoing at that time (if any)"
+            ),
+            HelpLine
+            (   "Read timestamps from FILE, one per line (if FILE is \"-\", read "
+                    "from standard input)",
+                "<FILE>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"csv"},
+        "Output in CSV format, with a row for each timestamp",
+        [this]() { m_csv = true; }
+    );
+}
+
+AtCommand::~AtCommand() = default;
+
+Command::ErrorMessages
+AtCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    if (p_ordinary_args.size() > 1)
+    {
+        return {"Too many arguments passed to this command."};
+    }
+    if (p_ordinary_args.empty() || (p_ordinary_args[0] == k_stdin_filepath))
+    {
+        return process_lines(p_config, cin, p_ordinary_ostream);
+    }
+    ifstream infile(p_ordinary_args[0].c_str());
+    if (!infile)
+    {
+        return {"Could not open file: " + p_ordinary_args[0]};
+    }
+    return process_lines(p_config, infile, p_ordinary_ostream);
+}
+
+Command::ErrorMessages
+AtCommand::process_lines
+(   Config const& p_config,
+    istream& p_is,
+    ostream& p_ordinary_ostream
+)
+{
+    // All the timestamps are read before any is looked up, so that they can
+    // be looked up together.
+    ErrorMessages ret;
+    vector<string> time_stamps;
+    vector<TimePoint> time_points;
+    string line;
+    for (size_t line_number = 1; getline(p_is, line); ++line_number)
+    {
+        auto const time_stamp = trim(line);
+        if (time_stamp.empty()) continue;
+        try
+        {
+            time_points.push_back
+            (   time_stamp_to_point
+                (   time_stamp,
+                    p_config.time_format(),
+                    p_config.short_time_format()
+                )
+            );
+            time_stamps.push_back(time_stamp);
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back
+            (   "Could not parse timestamp on line " + to_string(line_number) +
+                    ": " + time_stamp
+            );
+        }
+    }
+    if (!ret.empty())
+    {
+        return ret;
+    }
+    auto const activities = m_time_log.activities_at(time_points);
+    if (m_csv)
+    {
+        CsvRow header;
+        header << "time" << "activity";
+        p_ordinary_ostream << header;
+    }
+    for (size_t i = 0; i != time_stamps.size(); ++i)
+    {
+        if (m_csv)
+        {
+            CsvRow row;
+            row << time_stamps[i] << activities[i];
+            p_ordinary_ostream << row;
+        }
+        else
+        {
+            p_ordinary_ostream << time_stamps[i];
+            if (!activities[i].empty()) p_ordinary_ostream << ' ' << activities[i];
+            p_ordinary_ostream << '\n';
+        }
+    }
+    return ret;
+}
+
+}  // namespace swx
@@ -17,6 +17,7 @@
 #include "atomic_writer.hpp"
 #include "info.hpp"
 #include "file_utilities.hpp"
+#include "profiler.hpp"
 #include <cassert>
 #include <cerrno>
 #include <cstddef>
@@ -101,6 +102,7 @@ AtomicWriter::append(string const& p_str)
     {
         throw runtime_error("Error appending to file.");
     }
+    Profiler::count(Profiler::Counter::bytes_written, p_str.size());
 }
 
 void
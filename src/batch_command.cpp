@@ -0,0 +1,218 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "batch_command.hpp"
+#include "application.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "help_line.hpp"
+#include "stream_utilities.hpp"
+#include "string_utilities.hpp"
+#include "time_log.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::cin;
+using std::endl;
+using std::find;
+using std::getline;
+using std::ifstream;
+using std::istream;
+using std::ostream;
+using std::ostringstream;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    char const k_commenting_char = '#';
+    string const k_stdin_filepath = "-";
+
+}  // end anonymous namespace
+
+BatchCommand::BatchCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log,
+    ostream& p_error_ostream
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Execute a sequence of commands read from a file",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Read commands from standard input, one per line, and execute "
+                    "each of them in turn"
+            ),
+            HelpLine
+            (   "Read commands from FILE, one per line, and execute each of them "
+                    "in turn (if FILE is \"-\", read from standard input)",
+                "<FILE>"
+            )
+        }
+    ),
+    m_time_log(p_time_log),
+    m_error_ostream(p_error_ostream)
+{
+    add_option
+    (   vector<string>{"group"},
+        HelpLine
+        (   "Save any changes to the activity log after every N lines; or if "
+                "passed 0, save only once all lines have been executed (the "
+                "default)",
+            "<N>"
+        ),
+        nullptr,
+        &m_group_size_str
+    );
+    add_option
+    (   vector<string>{"stop-on-error"},
+        "Do not execute any further lines after a line fails",
+        [this]() { m_stop_on_error = true; }
+    );
+}
+
+BatchCommand::~BatchCommand() = default;
+
+Command::ErrorMessages
+BatchCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    if (p_ordinary_args.size() > 1)
+    {
+        return {"Too many arguments passed to this command."};
+    }
+    if (p_ordinary_args.empty() || (p_ordinary_args[0] == k_stdin_filepath))
+    {
+        return process_lines(p_config, cin, p_ordinary_ostream);
+    }
+    ifstream infile(p_ordinary_args[0].c_str());
+    if (!infile)
+    {
+        return {"Could not open file: " + p_ordinary_args[0]};
+    }
+    return process_lines(p_config, infile, p_ordinary_ostream);
+}
+
+Command::ErrorMessages
+BatchCommand::process_lines
+(   Config const& p_config,
+    istream& p_is,
+    ostream& p_ordinary_ostream
+)
+{
+    size_t group_size = 0;
+    stringstream ss(m_group_size_str);
+    ss >> group_size;
+    if (!ss)
+    {
+        return {"Could not parse \"" + m_group_size_str + "\" as numeric argument."};
+    }
+    auto const& batch_aliases = aliases();
+    auto const is_batch_word = [this, &batch_aliases](string const& p_word)
+    {
+        return
+            (p_word == command_word()) ||
+            (find(batch_aliases.begin(), batch_aliases.end(), p_word) != batch_aliases.end());
+    };
+
+    size_t line_number = 0;
+    size_t num_executed = 0;
+    size_t num_failed = 0;
+    size_t num_in_group = 0;
+    string line;
+    m_time_log.defer_saving();
+    while (getline(p_is, line))
+    {
+        ++line_number;
+        auto const trimmed_line = trim(line);
+        if (trimmed_line.empty() || (trimmed_line[0] == k_commenting_char))
+        {
+            continue;
+        }
+        ostringstream line_error_stream;
+        enable_exceptions(line_error_stream);
+        auto exit_code = EXIT_FAILURE;
+        try
+        {
+            auto const args = split_command_line(trimmed_line);
+            if (is_batch_word(args.front()))
+            {
+                line_error_stream << "Batch commands cannot be nested." << endl;
+            }
+            else
+            {
+                // Commands retain the state of their options between calls, so
+                // each line is given a fresh set of commands; but these all
+                // share the one TimeLog.
+                Application const application
+                (   p_config,
+                    m_time_log,
+                    p_ordinary_ostream,
+                    line_error_stream
+                );
+                vector<string> const command_args(args.begin() + 1, args.end());
+                exit_code = application.process_command(args.front(), command_args);
+            }
+        }
+        catch (runtime_error& e)
+        {
+            line_error_stream << "Error: " << e.what() << endl;
+        }
+        ++num_executed;
+        if (exit_code != EXIT_SUCCESS)
+        {
+            ++num_failed;
+            m_error_ostream << "Line " << line_number << ": " << line_error_stream.str();
+            if (m_stop_on_error) break;
+        }
+        if ((group_size != 0) && (++num_in_group == group_size))
+        {
+            m_time_log.save_deferred();
+            m_time_log.defer_saving();
+            num_in_group = 0;
+        }
+    }
+    m_time_log.save_deferred();
+    if (num_failed != 0)
+    {
+        ostringstream oss;
+        enable_exceptions(oss);
+        oss << num_failed << " of " << num_executed << " commands failed.";
+        return {oss.str()};
+    }
+    return ErrorMessages();
+}
+
+}  // namespace swx
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bucket_report_writer.hpp"
+#include "interval.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using std::chrono::duration_cast;
+using std::chrono::seconds;
+using std::min;
+using std::ostream;
+using std::size_t;
+using std::string;
+using std::upper_bound;
+using std::vector;
+
+namespace swx
+{
+
+BucketReportWriter::BucketReportWriter
+(   vector<Stint> const& p_stints,
+    Options const& p_options,
+    Flags::Type p_flags
+):
+    ReportWriter(p_stints, p_options),
+    m_flags(p_flags)
+{
+    assert (m_flags & Flags::by_period);
+}
+
+BucketReportWriter::~BucketReportWriter() = default;
+
+void
+BucketReportWriter::do_preprocess_stints
+(   ostream& p_os,
+    vector<Stint> const& p_stints
+)
+{
+    (void)p_os; (void)p_stints;  // silence compiler warnings re. unused params.
+    assert (m_rows.empty());
+    assert (m_boundaries.empty());
+}
+
+void
+BucketReportWriter::do_process_stint(ostream& p_os, Stint const& p_stint)
+{
+    (void)p_os;  // silence compiler warning re. unused param.
+    auto const& activity = p_stint.activity();
+    if (activity.empty()) return;
+    auto const interval = p_stint.interval();
+    auto beginning = interval.beginning();
+    auto const ending = interval.ending();
+    auto& row = m_rows[activity];
+    while (beginning < ending)
+    {
+        auto const index = bucket_index(beginning);
+        auto const slice_ending = min(ending, m_boundaries[index + 1]);
+        if (row.size() <= index) row.resize(index + 1, 0);
+        row[index] += duration_cast<seconds>(slice_ending - beginning).count();
+        beginning = slice_ending;
+    }
+}
+
+void
+BucketReportWriter::do_postprocess_stints
+(   ostream& p_os,
+    vector<Stint> const& p_stints
+)
+{
+    (void)p_stints;  // silence compiler warning re. unused param.
+    auto const format = has_flag(Flags::by_month) ? "%Y-%m" : "%Y-%m-%d";
+    vector<string> labels;
+    for (size_t i = 0; i + 1 < m_boundaries.size(); ++i)
+    {
+        labels.push_back(time_point_to_stamp(m_boundaries[i], format, formatted_buf_len()));
+    }
+    do_write_matrix(p_os, labels, m_rows);
+    m_rows.clear();  // hygienic even if unnecessary
+    m_boundaries.clear();
+    m_current_bucket = 0;
+}
+
+bool
+BucketReportWriter::has_flag(Flags::Type p_flag) const
+{
+    return m_flags & p_flag;
+}
+
+TimePoint
+BucketReportWriter::bucket_begin(TimePoint const& p_time_point, int p_diff) const
+{
+    if (has_flag(Flags::by_day)) return day_begin(p_time_point, p_diff);
+    if (has_flag(Flags::by_week)) return week_begin(p_time_point, p_diff);
+    assert (has_flag(Flags::by_month));
+    return month_begin(p_time_point, p_diff);
+}
+
+size_t
+BucketReportWriter::bucket_index(TimePoint const& p_time_point)
+{
+    // Stints mostly arrive in order, so the bucket sought is usually the
+    // current one or shortly after it; the calendar is consulted only to
+    // extend the range of buckets.
+    if (m_boundaries.empty())
+    {
+        m_boundaries.push_back(bucket_begin(p_time_point));
+        m_boundaries.push_back(bucket_begin(p_time_point, 1));
+        m_current_bucket = 0;
+    }
+    else if (p_time_point < m_boundaries.front())
+    {
+        vector<TimePoint> earlier{bucket_begin(p_time_point)};
+        while (earlier.back() < m_boundaries.front())
+        {
+            earlier.push_back(bucket_begin(earlier.back(), 1));
+        }
+        earlier.pop_back();
+        for (auto& row: m_rows)
+        {
+            if (!row.second.empty()) row.second.insert(row.second.begin(), earlier.size(), 0);
+        }
+        m_boundaries.insert(m_boundaries.begin(), earlier.begin(), earlier.end());
+        m_current_bucket = 0;
+    }
+    else if (p_time_point < m_boundaries[m_current_bucket])
+    {
+        auto const it = upper_bound(m_boundaries.begin(), m_boundaries.end(), p_time_point);
+        m_current_bucket = (it - m_boundaries.begin()) - 1;
+    }
+    while (m_boundaries[m_current_bucket + 1] <= p_time_point)
+    {
+        ++m_current_bucket;
+        if (m_current_bucket + 1 == m_boundaries.size())
+        {
+            m_boundaries.push_back(bucket_begin(m_boundaries.back(), 1));
+        }
+    }
+    return m_current_bucket;
+}
+
+}  // namespace swx
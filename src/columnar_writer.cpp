@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "columnar_writer.hpp"
+#include "interval.hpp"
+#include "stint.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using std::int64_t;
+using std::numeric_limits;
+using std::ostream;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::uint32_t;
+using std::uint64_t;
+using std::unordered_map;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+
+namespace
+{
+    char const k_magic[] = {'S', 'W', 'X', 'C'};
+    uint32_t const k_format_version = 1;
+    size_t const k_alignment = 8;
+
+    // Appends the little-endian representation of p_value to p_buf,
+    // regardless of the byte order of the host.
+    template <typename T>
+    void put(vector<char>& p_buf, T p_value)
+    {
+        auto const value = static_cast<uint64_t>(p_value);
+        for (size_t i = 0; i != sizeof(T); ++i)
+        {
+            p_buf.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    void pad(vector<char>& p_buf)
+    {
+        while (p_buf.size() % k_alignment != 0) p_buf.push_back('\0');
+    }
+
+    size_t write_block(ostream& p_os, vector<char>& p_buf)
+    {
+        pad(p_buf);
+        p_os.write(p_buf.data(), p_buf.size());
+        if (!p_os)
+        {
+            throw runtime_error("Error writing output.");
+        }
+        return p_buf.size();
+    }
+
+}  // end anonymous namespace
+
+ColumnarWriter::ColumnarWriter(vector<Stint> const& p_stints):
+    m_stints(p_stints)
+{
+}
+
+ColumnarWriter::~ColumnarWriter() = default;
+
+size_t
+ColumnarWriter::write(ostream& p_os) const
+{
+    // Stints refer to activity strings held by the TimeLog, and distinct
+    // activities are distinct strings, so the address of the string is
+    // enough to identify the activity without hashing its contents.
+    unordered_map<string const*, uint32_t> ids;
+    vector<string const*> dictionary;
+    size_t num_stints = 0;
+    for (auto const& stint: m_stints)
+    {
+        auto const& activity = stint.activity();
+        if (activity.empty()) continue;
+        ++num_stints;
+        if (ids.emplace(&activity, static_cast<uint32_t>(dictionary.size())).second)
+        {
+            dictionary.push_back(&activity);
+        }
+    }
+
+    uint64_t names_size = 0;
+    for (auto const activity: dictionary) names_size += activity->size();
+
+    vector<char> buf;
+    buf.reserve(num_stints * sizeof(int64_t));
+    buf.insert(buf.end(), k_magic, k_magic + sizeof(k_magic));
+    put<uint32_t>(buf, k_format_version);
+    put<uint64_t>(buf, num_stints);
+    put<uint64_t>(buf, dictionary.size());
+    put<uint64_t>(buf, names_size);
+    size_t ret = write_block(p_os, buf);
+
+    buf.clear();
+    for (auto const& stint: m_stints)
+    {
+        if (stint.activity().empty()) continue;
+        auto const beginning = stint.interval().beginning().time_since_epoch();
+        put<int64_t>(buf, chrono::duration_cast<chrono::seconds>(beginning).count());
+    }
+    ret += write_block(p_os, buf);
+
+    buf.clear();
+    for (auto const& stint: m_stints)
+    {
+        if (stint.activity().empty()) continue;
+        auto const seconds = stint.interval().duration().count();
+        if (seconds > numeric_limits<uint32_t>::max())
+        {
+            throw runtime_error("Stint too long to export.");
+        }
+        put<uint32_t>(buf, seconds);
+    }
+    ret += write_block(p_os, buf);
+
+    buf.clear();
+    for (auto const& stint: m_stints)
+    {
+        if (stint.activity().empty()) continue;
+        put<uint32_t>(buf, ids.find(&stint.activity())->second);
+    }
+    ret += write_block(p_os, buf);
+
+    buf.clear();
+    uint64_t offset = 0;
+    put<uint64_t>(buf, offset);
+    for (auto const activity: dictionary)
+    {
+        offset += activity->size();
+        put<uint64_t>(buf, offset);
+    }
+    ret += write_block(p_os, buf);
+
+    buf.clear();
+    for (auto const activity: dictionary)
+    {
+        buf.insert(buf.end(), activity->begin(), activity->end());
+    }
+    ret += write_block(p_os, buf);
+    return ret;
+}
+
+}  // namespace swx
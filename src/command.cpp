@@ -85,7 +85,8 @@ public:
     (   vector<string> const& p_aliases,
         HelpLine const& p_help_line,
         function<void()> const& p_callback,
-        string* p_arg_target = nullptr
+        string* p_arg_target = nullptr,
+        vector<string>* p_arg_list_target = nullptr
     );
     bool has_options() const;
     Result<vector<string>> parse_args(vector<string> const& p_args);
@@ -110,11 +111,15 @@ struct Command::Impl::Option
     (   vector<string> const& p_aliases,
         HelpLine const& p_help_line,
         function<void()> const& p_callback,
-        string* p_arg_target = nullptr
+        string* p_arg_target = nullptr,
+        vector<string>* p_arg_list_target = nullptr
     );
+    bool takes_argument() const;
+    void assign_argument(string const& p_argument) const;
     HelpLine help_line;
     function<void()> callback;
     string* arg_target = nullptr;
+    vector<string>* arg_list_target = nullptr;
     vector<string> aliases;
 };
 
@@ -151,6 +156,17 @@ Command::add_option
     m_impl->add_option(p_aliases, p_help_line, p_callback, p_arg_target);
 }
 
+void
+Command::add_option
+(   vector<string> const& p_aliases,
+    HelpLine const& p_help_line,
+    vector<string>* p_arg_list_target
+)
+{
+    assert (p_arg_list_target);
+    m_impl->add_option(p_aliases, p_help_line, nullptr, nullptr, p_arg_list_target);
+}
+
 ExitCode
 Command::process
 (   Config const& p_config,
@@ -205,15 +221,30 @@ Command::Impl::Option::Option
 (   vector<string> const& p_aliases,
     HelpLine const& p_help_line,
     function<void()> const& p_callback,
-    string* p_arg_target
+    string* p_arg_target,
+    vector<string>* p_arg_list_target
 ):
     help_line(p_help_line),
     callback(p_callback),
     arg_target(p_arg_target),
+    arg_list_target(p_arg_list_target),
     aliases(p_aliases)
 {
 }
 
+bool
+Command::Impl::Option::takes_argument() const
+{
+    return (arg_target != nullptr) || (arg_list_target != nullptr);
+}
+
+void
+Command::Impl::Option::assign_argument(string const& p_argument) const
+{
+    if (arg_target) *arg_target = p_argument;
+    else if (arg_list_target) arg_list_target->push_back(p_argument);
+}
+
 Command::Impl::Impl
 (   string const& p_command_word,
     vector<string> const& p_aliases,
@@ -234,7 +265,8 @@ Command::Impl::add_option
 (   vector<string> const& p_aliases,
     HelpLine const& p_help_line,
     function<void()> const& p_callback,
-    string* p_arg_target
+    string* p_arg_target,
+    vector<string>* p_arg_list_target
 )
 {
     if (m_accept_ordinary_args && m_options.empty())
@@ -260,7 +292,13 @@ Command::Impl::add_option
         }
         m_options_map.emplace(alias, m_options.size());
     }
-    m_options.emplace_back(p_aliases, p_help_line, p_callback, p_arg_target);
+    m_options.emplace_back
+    (   p_aliases,
+        p_help_line,
+        p_callback,
+        p_arg_target,
+        p_arg_list_target
+    );
 }
 
 bool
@@ -329,7 +367,7 @@ Command::Impl::parse_args(vector<string> const& p_args)
             }
             auto const& opt = m_options[opt_it->second];
             if (opt.callback != nullptr) opt.callback();
-            if (opt.arg_target == nullptr)
+            if (!opt.takes_argument())
             {
                 if (option_argument_found)
                 {
@@ -340,10 +378,10 @@ Command::Impl::parse_args(vector<string> const& p_args)
                 }
                 continue;  // option does not take an argument
             }
-            assert (opt.arg_target != nullptr);
+            assert (opt.takes_argument());
             if (option_argument_found)
             {
-                *opt.arg_target = option_argument;
+                opt.assign_argument(option_argument);
             }
             else
             {
@@ -357,7 +395,7 @@ Command::Impl::parse_args(vector<string> const& p_args)
                 }
                 else
                 {
-                    *opt.arg_target = *it;
+                    opt.assign_argument(*it);
                 }
             }
         }
@@ -381,7 +419,7 @@ Command::Impl::parse_args(vector<string> const& p_args)
                 assert (opt_it != m_options_map.end());
                 auto const& opt = m_options[opt_it->second];
                 if (opt.callback != nullptr) opt.callback();
-                if (opt.arg_target == nullptr)
+                if (!opt.takes_argument())
                 {
                     continue;  // option does not take an argument
                 }
@@ -396,8 +434,8 @@ Command::Impl::parse_args(vector<string> const& p_args)
                     (   "Option \"" + string(1, c) + "\" requires argument.\nAborted."
                     );
                 }
-                if (joined_arg_present) *opt.arg_target = string(chit + 1, arg_end);
-                else *opt.arg_target = *(++it);
+                if (joined_arg_present) opt.assign_argument(string(chit + 1, arg_end));
+                else opt.assign_argument(*(++it));
                 break;  // we've finished with this option-cluster
             }
         }
@@ -127,58 +127,76 @@ Config::filepath() const
     return m_filepath;
 }
 
+Config::Settings const&
+Config::settings() const
+{
+    return m_settings;
+}
+
 unsigned int
 Config::output_rounding_numerator() const
 {
-    return get_option_value<unsigned int>("output_rounding_numerator");
+    return m_settings.output_rounding_numerator;
 }
 
 unsigned int
 Config::output_rounding_denominator() const
 {
-    return get_option_value<unsigned int>("output_rounding_denominator");
+    return m_settings.output_rounding_denominator;
 }
 
 unsigned int
 Config::output_precision() const
 {
-    return get_option_value<unsigned int>("output_precision");
+    return m_settings.output_precision;
 }
 
 unsigned int
 Config::output_width() const
 {
-    return get_option_value<unsigned int>("output_width");
+    return m_settings.output_width;
 }
 
-string
+string const&
 Config::short_time_format() const
 {
-    return get_option_value<string>("short_format_string");
+    return m_settings.short_time_format;
 }
 
-string
+string const&
 Config::time_format() const
 {
-    return get_option_value<string>("format_string");
+    return m_settings.time_format;
 }
 
 unsigned int
 Config::formatted_buf_len() const
 {
-    return get_option_value<unsigned int>("formatted_buf_len");
+    return m_settings.formatted_buf_len;
 }
 
-string
+string const&
 Config::editor() const
 {
-    return get_option_value<string>("editor");
+    return m_settings.editor;
 }
 
-string
+string const&
 Config::path_to_log() const
 {
-    return get_option_value<string>("path_to_log");
+    return m_settings.path_to_log;
+}
+
+string const&
+Config::path_to_goals() const
+{
+    return m_settings.path_to_goals;
+}
+
+string const&
+Config::path_to_notes() const
+{
+    return m_settings.path_to_notes;
 }
 
 string
@@ -199,6 +217,7 @@ Config::Config(string const& p_filepath): m_filepath(p_filepath)
     if (!file_exists_at(m_filepath))
     {
         initialize_config_file();
+        parse_settings();
         return;
     }
     ifstream infile(m_filepath.c_str());
@@ -226,6 +245,7 @@ Config::Config(string const& p_filepath): m_filepath(p_filepath)
         }
         ++line_number;
     }
+    parse_settings();
 }
 
 Config::Config(Config const& rhs) = default;
@@ -352,6 +372,57 @@ Config::set_defaults()
             "Path to file in which time log is recorded."
         )
     );
+
+    unchecked_set_option
+    (   "path_to_goals",
+        OptionData
+        (   Info::home_dir() + "/.swx_goals",  // non-portable
+            "Path to file in which goals are set for the time spent on "
+            "activities, one per line, in the form \"ACTIVITY <= HOURSh/PERIOD\" "
+            "or \"ACTIVITY >= HOURSh/PERIOD\", where PERIOD is \"day\", "
+            "\"week\" or \"month\"."
+        )
+    );
+
+    unchecked_set_option
+    (   "path_to_notes",
+        OptionData
+        (   Info::home_dir() + "/.swx_notes",  // non-portable
+            "Path to file in which notes on stints are recorded."
+        )
+    );
+}
+
+void
+Config::parse_settings()
+{
+    Settings settings;
+    settings.output_rounding_numerator =
+        get_option_value<unsigned int>("output_rounding_numerator");
+    settings.output_rounding_denominator =
+        get_option_value<unsigned int>("output_rounding_denominator");
+    settings.output_precision = get_option_value<unsigned int>("output_precision");
+    settings.output_width = get_option_value<unsigned int>("output_width");
+    settings.short_time_format = get_option_value<string>("short_format_string");
+    settings.time_format = get_option_value<string>("format_string");
+    settings.formatted_buf_len = get_option_value<unsigned int>("formatted_buf_len");
+    settings.editor = get_option_value<string>("editor");
+    settings.path_to_log = get_option_value<string>("path_to_log");
+    settings.path_to_goals = get_option_value<string>("path_to_goals");
+    settings.path_to_notes = get_option_value<string>("path_to_notes");
+    if (settings.output_rounding_denominator == 0)
+    {
+        throw runtime_error
+        (   "Configuration key \"output_rounding_denominator\" must not be zero."
+        );
+    }
+    if (settings.formatted_buf_len == 0)
+    {
+        throw runtime_error
+        (   "Configuration key \"formatted_buf_len\" must not be zero."
+        );
+    }
+    m_settings = settings;
 }
 
 void
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "csv_bucket_report_writer.hpp"
+#include "bucket_report_writer.hpp"
+#include "csv_row.hpp"
+#include "stint.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using std::ostream;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+CsvBucketReportWriter::CsvBucketReportWriter
+(   vector<Stint> const& p_stints,
+    Options const& p_options,
+    Flags::Type p_flags
+):
+    BucketReportWriter(p_stints, p_options, p_flags)
+{
+}
+
+CsvBucketReportWriter::~CsvBucketReportWriter() = default;
+
+void
+CsvBucketReportWriter::do_write_matrix
+(   ostream& p_os,
+    vector<string> const& p_labels,
+    Rows const& p_rows
+)
+{
+    if (p_rows.empty()) return;
+    auto const succinct = has_flag(Flags::succinct);
+    auto const add_hours = [this, &p_labels](CsvRow& row, vector<unsigned long long> const& seconds)
+    {
+        for (size_t i = 0; i != p_labels.size(); ++i)
+        {
+            row << seconds_to_rounded_hours((i < seconds.size()) ? seconds[i] : 0);
+        }
+    };
+
+    CsvRow header;
+    if (!succinct) header << "activity";
+    for (auto const& label: p_labels) header << label;
+    p_os << header;
+
+    if (succinct)
+    {
+        vector<unsigned long long> totals(p_labels.size(), 0);
+        for (auto const& row: p_rows)
+        {
+            for (size_t i = 0; i != row.second.size(); ++i) totals[i] += row.second[i];
+        }
+        CsvRow row;
+        add_hours(row, totals);
+        p_os << row;
+    }
+    else
+    {
+        for (auto const& pair: p_rows)
+        {
+            CsvRow row;
+            row << pair.first;
+            add_hours(row, pair.second);
+            p_os << row;
+        }
+    }
+}
+
+}  // namespace swx
@@ -21,10 +21,12 @@
 #include "time_point.hpp"
 #include <iomanip>
 #include <ostream>
+#include <string>
 #include <vector>
 
 using std::setprecision;
 using std::ostream;
+using std::string;
 using std::vector;
 
 namespace swx
@@ -53,6 +55,17 @@ CsvListReportWriter::do_process_stint(ostream& p_os, Stint const& p_stint)
             << time_point_to_stamp(interval.ending(), time_format(), formatted_buf_len())
             << round_hours(interval)
             << p_stint.activity();
+        if (shows_notes())
+        {
+            // The notes on the stint share a single column.
+            string joined_notes;
+            for (auto const& note: notes(interval))
+            {
+                if (!joined_notes.empty()) joined_notes += "; ";
+                joined_notes += note;
+            }
+            row << joined_notes;
+        }
         p_os << row;
     }
 }
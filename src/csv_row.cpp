@@ -16,12 +16,19 @@
 
 #include "csv_row.hpp"
 #include <iostream>
+#include <istream>
 #include <ostream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
+using std::getline;
+using std::istream;
 using std::ostream;
 using std::endl;
+using std::runtime_error;
 using std::string;
+using std::vector;
 
 namespace swx
 {
@@ -68,4 +75,65 @@ operator<<(ostream& p_os, CsvRow const& p_csv_row)
     return p_os << p_csv_row.str() << endl;
 }
 
+bool
+read_csv_row(istream& p_is, vector<string>& p_cells)
+{
+    p_cells.clear();
+    string line;
+    if (!getline(p_is, line))
+    {
+        return false;
+    }
+    string cell;
+    bool quoted = false;
+    while (true)
+    {
+        for (string::size_type i = 0; i != line.size(); ++i)
+        {
+            auto const c = line[i];
+            if (quoted)
+            {
+                if (c != '"')
+                {
+                    cell.push_back(c);
+                }
+                else if ((i + 1 != line.size()) && (line[i + 1] == '"'))
+                {
+                    cell.push_back(c);
+                    ++i;
+                }
+                else
+                {
+                    quoted = false;
+                }
+            }
+            else if (c == '"')
+            {
+                quoted = true;
+            }
+            else if (c == ',')
+            {
+                p_cells.push_back(cell);
+                cell.clear();
+            }
+            else if (c != '\r')
+            {
+                cell.push_back(c);
+            }
+        }
+        if (!quoted)
+        {
+            break;
+        }
+        // the quoted cell continues on the next line
+        if (!getline(p_is, line))
+        {
+            throw runtime_error("Unterminated quote in CSV input.");
+        }
+        cell.push_back('\n');
+    }
+    p_cells.push_back(cell);
+    return true;
+}
+
 }  // namespace swx
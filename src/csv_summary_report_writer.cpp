@@ -17,16 +17,21 @@
 #include "csv_summary_report_writer.hpp"
 #include "activity_stats.hpp"
 #include "csv_row.hpp"
+#include "duration_sketch.hpp"
 #include "stint.hpp"
 #include "summary_report_writer.hpp"
 #include "time_point.hpp"
+#include <cstddef>
 #include <map>
 #include <ostream>
+#include <set>
 #include <string>
 #include <vector>
 
 using std::map;
 using std::ostream;
+using std::set;
+using std::size_t;
 using std::string;
 using std::vector;
 
@@ -61,6 +66,22 @@ CsvSummaryReportWriter::do_write_summary
         {
             row << time_point_to_stamp(info.ending, time_format(), formatted_buf_len());
         }
+        if (has_flag(Flags::durations))
+        {
+            auto const& durations = info.durations;
+            auto const to_rounded_hours = [this](double p_seconds)
+            {
+                return seconds_to_rounded_hours
+                (   static_cast<unsigned long long>(p_seconds + 0.5)
+                );
+            };
+            row << durations.count()
+                << to_rounded_hours(durations.mean())
+                << to_rounded_hours(durations.quantile(0.5))
+                << to_rounded_hours(durations.quantile(0.9))
+                << to_rounded_hours(durations.quantile(0.99))
+                << seconds_to_rounded_hours(durations.max());
+        }
     };
 
     if (has_flag(Flags::succinct))
@@ -85,4 +106,64 @@ CsvSummaryReportWriter::do_write_summary
     }
 }
 
+void
+CsvSummaryReportWriter::do_write_comparison
+(   ostream& p_os,
+    vector<map<string, ActivityStats>> const& p_activity_stats_maps
+)
+{
+    auto const succinct = has_flag(Flags::succinct);
+    auto const add_values = [this](CsvRow& row, vector<unsigned long long> const& seconds)
+    {
+        auto const hours = seconds_to_rounded_hours(seconds[0]);
+        row << hours;
+        for (size_t i = 1; i != seconds.size(); ++i)
+        {
+            auto const other_hours = seconds_to_rounded_hours(seconds[i]);
+            row << other_hours << (hours - other_hours);
+        }
+    };
+
+    CsvRow header;
+    if (!succinct) header << "activity";
+    header << describe_period(0);
+    for (size_t i = 1; i != p_activity_stats_maps.size(); ++i)
+    {
+        auto const description = describe_period(i);
+        header << description << ("change from " + description);
+    }
+    p_os << header;
+
+    set<string> activities;
+    for (auto const& stats_map: p_activity_stats_maps)
+    {
+        for (auto const& pair: stats_map) activities.insert(pair.first);
+    }
+    vector<unsigned long long> totals(p_activity_stats_maps.size(), 0);
+    for (auto const& activity: activities)
+    {
+        vector<unsigned long long> seconds;
+        for (size_t i = 0; i != p_activity_stats_maps.size(); ++i)
+        {
+            auto const& stats_map = p_activity_stats_maps[i];
+            auto const it = stats_map.find(activity);
+            seconds.push_back((it == stats_map.end()) ? 0 : it->second.seconds);
+            totals[i] += seconds.back();
+        }
+        if (!succinct)
+        {
+            CsvRow row;
+            row << activity;
+            add_values(row, seconds);
+            p_os << row;
+        }
+    }
+    if (succinct)
+    {
+        CsvRow row;
+        add_values(row, totals);
+        p_os << row;
+    }
+}
+
 }  // namespace swx
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "delete_command.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "help_line.hpp"
+#include "recording_command.hpp"
+#include "result.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::ostream;
+using std::runtime_error;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+DeleteCommand::DeleteCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    RecordingCommand
+    (   p_command_word,
+        p_aliases,
+        "Delete a switch at an earlier time",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Delete the entry at exactly the time given by --at, so "
+                    "that the stint before it runs on in its place"
+            )
+        },
+        false,
+        p_time_log
+    )
+{
+    add_option
+    (   vector<string>{"at"},
+        HelpLine
+        (   "Delete the entry at the time indicated by TIMESTAMP (required)",
+            "<TIMESTAMP>"
+        ),
+        nullptr,
+        &m_time_stamp
+    );
+}
+
+DeleteCommand::~DeleteCommand() = default;
+
+Command::ErrorMessages
+DeleteCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    (void)p_ordinary_args;  // silence compiler re. unused param.
+    if (m_time_stamp.empty())
+    {
+        return {"The time of the entry must be given with --at."};
+    }
+    auto const tp_result = time_point
+    (   m_time_stamp,
+        p_config.time_format(),
+        p_config.short_time_format()
+    );
+    if (!tp_result.errors().empty())
+    {
+        return tp_result.errors();
+    }
+    auto const tp = tp_result.get();
+    string deleted_activity;
+    try
+    {
+        deleted_activity = time_log().delete_entry(tp);
+    }
+    catch (runtime_error& e)
+    {
+        return {e.what()};
+    }
+    auto const confirmed_stamp = time_point_to_stamp
+    (   tp,
+        p_config.time_format(),
+        p_config.formatted_buf_len()
+    );
+    if (deleted_activity.empty())
+    {
+        p_ordinary_ostream << "Deleted the cessation of activity at " << confirmed_stamp;
+    }
+    else
+    {
+        p_ordinary_ostream << "Deleted the switch to \"" << deleted_activity
+                           << "\" at " << confirmed_stamp;
+    }
+    p_ordinary_ostream << '.' << endl;
+    return {};
+}
+
+}  // namespace swx
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "duration_sketch.hpp"
+#include "arithmetic.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using std::ceil;
+using std::log;
+using std::min;
+using std::pow;
+using std::runtime_error;
+using std::size_t;
+using std::vector;
+
+namespace swx
+{
+
+double const DurationSketch::k_relative_accuracy = 0.01;
+
+namespace
+{
+    // Bucket i holds durations in (gamma^(i - 1), gamma^i], where gamma is
+    // (1 + a) / (1 - a) for relative accuracy a. Reporting each bucket by
+    // 2 gamma^i / (gamma + 1) is then within a of any duration in it.
+    double const k_gamma =
+        (1.0 + DurationSketch::k_relative_accuracy) /
+        (1.0 - DurationSketch::k_relative_accuracy);
+
+    double const k_log_gamma = log(k_gamma);
+
+    int bucket_index(unsigned long long p_seconds)
+    {
+        assert (p_seconds > 0);
+        return static_cast<int>(ceil(log(static_cast<double>(p_seconds)) / k_log_gamma));
+    }
+
+    double bucket_value(int p_index)
+    {
+        return 2.0 * pow(k_gamma, p_index) / (k_gamma + 1.0);
+    }
+
+}  // end anonymous namespace
+
+void
+DurationSketch::add(unsigned long long p_seconds)
+{
+    if (!addition_is_safe(m_total, p_seconds))
+    {
+        throw runtime_error("Cannot safely sum durations of stints.");
+    }
+    m_min = (m_count == 0) ? p_seconds : min(m_min, p_seconds);
+    m_max = std::max(m_max, p_seconds);
+    ++m_count;
+    m_total += p_seconds;
+    if (p_seconds == 0)
+    {
+        ++m_zero_count;
+        return;
+    }
+    auto const index = bucket_index(p_seconds);
+    if (m_buckets.empty())
+    {
+        m_first_index = index;
+        m_buckets.push_back(0);
+    }
+    else if (index < m_first_index)
+    {
+        m_buckets.insert(m_buckets.begin(), m_first_index - index, 0);
+        m_first_index = index;
+    }
+    else if (index - m_first_index >= static_cast<int>(m_buckets.size()))
+    {
+        m_buckets.resize(index - m_first_index + 1, 0);
+    }
+    ++m_buckets[index - m_first_index];
+}
+
+unsigned long long
+DurationSketch::count() const
+{
+    return m_count;
+}
+
+unsigned long long
+DurationSketch::total() const
+{
+    return m_total;
+}
+
+double
+DurationSketch::mean() const
+{
+    if (m_count == 0) return 0.0;
+    return static_cast<double>(m_total) / m_count;
+}
+
+unsigned long long
+DurationSketch::max() const
+{
+    return m_max;
+}
+
+double
+DurationSketch::quantile(double p_quantile) const
+{
+    if (m_count == 0) return 0.0;
+    if (p_quantile <= 0.0) return static_cast<double>(m_min);
+    if (p_quantile >= 1.0) return static_cast<double>(m_max);
+    auto const rank = static_cast<unsigned long long>(p_quantile * (m_count - 1));
+    if (rank < m_zero_count) return 0.0;
+    auto seen = m_zero_count;
+    for (size_t i = 0; i != m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i];
+        if (seen > rank)
+        {
+            // The estimate for the bucket may lie outside the durations
+            // actually added.
+            auto const value = bucket_value(m_first_index + static_cast<int>(i));
+            return min(std::max(value, static_cast<double>(m_min)), static_cast<double>(m_max));
+        }
+    }
+    assert (false);
+    return static_cast<double>(m_max);
+}
+
+DurationSketch&
+DurationSketch::operator+=(DurationSketch const& rhs)
+{
+    if (rhs.m_count == 0) return *this;
+    if (m_count == 0) return *this = rhs;
+    if (!addition_is_safe(m_total, rhs.m_total))
+    {
+        throw runtime_error("Cannot safely sum durations of stints.");
+    }
+    m_min = min(m_min, rhs.m_min);
+    m_max = std::max(m_max, rhs.m_max);
+    m_count += rhs.m_count;
+    m_total += rhs.m_total;
+    m_zero_count += rhs.m_zero_count;
+    if (rhs.m_buckets.empty()) return *this;
+    if (m_buckets.empty())
+    {
+        m_first_index = rhs.m_first_index;
+        m_buckets = rhs.m_buckets;
+        return *this;
+    }
+    if (rhs.m_first_index < m_first_index)
+    {
+        m_buckets.insert(m_buckets.begin(), m_first_index - rhs.m_first_index, 0);
+        m_first_index = rhs.m_first_index;
+    }
+    auto const offset = rhs.m_first_index - m_first_index;
+    auto const needed = offset + rhs.m_buckets.size();
+    if (needed > m_buckets.size()) m_buckets.resize(needed, 0);
+    for (size_t i = 0; i != rhs.m_buckets.size(); ++i)
+    {
+        m_buckets[offset + i] += rhs.m_buckets[i];
+    }
+    return *this;
+}
+
+}  // namespace swx
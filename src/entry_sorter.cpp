@@ -0,0 +1,334 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "entry_sorter.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::FILE;
+using std::fclose;
+using std::fflush;
+using std::fread;
+using std::fwrite;
+using std::make_heap;
+using std::move;
+using std::pop_heap;
+using std::push_heap;
+using std::rewind;
+using std::runtime_error;
+using std::size_t;
+using std::sort;
+using std::string;
+using std::tmpfile;
+using std::uint32_t;
+using std::unique_ptr;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+
+namespace
+{
+    // Orders runs such that a heap of them has at its top the run whose
+    // current record comes first.
+    struct LaterRun
+    {
+        template <typename RunT>
+        bool operator()(RunT const* p_lhs, RunT const* p_rhs) const
+        {
+            return p_rhs->current() < p_lhs->current();
+        }
+    };
+
+}  // end anonymous namespace
+
+// A sorted sequence of Records spilled to a temporary file, which is
+// deleted automatically when closed.
+class EntrySorter::Run
+{
+public:
+    Run();
+    Run(Run const&) = delete;
+    Run(Run&&) = delete;
+    Run& operator=(Run const&) = delete;
+    Run& operator=(Run&&) = delete;
+    ~Run();
+    void write(Record const& p_record);
+    void start_reading();
+    bool advance();
+    Record const& current() const;
+    Record& current();
+private:
+    void write_raw(void const* p_data, size_t p_size);
+    bool read_raw(void* p_data, size_t p_size);
+    FILE* m_file;
+    Record m_current;
+};
+
+bool
+EntrySorter::Record::operator<(Record const& rhs) const
+{
+    if (seconds != rhs.seconds) return seconds < rhs.seconds;
+    if (provisional != rhs.provisional) return rhs.provisional;
+    return sequence < rhs.sequence;
+}
+
+EntrySorter::EntrySorter(size_t p_max_buffered_bytes):
+    m_max_buffered_bytes(p_max_buffered_bytes)
+{
+}
+
+EntrySorter::~EntrySorter() = default;
+
+void
+EntrySorter::add
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    string const& p_tags,
+    bool p_provisional
+)
+{
+    assert (!m_reading);
+    auto const seconds =
+        chrono::duration_cast<chrono::seconds>(p_time_point.time_since_epoch()).count();
+    m_buffer.push_back
+    (   Record{seconds, m_next_sequence++, p_provisional, p_activity, p_tags}
+    );
+    m_buffered_bytes += sizeof(Record) + p_activity.size() + p_tags.size();
+    if (m_buffered_bytes >= m_max_buffered_bytes)
+    {
+        spill();
+    }
+}
+
+bool
+EntrySorter::next
+(   string& p_activity,
+    TimePoint& p_time_point,
+    string& p_tags,
+    bool& p_provisional
+)
+{
+    if (!m_reading)
+    {
+        start_reading();
+    }
+    Record record;
+    while (next_record(record))
+    {
+        if (record.provisional && m_has_last_time && (record.seconds == m_last_time))
+        {
+            continue;
+        }
+        m_has_last_time = true;
+        m_last_time = record.seconds;
+        p_activity = move(record.activity);
+        p_tags = move(record.tags);
+        p_time_point = TimePoint(chrono::seconds(record.seconds));
+        p_provisional = record.provisional;
+        return true;
+    }
+    return false;
+}
+
+size_t
+EntrySorter::num_runs() const
+{
+    return m_runs.size();
+}
+
+void
+EntrySorter::spill()
+{
+    if (m_buffer.empty())
+    {
+        return;
+    }
+    sort(m_buffer.begin(), m_buffer.end());
+    unique_ptr<Run> run(new Run);
+    for (auto const& record: m_buffer) run->write(record);
+    m_runs.push_back(move(run));
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_buffered_bytes = 0;
+}
+
+void
+EntrySorter::start_reading()
+{
+    assert (!m_reading);
+    m_reading = true;
+    if (m_runs.empty())
+    {
+        // Everything fits in memory, so there is no need to touch the disk.
+        sort(m_buffer.begin(), m_buffer.end());
+        m_buffer_position = 0;
+        return;
+    }
+    spill();
+    for (auto const& run: m_runs)
+    {
+        run->start_reading();
+        if (run->advance()) m_heap.push_back(run.get());
+    }
+    make_heap(m_heap.begin(), m_heap.end(), LaterRun());
+}
+
+bool
+EntrySorter::next_record(Record& p_record)
+{
+    if (m_runs.empty())
+    {
+        if (m_buffer_position == m_buffer.size())
+        {
+            return false;
+        }
+        p_record = move(m_buffer[m_buffer_position++]);
+        return true;
+    }
+    if (m_heap.empty())
+    {
+        return false;
+    }
+    LaterRun const comp;
+    pop_heap(m_heap.begin(), m_heap.end(), comp);
+    auto const run = m_heap.back();
+    p_record = move(run->current());
+    if (run->advance())
+    {
+        push_heap(m_heap.begin(), m_heap.end(), comp);
+    }
+    else
+    {
+        m_heap.pop_back();
+    }
+    return true;
+}
+
+EntrySorter::Run::Run(): m_file(tmpfile())
+{
+    if (!m_file)
+    {
+        throw runtime_error("Error opening temp file.");
+    }
+}
+
+EntrySorter::Run::~Run()
+{
+    fclose(m_file);
+}
+
+void
+EntrySorter::Run::write(Record const& p_record)
+{
+    auto const activity_size = static_cast<uint32_t>(p_record.activity.size());
+    auto const tags_size = static_cast<uint32_t>(p_record.tags.size());
+    unsigned char const provisional = (p_record.provisional ? 1 : 0);
+    write_raw(&p_record.seconds, sizeof(p_record.seconds));
+    write_raw(&p_record.sequence, sizeof(p_record.sequence));
+    write_raw(&provisional, sizeof(provisional));
+    write_raw(&activity_size, sizeof(activity_size));
+    write_raw(p_record.activity.data(), activity_size);
+    write_raw(&tags_size, sizeof(tags_size));
+    write_raw(p_record.tags.data(), tags_size);
+}
+
+void
+EntrySorter::Run::start_reading()
+{
+    if (fflush(m_file) != 0)
+    {
+        throw runtime_error("Error writing to temp file.");
+    }
+    rewind(m_file);
+}
+
+bool
+EntrySorter::Run::advance()
+{
+    if (!read_raw(&m_current.seconds, sizeof(m_current.seconds)))
+    {
+        return false;
+    }
+    unsigned char provisional = 0;
+    uint32_t activity_size = 0;
+    if
+    (   !read_raw(&m_current.sequence, sizeof(m_current.sequence)) ||
+        !read_raw(&provisional, sizeof(provisional)) ||
+        !read_raw(&activity_size, sizeof(activity_size))
+    )
+    {
+        throw runtime_error("Error reading from temp file.");
+    }
+    m_current.provisional = (provisional != 0);
+    m_current.activity.resize(activity_size);
+    uint32_t tags_size = 0;
+    if
+    (   ((activity_size != 0) && !read_raw(&m_current.activity[0], activity_size)) ||
+        !read_raw(&tags_size, sizeof(tags_size))
+    )
+    {
+        throw runtime_error("Error reading from temp file.");
+    }
+    m_current.tags.resize(tags_size);
+    if ((tags_size != 0) && !read_raw(&m_current.tags[0], tags_size))
+    {
+        throw runtime_error("Error reading from temp file.");
+    }
+    return true;
+}
+
+EntrySorter::Record const&
+EntrySorter::Run::current() const
+{
+    return m_current;
+}
+
+EntrySorter::Record&
+EntrySorter::Run::current()
+{
+    return m_current;
+}
+
+void
+EntrySorter::Run::write_raw(void const* p_data, size_t p_size)
+{
+    if (fwrite(p_data, 1, p_size, m_file) != p_size)
+    {
+        throw runtime_error("Error writing to temp file.");
+    }
+}
+
+bool
+EntrySorter::Run::read_raw(void* p_data, size_t p_size)
+{
+    return fread(p_data, 1, p_size, m_file) == p_size;
+}
+
+}  // namespace swx
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "export_command.hpp"
+#include "activity_filter.hpp"
+#include "columnar_writer.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "help_line.hpp"
+#include "placeholder.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::ios;
+using std::ofstream;
+using std::ostream;
+using std::runtime_error;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+ExportCommand::ExportCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Export stints in a binary format for analytics tools",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Write all stints of activity to standard output in the columnar "
+                    "binary format described in the README"
+            ),
+            HelpLine
+            (   "Write only the stints of ACTIVITY and its descendant activities",
+                "<ACTIVITY>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"format"},
+        HelpLine("Write the stints in FORMAT (only \"columnar\" is supported)", "<FORMAT>"),
+        nullptr,
+        &m_format_str
+    );
+    add_option
+    (   vector<string>{"o", "output"},
+        HelpLine("Write to FILE rather than to standard output", "<FILE>"),
+        nullptr,
+        &m_output_filepath
+    );
+    add_option
+    (   vector<string>{"f", "from"},
+        HelpLine("Only export time spent on activities since TIMESTAMP", "<TIMESTAMP>"),
+        nullptr,
+        &m_since_str
+    );
+    add_option
+    (   vector<string>{"t", "to"},
+        HelpLine("Only export time spent on activities until TIMESTAMP", "<TIMESTAMP>"),
+        nullptr,
+        &m_until_str
+    );
+}
+
+ExportCommand::~ExportCommand() = default;
+
+bool
+ExportCommand::does_support_placeholders() const
+{
+    return true;
+}
+
+Command::ErrorMessages
+ExportCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    ErrorMessages ret;
+    if (m_format_str != "columnar")
+    {
+        ret.push_back("Unsupported export format: " + m_format_str);
+    }
+    unique_ptr<TimePoint> since_time_point_ptr;
+    unique_ptr<TimePoint> until_time_point_ptr;
+    auto const long_time_fmt = p_config.time_format();
+    auto const short_time_fmt = p_config.short_time_format();
+    if (!m_since_str.empty())
+    {
+        try
+        {
+            since_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_since_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_since_str);
+        }
+    }
+    if (!m_until_str.empty())
+    {
+        try
+        {
+            until_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_until_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_until_str);
+        }
+    }
+    if (!ret.empty())
+    {
+        return ret;
+    }
+
+    string comparitor;
+    auto filter_type = ActivityFilter::Type::always_true;
+    if (!p_ordinary_args.empty())
+    {
+        comparitor = expand_placeholders(p_ordinary_args, m_time_log);
+        filter_type = ActivityFilter::Type::ordinary;
+    }
+    unique_ptr<ActivityFilter> const
+        filter(ActivityFilter::create(comparitor, filter_type));
+    auto const stints = m_time_log.get_stints
+    (   *filter,
+        since_time_point_ptr.get(),
+        until_time_point_ptr.get()
+    );
+    ColumnarWriter const writer(stints);
+    if (m_output_filepath.empty())
+    {
+        writer.write(p_ordinary_ostream);
+    }
+    else
+    {
+        ofstream ofs(m_output_filepath.c_str(), ios::out | ios::binary | ios::trunc);
+        if (!ofs)
+        {
+            ret.push_back("Could not open file for writing: " + m_output_filepath);
+            return ret;
+        }
+        writer.write(ofs);
+    }
+    return ret;
+}
+
+}  // namespace swx
@@ -15,11 +15,20 @@
  */
 
 #include "file_utilities.hpp"
+#include <algorithm>
 #include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdexcept>
 #include <string>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <vector>
 
+using std::runtime_error;
+using std::sort;
 using std::string;
+using std::vector;
 
 namespace swx
 {
@@ -33,4 +42,86 @@ file_exists_at(string const& p_filepath)
         (errno != ENOENT);
 }
 
+bool
+operator==(FileStatus const& lhs, FileStatus const& rhs)
+{
+    return
+        (lhs.inode == rhs.inode) &&
+        (lhs.size == rhs.size) &&
+        (lhs.modification_nanoseconds == rhs.modification_nanoseconds);
+}
+
+bool
+operator!=(FileStatus const& lhs, FileStatus const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+bool
+get_file_status(string const& p_filepath, FileStatus& p_status)
+{
+    // non-portable
+    struct stat st;
+    if ((stat(p_filepath.c_str(), &st) != 0) || !S_ISREG(st.st_mode))
+    {
+        return false;
+    }
+    p_status.inode = st.st_ino;
+    p_status.size = st.st_size;
+    p_status.modification_nanoseconds =
+        static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    return true;
+}
+
+vector<string>
+directory_entries(string const& p_dirpath)
+{
+    // non-portable
+    DIR* const dir = opendir(p_dirpath.c_str());
+    if (dir == nullptr)
+    {
+        throw runtime_error("Could not read directory: " + p_dirpath);
+    }
+    vector<string> ret;
+    while (dirent const* const entry = readdir(dir))
+    {
+        string const name(entry->d_name);
+        if ((name != ".") && (name != "..")) ret.push_back(name);
+    }
+    closedir(dir);
+    sort(ret.begin(), ret.end());
+    return ret;
+}
+
+void
+append_to_file(string const& p_filepath, string const& p_contents)
+{
+    // non-portable
+    int const fd = open(p_filepath.c_str(), O_WRONLY | O_APPEND);
+    if (fd < 0)
+    {
+        throw runtime_error("Could not open file for writing: " + p_filepath);
+    }
+    char const* data = p_contents.data();
+    auto remaining = p_contents.size();
+    while (remaining != 0)
+    {
+        auto const written = write(fd, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            close(fd);
+            throw runtime_error("Could not write to file: " + p_filepath);
+        }
+        data += written;
+        remaining -= static_cast<decltype(remaining)>(written);
+    }
+    if (fsync(fd) != 0)
+    {
+        close(fd);
+        throw runtime_error("Could not write to file: " + p_filepath);
+    }
+    close(fd);
+}
+
 }  // namespace swx
@@ -0,0 +1,367 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "goal_tracker.hpp"
+#include "activity_filter.hpp"
+#include "atomic_writer.hpp"
+#include "file_utilities.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "stream_utilities.hpp"
+#include "string_utilities.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::chrono::duration_cast;
+using std::getline;
+using std::ifstream;
+using std::istringstream;
+using std::llround;
+using std::max;
+using std::min;
+using std::ostringstream;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::to_string;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    long long to_seconds(TimePoint const& p_time_point)
+    {
+        return duration_cast<std::chrono::seconds>(p_time_point.time_since_epoch()).count();
+    }
+
+    TimePoint from_seconds(long long p_seconds)
+    {
+        return TimePoint(std::chrono::seconds(p_seconds));
+    }
+
+    string file_status_to_string(FileStatus const& p_status)
+    {
+        return to_string(p_status.inode) + ' ' + to_string(p_status.size) + ' ' +
+            to_string(p_status.modification_nanoseconds);
+    }
+
+    // Reads a line of the state file, consisting of p_tag followed by
+    // further fields, into p_iss, positioned after the tag.
+    bool read_state_line(ifstream& p_ifs, string const& p_tag, istringstream& p_iss)
+    {
+        string line;
+        if (!getline(p_ifs, line)) return false;
+        p_iss.clear();
+        p_iss.str(line);
+        string tag;
+        return (p_iss >> tag) && (tag == p_tag);
+    }
+
+}  // end anonymous namespace
+
+bool
+GoalTracker::Status::is_crossed() const
+{
+    assert (goal);
+    return goal->is_maximum ? (seconds > goal->seconds) : (seconds >= goal->seconds);
+}
+
+GoalTracker::GoalTracker
+(   string const& p_goals_filepath,
+    string const& p_log_filepath,
+    TimeLog& p_time_log
+):
+    m_goals_filepath(p_goals_filepath),
+    m_state_filepath(p_goals_filepath + ".state"),
+    m_log_filepath(p_log_filepath),
+    m_time_log(p_time_log)
+{
+    if (!get_file_status(m_goals_filepath, m_goals_status)) return;
+    parse_goals();
+    if (!m_goals.empty()) m_is_state_valid = load_state();
+}
+
+GoalTracker::~GoalTracker() = default;
+
+vector<GoalTracker::Goal> const&
+GoalTracker::goals() const
+{
+    return m_goals;
+}
+
+void
+GoalTracker::update(TimePoint const& p_now)
+{
+    if (m_goals.empty()) return;
+    auto const last = m_time_log.last_entry_time();
+    auto const has_entries = (last != TimePoint::min());
+    unique_ptr<ActivityFilter> const
+        all(ActivityFilter::create(string(), ActivityFilter::Type::always_true));
+    if (!m_is_state_valid)
+    {
+        reset_totals(p_now);
+        if (has_entries && (last < m_checkpoint)) m_checkpoint = last;
+    }
+    else if (has_entries && (last < m_checkpoint))
+    {
+        // The last entry has been amended to an earlier time, so the time
+        // from it to the checkpoint, which was counted towards the stint
+        // before it, must be taken back.
+        auto const previous = m_time_log.last_entry_time(1);
+        if (previous != TimePoint::min())
+        {
+            auto const stints = m_time_log.get_stints(*all, &previous, &last);
+            if (!stints.empty())
+            {
+                count(stints.back().activity(), last, m_checkpoint, p_now, -1);
+            }
+        }
+        m_checkpoint = last;
+    }
+    if (has_entries && (last > m_checkpoint))
+    {
+        // Only the stints closed since the checkpoint are counted.
+        auto const stints = m_time_log.get_stints(*all, &m_checkpoint, &last);
+        for (auto const& stint: stints)
+        {
+            auto const interval = stint.interval();
+            count(stint.activity(), interval.beginning(), interval.ending(), p_now);
+        }
+        m_checkpoint = last;
+    }
+    save_state();
+    m_is_state_valid = true;
+}
+
+vector<GoalTracker::Status>
+GoalTracker::statuses(TimePoint const& p_now)
+{
+    assert (m_totals.size() == m_goals.size());
+    vector<Status> ret;
+    auto const is_active = m_time_log.is_active();
+    auto const current_activity =
+        (is_active ? m_time_log.last_activities(1).front() : string());
+    auto const last = m_time_log.last_entry_time();
+    for (size_t i = 0; i != m_goals.size(); ++i)
+    {
+        Status status;
+        status.goal = &m_goals[i];
+        status.period_beginning = period_beginning(i, p_now);
+        if (m_totals[i].period_beginning == status.period_beginning)
+        {
+            status.seconds = m_totals[i].seconds;
+        }
+        if (is_active && m_filters[i]->matches(current_activity))
+        {
+            auto const beginning = max(last, status.period_beginning);
+            if (p_now > beginning)
+            {
+                status.seconds += duration_cast<Seconds>(p_now - beginning).count();
+            }
+        }
+        ret.push_back(status);
+    }
+    return ret;
+}
+
+void
+GoalTracker::parse_goals()
+{
+    ifstream infile(m_goals_filepath.c_str());
+    if (!infile)
+    {
+        throw runtime_error("Could not open goals file at " + m_goals_filepath);
+    }
+    string line;
+    size_t line_number = 0;
+    while (getline(infile, line))
+    {
+        ++line_number;
+        auto const squashed = squash(line);
+        if (squashed.empty() || (squashed[0] == '#')) continue;
+        auto const error_message =
+            "Could not parse goal on line " + to_string(line_number) + " of " +
+            m_goals_filepath + ": " + squashed;
+        auto const words = split(squashed);
+        if (words.size() < 3) throw runtime_error(error_message);
+        auto const& comparison = words[words.size() - 2];
+        auto const& target = words.back();
+        Goal goal;
+        goal.activity = squish(words.begin(), words.end() - 2);
+        if (comparison == "<=") goal.is_maximum = true;
+        else if (comparison == ">=") goal.is_maximum = false;
+        else throw runtime_error(error_message);
+        auto const separator_pos = target.find("h/");
+        if (separator_pos == string::npos) throw runtime_error(error_message);
+        istringstream iss(target.substr(0, separator_pos));
+        double hours = 0.0;
+        if (!(iss >> hours) || !iss.eof() || (hours < 0.0))
+        {
+            throw runtime_error(error_message);
+        }
+        goal.seconds = static_cast<unsigned long long>(llround(hours * 60.0 * 60.0));
+        auto const period = target.substr(separator_pos + 2);
+        if (period == "day") goal.period = Period::day;
+        else if (period == "week") goal.period = Period::week;
+        else if (period == "month") goal.period = Period::month;
+        else throw runtime_error(error_message);
+        goal.description = squashed;
+        m_filters.emplace_back
+        (   ActivityFilter::create(goal.activity, ActivityFilter::Type::ordinary)
+        );
+        m_goals.push_back(goal);
+    }
+}
+
+bool
+GoalTracker::load_state()
+{
+    ifstream infile(m_state_filepath.c_str());
+    if (!infile) return false;
+    istringstream iss;
+    FileStatus log_status;
+    if (!read_state_line(infile, "log", iss)) return false;
+    if (!(iss >> log_status.inode >> log_status.size >> log_status.modification_nanoseconds))
+    {
+        return false;
+    }
+    FileStatus current_log_status;
+    get_file_status(m_log_filepath, current_log_status);
+    if (log_status != current_log_status) return false;
+
+    FileStatus goals_status;
+    if (!read_state_line(infile, "goals", iss)) return false;
+    if (!(iss >> goals_status.inode >> goals_status.size >> goals_status.modification_nanoseconds))
+    {
+        return false;
+    }
+    if (goals_status != m_goals_status) return false;
+
+    long long checkpoint = 0;
+    if (!read_state_line(infile, "checkpoint", iss) || !(iss >> checkpoint)) return false;
+    m_checkpoint = from_seconds(checkpoint);
+
+    vector<Total> totals;
+    for (size_t i = 0; i != m_goals.size(); ++i)
+    {
+        long long period_beginning = 0;
+        Total total;
+        if (!read_state_line(infile, "total", iss) || !(iss >> period_beginning >> total.seconds))
+        {
+            return false;
+        }
+        total.period_beginning = from_seconds(period_beginning);
+        totals.push_back(total);
+    }
+    m_totals = totals;
+    return true;
+}
+
+void
+GoalTracker::save_state()
+{
+    // The time log as it stands now is the one the totals reflect.
+    FileStatus log_status;
+    get_file_status(m_log_filepath, log_status);
+    ostringstream oss;
+    enable_exceptions(oss);
+    oss << "log " << file_status_to_string(log_status) << '\n'
+        << "goals " << file_status_to_string(m_goals_status) << '\n'
+        << "checkpoint " << to_seconds(m_checkpoint) << '\n';
+    for (auto const& total: m_totals)
+    {
+        oss << "total " << to_seconds(total.period_beginning) << ' '
+            << total.seconds << '\n';
+    }
+    AtomicWriter writer(m_state_filepath);
+    writer.append(oss.str());
+    writer.commit();
+}
+
+void
+GoalTracker::reset_totals(TimePoint const& p_now)
+{
+    m_totals.assign(m_goals.size(), Total());
+    m_checkpoint = p_now;
+    for (size_t i = 0; i != m_goals.size(); ++i)
+    {
+        m_totals[i].period_beginning = period_beginning(i, p_now);
+        m_checkpoint = min(m_checkpoint, m_totals[i].period_beginning);
+    }
+}
+
+void
+GoalTracker::count
+(   string const& p_activity,
+    TimePoint const& p_beginning,
+    TimePoint const& p_ending,
+    TimePoint const& p_now,
+    int p_sign
+)
+{
+    if (p_activity.empty()) return;
+    for (size_t i = 0; i != m_goals.size(); ++i)
+    {
+        if (!m_filters[i]->matches(p_activity)) continue;
+        auto& total = m_totals[i];
+        auto const current_period_beginning = period_beginning(i, p_now);
+        if (total.period_beginning != current_period_beginning)
+        {
+            // A new period has begun since the total was last counted.
+            total.period_beginning = current_period_beginning;
+            total.seconds = 0;
+        }
+        auto const beginning = max(p_beginning, total.period_beginning);
+        if (p_ending <= beginning) continue;
+        unsigned long long const seconds =
+            duration_cast<Seconds>(p_ending - beginning).count();
+        if (p_sign > 0) total.seconds += seconds;
+        else total.seconds -= min(seconds, total.seconds);
+    }
+}
+
+TimePoint
+GoalTracker::period_beginning(size_t p_index, TimePoint const& p_now) const
+{
+    switch (m_goals[p_index].period)
+    {
+    case Period::day:
+        return day_begin(p_now);
+    case Period::week:
+        return week_begin(p_now);
+    case Period::month:
+        return month_begin(p_now);
+    }
+    assert (false);
+    return day_begin(p_now);
+}
+
+}  // namespace swx
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "goals_command.hpp"
+#include "arithmetic.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "csv_row.hpp"
+#include "goal_tracker.hpp"
+#include "help_line.hpp"
+#include "stream_flag_guard.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::max;
+using std::ostream;
+using std::right;
+using std::runtime_error;
+using std::setprecision;
+using std::setw;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    string period_name(GoalTracker::Period p_period)
+    {
+        switch (p_period)
+        {
+        case GoalTracker::Period::day:
+            return "day";
+        case GoalTracker::Period::week:
+            return "week";
+        case GoalTracker::Period::month:
+            return "month";
+        }
+        return string();
+    }
+
+}  // end anonymous namespace
+
+GoalsCommand::GoalsCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Print progress towards goals",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print, for each goal in the goals file, the hours spent so far "
+                    "in the current period, and how far these are from the goal"
+            )
+        },
+        false
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"csv"},
+        "Output in CSV format",
+        [this]() { m_csv = true; }
+    );
+}
+
+GoalsCommand::~GoalsCommand() = default;
+
+Command::ErrorMessages
+GoalsCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    (void)p_ordinary_args;  // silence compiler re. unused param
+
+    auto const time_point = now();
+    vector<GoalTracker::Status> statuses;
+    try
+    {
+        GoalTracker goal_tracker(p_config.path_to_goals(), p_config.path_to_log(), m_time_log);
+        if (goal_tracker.goals().empty())
+        {
+            return {"No goals have been set in " + p_config.path_to_goals()};
+        }
+        goal_tracker.update(time_point);
+        statuses = goal_tracker.statuses(time_point);
+
+        auto const to_rounded_hours = [&p_config](unsigned long long p_seconds)
+        {
+            return round
+            (   p_seconds / 60.0 / 60.0,
+                p_config.output_rounding_numerator(),
+                p_config.output_rounding_denominator()
+            );
+        };
+        if (m_csv)
+        {
+            CsvRow header;
+            header << "activity" << "operator" << "limit" << "period" << "hours";
+            p_ordinary_ostream << header;
+            for (auto const& status: statuses)
+            {
+                auto const& goal = *status.goal;
+                CsvRow row;
+                row << goal.activity << (goal.is_maximum ? "<=" : ">=")
+                    << to_rounded_hours(goal.seconds) << period_name(goal.period)
+                    << to_rounded_hours(status.seconds);
+                p_ordinary_ostream << row;
+            }
+            return {};
+        }
+        string::size_type description_width = 0;
+        for (auto const& status: statuses)
+        {
+            description_width = max(description_width, status.goal->description.length());
+        }
+        auto const hours_width = max<string::size_type>(p_config.output_width(), 5);
+        for (auto const& status: statuses)
+        {
+            auto const& goal = *status.goal;
+            auto const difference = (status.seconds > goal.seconds) ?
+                (status.seconds - goal.seconds) :
+                (goal.seconds - status.seconds);
+            StreamFlagGuard guard(p_ordinary_ostream);
+            p_ordinary_ostream << left << setw(description_width) << goal.description
+                               << right << fixed
+                               << setprecision(p_config.output_precision())
+                               << "  " << setw(hours_width)
+                               << to_rounded_hours(status.seconds) << " hours "
+                               << ((goal.period == GoalTracker::Period::day) ?
+                                   string("today") :
+                                   ("this " + period_name(goal.period)))
+                               << "; ";
+            if (goal.is_maximum)
+            {
+                p_ordinary_ostream << to_rounded_hours(difference)
+                                   << (status.is_crossed() ? " over" : " left");
+            }
+            else if (status.is_crossed())
+            {
+                p_ordinary_ostream << "met";
+            }
+            else
+            {
+                p_ordinary_ostream << to_rounded_hours(difference) << " to go";
+            }
+            guard.reset();
+            p_ordinary_ostream << endl;
+        }
+    }
+    catch (runtime_error& e)
+    {
+        return {e.what()};
+    }
+    return {};
+}
+
+}  // namespace swx
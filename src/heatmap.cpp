@@ -0,0 +1,142 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "heatmap.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+
+using std::chrono::system_clock;
+using std::min;
+using std::size_t;
+using std::time_t;
+using std::tm;
+
+namespace swx
+{
+
+namespace
+{
+    long long const k_seconds_per_hour = 60 * 60;
+    long long const k_seconds_per_day = 24 * k_seconds_per_hour;
+    long long const k_seconds_per_week =
+        Heatmap::k_num_bins * k_seconds_per_hour;
+
+    // 1970-01-01 fell on a Thursday, three days after a Monday.
+    long long const k_epoch_seconds_into_week = 3 * 24 * k_seconds_per_hour;
+
+}  // end anonymous namespace
+
+size_t constexpr Heatmap::k_days_per_week;
+size_t constexpr Heatmap::k_hours_per_day;
+size_t constexpr Heatmap::k_num_bins;
+
+Heatmap::Heatmap()
+{
+    m_bins.fill(0);
+}
+
+Heatmap::~Heatmap() = default;
+
+void
+Heatmap::add(TimePoint const& p_beginning, TimePoint const& p_ending)
+{
+    auto beginning = system_clock::to_time_t(p_beginning);
+    auto const ending = system_clock::to_time_t(p_ending);
+    while (beginning < ending)
+    {
+        // Local time is a fixed offset from UTC between changes to and from
+        // daylight saving time, which are never less than a day apart. So
+        // the period is split into pieces of constant offset by walking it a
+        // day at a time, and searching for where the offset changes only
+        // within a day at whose ends it differs.
+        auto const offset = utc_offset(beginning);
+        auto piece_ending = beginning;
+        while (piece_ending < ending)
+        {
+            auto const day_ending = min<time_t>(piece_ending + k_seconds_per_day, ending);
+            if (utc_offset(day_ending - 1) == offset)
+            {
+                piece_ending = day_ending;
+                continue;
+            }
+            auto lo = (piece_ending == beginning ? beginning : piece_ending - 1);
+            auto hi = day_ending - 1;
+            while (hi - lo > 1)
+            {
+                auto const mid = lo + (hi - lo) / 2;
+                if (utc_offset(mid) == offset) lo = mid;
+                else hi = mid;
+            }
+            piece_ending = hi;
+            break;
+        }
+        add_local(static_cast<long long>(beginning) + offset, piece_ending - beginning);
+        beginning = piece_ending;
+    }
+}
+
+unsigned long long
+Heatmap::seconds(size_t p_day, size_t p_hour) const
+{
+    assert (p_day < k_days_per_week);
+    assert (p_hour < k_hours_per_day);
+    return m_bins[p_day * k_hours_per_day + p_hour];
+}
+
+long
+Heatmap::utc_offset(time_t p_time)
+{
+    if (!m_has_offset || (p_time != m_offset_time))
+    {
+        tm time_tm;
+        localtime_r(&p_time, &time_tm);  // non-portable
+        m_offset = time_tm.tm_gmtoff;  // non-portable
+        m_offset_time = p_time;
+        m_has_offset = true;
+    }
+    return m_offset;
+}
+
+void
+Heatmap::add_local(long long p_local_beginning, long long p_duration)
+{
+    assert (p_duration >= 0);
+    auto into_week =
+        (p_local_beginning + k_epoch_seconds_into_week) % k_seconds_per_week;
+    if (into_week < 0) into_week += k_seconds_per_week;
+    if (p_duration >= k_seconds_per_week)
+    {
+        auto const weeks = p_duration / k_seconds_per_week;
+        for (auto& bin: m_bins) bin += weeks * k_seconds_per_hour;
+        p_duration -= weeks * k_seconds_per_week;
+    }
+    auto bin = static_cast<size_t>(into_week / k_seconds_per_hour);
+    auto into_hour = into_week % k_seconds_per_hour;
+    while (p_duration > 0)
+    {
+        auto const slice = min(p_duration, k_seconds_per_hour - into_hour);
+        m_bins[bin] += slice;
+        p_duration -= slice;
+        into_hour = 0;
+        if (++bin == k_num_bins) bin = 0;
+    }
+}
+
+}  // namespace swx
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "heatmap_command.hpp"
+#include "activity_filter.hpp"
+#include "arithmetic.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "csv_row.hpp"
+#include "heatmap.hpp"
+#include "help_line.hpp"
+#include "interval.hpp"
+#include "placeholder.hpp"
+#include "profiler.hpp"
+#include "stint.hpp"
+#include "stream_flag_guard.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::max;
+using std::ostream;
+using std::right;
+using std::runtime_error;
+using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::string;
+using std::to_string;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    char const* const k_day_names[Heatmap::k_days_per_week] =
+    {   "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"
+    };
+
+    // Cells are shaded from blank, for no time, to the last character, for
+    // the busiest hour of the week.
+    string const k_shades = " .:-=+*#@";
+
+    size_t const k_hours_per_label = 3;
+
+}  // end anonymous namespace
+
+HeatmapCommand::HeatmapCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Print a grid of time spent in each hour of the week",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print a grid showing, for each hour of the week, the total time "
+                    "spent on all activities during that hour"
+            ),
+            HelpLine
+            (   "Print a grid showing, for each hour of the week, the total time "
+                    "spent on ACTIVITY during that hour",
+                "<ACTIVITY>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"x", "exact"},
+        "Count only the exact ACTIVITY given; not its subactivities",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::exact; }
+    );
+    add_option
+    (   vector<string>{"r", "regex"},
+        "Treat ACTIVITY as a regular expression, and count all activities that "
+            "match it",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::regex; }
+    );
+    add_option
+    (   vector<string>{"f", "from"},
+        HelpLine("Only count time spent on activities since TIMESTAMP", "<TIMESTAMP>"),
+        nullptr,
+        &m_since_str
+    );
+    add_option
+    (   vector<string>{"t", "to"},
+        HelpLine("Only count time spent on activities until TIMESTAMP", "<TIMESTAMP>"),
+        nullptr,
+        &m_until_str
+    );
+    add_option
+    (   vector<string>{"csv"},
+        "Output in CSV format, with a row for each day of the week and a column "
+            "for each hour of the day, showing hours spent",
+        [this]() { m_csv = true; }
+    );
+}
+
+HeatmapCommand::~HeatmapCommand() = default;
+
+bool
+HeatmapCommand::does_support_placeholders() const
+{
+    return true;
+}
+
+Command::ErrorMessages
+HeatmapCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    ErrorMessages ret;
+    unique_ptr<TimePoint> since_time_point_ptr;
+    unique_ptr<TimePoint> until_time_point_ptr;
+    auto const long_time_fmt = p_config.time_format();
+    auto const short_time_fmt = p_config.short_time_format();
+    if (!m_since_str.empty())
+    {
+        try
+        {
+            since_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_since_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_since_str);
+        }
+    }
+    if (!m_until_str.empty())
+    {
+        try
+        {
+            until_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_until_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_until_str);
+        }
+    }
+    if (!ret.empty())
+    {
+        return ret;
+    }
+
+    string comparitor;
+    auto filter_type = m_activity_filter_type;
+    if (p_ordinary_args.empty())
+    {
+        filter_type = ActivityFilter::Type::always_true;
+    }
+    else
+    {
+        comparitor = expand_placeholders(p_ordinary_args, m_time_log);
+    }
+    unique_ptr<ActivityFilter> const
+        filter(ActivityFilter::create(comparitor, filter_type));
+    auto const stints = m_time_log.get_stints
+    (   *filter,
+        since_time_point_ptr.get(),
+        until_time_point_ptr.get()
+    );
+    Heatmap heatmap;
+    {
+        Profiler::Phase const phase("heatmap");
+        for (auto const& stint: stints)
+        {
+            if (stint.activity().empty()) continue;
+            auto const interval = stint.interval();
+            heatmap.add(interval.beginning(), interval.ending());
+        }
+    }
+    if (m_csv) write_csv(p_ordinary_ostream, p_config, heatmap);
+    else write_grid(p_ordinary_ostream, p_config, heatmap);
+    return ret;
+}
+
+void
+HeatmapCommand::write_grid
+(   ostream& p_os,
+    Config const& p_config,
+    Heatmap const& p_heatmap
+) const
+{
+    unsigned long long busiest = 0;
+    for (size_t day = 0; day != Heatmap::k_days_per_week; ++day)
+    {
+        for (size_t hour = 0; hour != Heatmap::k_hours_per_day; ++hour)
+        {
+            busiest = max(busiest, p_heatmap.seconds(day, hour));
+        }
+    }
+    auto const to_rounded_hours = [&p_config](unsigned long long p_seconds)
+    {
+        return round
+        (   p_seconds / 60.0 / 60.0,
+            p_config.output_rounding_numerator(),
+            p_config.output_rounding_denominator()
+        );
+    };
+    auto const num_levels = k_shades.size() - 1;
+    string const margin(4, ' ');
+
+    p_os << margin;
+    for (size_t hour = 0; hour < Heatmap::k_hours_per_day; hour += k_hours_per_label)
+    {
+        StreamFlagGuard guard(p_os);
+        auto const is_last = (hour + k_hours_per_label >= Heatmap::k_hours_per_day);
+        p_os << left << setw(is_last ? 0 : k_hours_per_label) << to_string(hour);
+    }
+    p_os << endl;
+    for (size_t day = 0; day != Heatmap::k_days_per_week; ++day)
+    {
+        p_os << k_day_names[day] << ' ';
+        unsigned long long total = 0;
+        for (size_t hour = 0; hour != Heatmap::k_hours_per_day; ++hour)
+        {
+            auto const seconds = p_heatmap.seconds(day, hour);
+            total += seconds;
+            // Levels above zero are proportional to the busiest hour, rounding
+            // up so that any time at all is visible.
+            auto const level = (seconds == 0) ?
+                0 :
+                static_cast<size_t>((seconds * num_levels + busiest - 1) / busiest);
+            p_os << k_shades[level];
+        }
+        StreamFlagGuard guard(p_os);
+        p_os << ' ' << fixed << setprecision(p_config.output_precision())
+             << right << setw(p_config.output_width()) << to_rounded_hours(total);
+        guard.reset();
+        p_os << endl;
+    }
+    StreamFlagGuard guard(p_os);
+    p_os << endl << "Scale: \"" << k_shades << "\" from none to "
+         << fixed << setprecision(p_config.output_precision())
+         << to_rounded_hours(busiest) << " hours";
+    guard.reset();
+    p_os << endl;
+}
+
+void
+HeatmapCommand::write_csv
+(   ostream& p_os,
+    Config const& p_config,
+    Heatmap const& p_heatmap
+) const
+{
+    CsvRow header;
+    header << "day";
+    for (size_t hour = 0; hour != Heatmap::k_hours_per_day; ++hour) header << hour;
+    p_os << header;
+    for (size_t day = 0; day != Heatmap::k_days_per_week; ++day)
+    {
+        CsvRow row;
+        row << k_day_names[day];
+        for (size_t hour = 0; hour != Heatmap::k_hours_per_day; ++hour)
+        {
+            row << round
+            (   p_heatmap.seconds(day, hour) / 60.0 / 60.0,
+                p_config.output_rounding_numerator(),
+                p_config.output_rounding_denominator()
+            );
+        }
+        p_os << row;
+    }
+}
+
+}  // namespace swx
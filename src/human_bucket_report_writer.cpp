@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "human_bucket_report_writer.hpp"
+#include "bucket_report_writer.hpp"
+#include "stint.hpp"
+#include "stream_flag_guard.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::max;
+using std::ostream;
+using std::right;
+using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+HumanBucketReportWriter::HumanBucketReportWriter
+(   vector<Stint> const& p_stints,
+    Options const& p_options,
+    Flags::Type p_flags
+):
+    BucketReportWriter(p_stints, p_options, p_flags)
+{
+}
+
+HumanBucketReportWriter::~HumanBucketReportWriter() = default;
+
+void
+HumanBucketReportWriter::do_write_matrix
+(   ostream& p_os,
+    vector<string> const& p_labels,
+    Rows const& p_rows
+)
+{
+    if (p_rows.empty())
+    {
+        p_os << endl;
+        return;
+    }
+    auto const succinct = has_flag(Flags::succinct);
+    string const total_label = "TOTAL";
+    string::size_type left_col_width = total_label.length();
+    vector<unsigned long long> totals(p_labels.size(), 0);
+    for (auto const& row: p_rows)
+    {
+        left_col_width = max(left_col_width, row.first.length());
+        for (size_t i = 0; i != row.second.size(); ++i) totals[i] += row.second[i];
+    }
+    if (succinct) left_col_width = 0;
+    vector<string::size_type> col_widths;
+    for (auto const& label: p_labels)
+    {
+        col_widths.push_back(max<string::size_type>(label.length(), output_width()));
+    }
+
+    auto const write_row = [&](string const& p_label, vector<unsigned long long> const& p_seconds)
+    {
+        StreamFlagGuard guard(p_os);
+        p_os << left << setw(left_col_width) << p_label
+             << right << fixed << setprecision(output_precision());
+        for (size_t i = 0; i != col_widths.size(); ++i)
+        {
+            auto const seconds = (i < p_seconds.size()) ? p_seconds[i] : 0;
+            p_os << "  " << setw(col_widths[i]) << seconds_to_rounded_hours(seconds);
+        }
+        guard.reset();
+        p_os << endl;
+    };
+
+    {
+        StreamFlagGuard guard(p_os);
+        p_os << string(left_col_width, ' ') << right;
+        for (size_t i = 0; i != p_labels.size(); ++i)
+        {
+            p_os << "  " << setw(col_widths[i]) << p_labels[i];
+        }
+        guard.reset();
+        p_os << endl;
+    }
+    if (!succinct)
+    {
+        for (auto const& row: p_rows) write_row(row.first, row.second);
+        p_os << endl;
+    }
+    write_row(succinct ? string() : total_label, totals);
+}
+
+}  // namespace swx
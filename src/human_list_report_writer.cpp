@@ -70,6 +70,10 @@ HumanListReportWriter::do_process_stint(ostream& p_os, Stint const& p_stint)
              << "  ";
         guard.reset();
         p_os << p_stint.activity() << endl;
+        for (auto const& note: notes(interval))
+        {
+            p_os << "    " << note << endl;
+        }
     }
 }
 
@@ -19,6 +19,7 @@
 #include "activity_node.hpp"
 #include "activity_tree.hpp"
 #include "arithmetic.hpp"
+#include "duration_sketch.hpp"
 #include "stint.hpp"
 #include "stream_flag_guard.hpp"
 #include "stream_utilities.hpp"
@@ -30,6 +31,7 @@
 #include <iostream>
 #include <map>
 #include <ostream>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -38,13 +40,18 @@ using std::endl;
 using std::fixed;
 using std::left;
 using std::map;
+using std::noshowpos;
 using std::ostream;
 using std::ostringstream;
 using std::right;
 using std::runtime_error;
+using std::set;
 using std::setprecision;
 using std::setw;
+using std::showpos;
+using std::size_t;
 using std::string;
+using std::to_string;
 using std::vector;
 
 namespace swx
@@ -72,6 +79,35 @@ HumanSummaryReportWriter::do_write_summary
     else write_tree_summary(p_os, p_activity_stats_map);
 }
 
+void
+HumanSummaryReportWriter::do_write_comparison
+(   ostream& p_os,
+    vector<map<string, ActivityStats>> const& p_activity_stats_maps
+)
+{
+    if (has_flag(Flags::succinct))
+    {
+        vector<unsigned long long> totals;
+        for (auto const& stats_map: p_activity_stats_maps)
+        {
+            ActivityStats total_info;
+            for (auto const& pair: stats_map) total_info += pair.second;
+            totals.push_back(total_info.seconds);
+        }
+        write_comparison_header(p_os, 0, totals.size());
+        write_comparison_values(p_os, totals);
+        p_os << endl;
+        return;
+    }
+    for (size_t i = 0; i != p_activity_stats_maps.size(); ++i)
+    {
+        p_os << '[' << (i + 1) << "] " << describe_period(i) << endl;
+    }
+    p_os << endl;
+    if (has_flag(Flags::verbose)) write_flat_comparison(p_os, p_activity_stats_maps);
+    else write_tree_comparison(p_os, p_activity_stats_maps);
+}
+
 void
 HumanSummaryReportWriter::print_label_and_rounded_hours
 (   ostream& p_os,
@@ -79,7 +115,9 @@ HumanSummaryReportWriter::print_label_and_rounded_hours
     unsigned long long p_seconds,
     TimePoint const* p_beginning,
     TimePoint const* p_ending,
-    unsigned int p_left_col_width
+    DurationSketch const* p_durations,
+    unsigned int p_left_col_width,
+    string::size_type p_count_width
 ) const
 {
     StreamFlagGuard guard(p_os);
@@ -102,9 +140,42 @@ HumanSummaryReportWriter::print_label_and_rounded_hours
         p_os << "    "
              << time_point_to_stamp(*p_ending, time_format(), formatted_buf_len());
     }
+    if (p_durations != nullptr)
+    {
+        p_os << "    ";
+        write_durations(p_os, *p_durations, p_count_width);
+    }
     p_os << endl;
 }
 
+void
+HumanSummaryReportWriter::write_durations
+(   ostream& p_os,
+    DurationSketch const& p_durations,
+    string::size_type p_count_width
+) const
+{
+    auto const count = p_durations.count();
+    StreamFlagGuard guard(p_os);
+    p_os << right << setw(p_count_width) << count
+         << ((count == 1) ? " stint; " : " stints;")
+         << fixed << setprecision(output_precision());
+    auto const write_hours = [&](char const* p_label, double p_seconds)
+    {
+        p_os << ' ' << p_label << ' ' << setw(output_width())
+             << seconds_to_rounded_hours(static_cast<unsigned long long>(p_seconds + 0.5));
+    };
+    write_hours("mean", p_durations.mean());
+    p_os << ',';
+    write_hours("median", p_durations.quantile(0.5));
+    p_os << ',';
+    write_hours("p90", p_durations.quantile(0.9));
+    p_os << ',';
+    write_hours("p99", p_durations.quantile(0.99));
+    p_os << ',';
+    write_hours("max", p_durations.max());
+}
+
 void
 HumanSummaryReportWriter::write_succinct_summary
 (   ostream& p_os,
@@ -118,7 +189,8 @@ HumanSummaryReportWriter::write_succinct_summary
         string(),
         total_info.seconds,
         (has_flag(Flags::include_beginning) ?  &(total_info.beginning) : nullptr),
-        (has_flag(Flags::include_ending) ? &(total_info.ending) : nullptr)
+        (has_flag(Flags::include_ending) ? &(total_info.ending) : nullptr),
+        (has_flag(Flags::durations) ? &(total_info.durations) : nullptr)
     );
 }
 
@@ -138,6 +210,10 @@ HumanSummaryReportWriter::write_flat_summary
     ActivityStats total_info;
     auto const include_beginning = has_flag(Flags::include_beginning);
     auto const include_ending = has_flag(Flags::include_ending);
+    auto const include_durations = has_flag(Flags::durations);
+    unsigned long long total_count = 0;
+    for (auto const& pair: p_activity_stats_map) total_count += pair.second.durations.count();
+    auto const count_width = to_string(total_count).length();
     for (auto const& pair: p_activity_stats_map)
     {
         auto const& activity = pair.first;
@@ -149,7 +225,9 @@ HumanSummaryReportWriter::write_flat_summary
             info.seconds,
             (include_beginning ? &(info.beginning) : nullptr),
             (include_ending ? &(info.ending) : nullptr),
-            left_col_width
+            (include_durations ? &(info.durations) : nullptr),
+            left_col_width,
+            count_width
         );
     }
     p_os << endl;
@@ -159,7 +237,9 @@ HumanSummaryReportWriter::write_flat_summary
         total_info.seconds,
         (include_beginning ? &(total_info.beginning) : nullptr),
         (include_ending ? &(total_info.ending) : nullptr),
-        left_col_width
+        (include_durations ? &(total_info.durations) : nullptr),
+        left_col_width,
+        count_width
     );
 }
 
@@ -175,7 +255,10 @@ HumanSummaryReportWriter::write_tree_summary
         return;
     }
     ActivityTree const tree(p_activity_stats_map);
-    ActivityTree::PrintNode const print_node = [this]
+    unsigned long long total_count = 0;
+    for (auto const& pair: p_activity_stats_map) total_count += pair.second.durations.count();
+    auto const count_width = to_string(total_count).length();
+    ActivityTree::PrintNode const print_node = [this, count_width]
     (   ostream& p_ostream,
         unsigned int p_node_depth,
         string const& p_node_label,
@@ -205,10 +288,162 @@ HumanSummaryReportWriter::write_tree_summary
                 auto const s = time_point_to_stamp(e, time_format(), formatted_buf_len());
                 p_ostream << "[ " << s << " ]";
             }
+            if (has_flag(Flags::durations))
+            {
+                p_ostream << "[ ";
+                write_durations(p_ostream, p_stats.durations, count_width);
+                p_ostream << " ]";
+            }
             p_ostream << ' ' << p_node_label << endl;
         }
     };
     tree.print(p_os, print_node);
 }
 
+void
+HumanSummaryReportWriter::write_comparison_header
+(   ostream& p_os,
+    string::size_type p_indent,
+    size_t p_num_periods
+) const
+{
+    StreamFlagGuard guard(p_os);
+    p_os << string(p_indent, ' ') << right << setw(output_width()) << "[1]";
+    for (size_t i = 1; i != p_num_periods; ++i)
+    {
+        auto const label = '[' + to_string(i + 1) + ']';
+        p_os << "  " << setw(output_width()) << label
+             << "  " << setw(output_width()) << ("[1]-" + label);
+    }
+    guard.reset();
+    p_os << endl;
+}
+
+void
+HumanSummaryReportWriter::write_comparison_values
+(   ostream& p_os,
+    vector<unsigned long long> const& p_seconds
+) const
+{
+    assert (!p_seconds.empty());
+    StreamFlagGuard guard(p_os);
+    auto const hours = seconds_to_rounded_hours(p_seconds[0]);
+    p_os << fixed << setprecision(output_precision()) << right
+         << setw(output_width()) << hours;
+    for (size_t i = 1; i != p_seconds.size(); ++i)
+    {
+        auto const other_hours = seconds_to_rounded_hours(p_seconds[i]);
+        p_os << "  " << setw(output_width()) << other_hours << "  " << showpos
+             << setw(output_width()) << (hours - other_hours) << noshowpos;
+    }
+}
+
+void
+HumanSummaryReportWriter::write_flat_comparison
+(   ostream& p_os,
+    vector<map<string, ActivityStats>> const& p_activity_stats_maps
+)
+{
+    set<string> activities;
+    for (auto const& stats_map: p_activity_stats_maps)
+    {
+        for (auto const& pair: stats_map) activities.insert(pair.first);
+    }
+    string::size_type left_col_width = 0;
+    for (auto const& activity: activities)
+    {
+        if (activity.length() > left_col_width) left_col_width = activity.length();
+    }
+    write_comparison_header(p_os, left_col_width + 1, p_activity_stats_maps.size());
+    auto const write_row = [&](string const& p_label, vector<unsigned long long> const& p_seconds)
+    {
+        StreamFlagGuard guard(p_os);
+        p_os << left << setw(left_col_width) << p_label << ' ';
+        guard.reset();
+        write_comparison_values(p_os, p_seconds);
+        p_os << endl;
+    };
+    vector<unsigned long long> totals(p_activity_stats_maps.size(), 0);
+    for (auto const& activity: activities)
+    {
+        vector<unsigned long long> seconds;
+        for (size_t i = 0; i != p_activity_stats_maps.size(); ++i)
+        {
+            auto const& stats_map = p_activity_stats_maps[i];
+            auto const it = stats_map.find(activity);
+            seconds.push_back((it == stats_map.end()) ? 0 : it->second.seconds);
+            totals[i] += seconds.back();
+        }
+        write_row(activity, seconds);
+    }
+    p_os << endl;
+    write_row("TOTAL", totals);
+}
+
+void
+HumanSummaryReportWriter::write_tree_comparison
+(   ostream& p_os,
+    vector<map<string, ActivityStats>> const& p_activity_stats_maps
+)
+{
+    // A tree is built for each period, from the same activities, so that
+    // the trees have the same shape and their nodes are printed in the same
+    // order; the lines for each period can then be written side by side.
+    struct Line
+    {
+        unsigned int depth;
+        string label;
+        vector<unsigned long long> seconds;
+    };
+    set<string> activities;
+    for (auto const& stats_map: p_activity_stats_maps)
+    {
+        for (auto const& pair: stats_map) activities.insert(pair.first);
+    }
+    if (activities.empty())
+    {
+        p_os << endl;
+        return;
+    }
+    vector<Line> lines;
+    for (auto const& stats_map: p_activity_stats_maps)
+    {
+        auto filled_map = stats_map;
+        for (auto const& activity: activities) filled_map[activity];
+        ActivityTree const tree(filled_map);
+        size_t line_index = 0;
+        tree.print
+        (   p_os,
+            [&lines, &line_index]
+            (   ostream& p_ostream,
+                unsigned int p_node_depth,
+                string const& p_node_label,
+                ActivityStats const& p_stats
+            )
+            {
+                (void)p_ostream;  // silence compiler warning re. unused param.
+                if (line_index == lines.size())
+                {
+                    lines.push_back(Line{p_node_depth, p_node_label, {}});
+                }
+                assert (lines[line_index].label == p_node_label);
+                lines[line_index].seconds.push_back(p_stats.seconds);
+                ++line_index;
+            }
+        );
+    }
+    auto const num_periods = p_activity_stats_maps.size();
+    auto const box_width =
+        output_width() + (num_periods - 1) * (2 * output_width() + 4) + 4;
+    auto const depth_limit = depth();
+    write_comparison_header(p_os, 2, num_periods);
+    for (auto const& line: lines)
+    {
+        if (depth_limit != 0 && line.depth >= depth_limit) continue;
+        p_os << string(line.depth * box_width, ' ') << "[ ";
+        write_comparison_values(p_os, line.seconds);
+        p_os << " ] " << line.label << endl;
+    }
+}
+
 }  // namespace swx
@@ -0,0 +1,279 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "import_command.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "csv_row.hpp"
+#include "entry_sorter.hpp"
+#include "help_line.hpp"
+#include "recording_command.hpp"
+#include "stream_utilities.hpp"
+#include "string_utilities.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::cin;
+using std::endl;
+using std::getline;
+using std::ifstream;
+using std::istream;
+using std::ostream;
+using std::ostringstream;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    string const k_stdin_filepath = "-";
+
+    // Indices of cells in the rows written by CsvListReportWriter.
+    vector<string>::size_type const k_csv_beginning_index = 0;
+    vector<string>::size_type const k_csv_ending_index = 1;
+    vector<string>::size_type const k_csv_activity_index = 3;
+    vector<string>::size_type const k_csv_min_cells = 4;
+
+    string source_description(string const& p_source_name)
+    {
+        return
+        (   p_source_name == k_stdin_filepath ?
+            string("standard input") :
+            p_source_name
+        );
+    }
+
+}  // end anonymous namespace
+
+ImportCommand::ImportCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    RecordingCommand
+    (   p_command_word,
+        p_aliases,
+        "Merge entries from other files into the activity log",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Read entries from standard input, in the format of the "
+                    "activity log, and merge them into the activity log"
+            ),
+            HelpLine
+            (   "Read entries from each FILE, in the format of the activity log, "
+                    "and merge them into the activity log (if FILE is \"-\", read "
+                    "from standard input)",
+                "<FILE...>"
+            )
+        },
+        true,
+        p_time_log
+    )
+{
+    add_option
+    (   vector<string>{"csv"},
+        "Read the entries in CSV format, as output by the reporting commands "
+            "when passed the -l and --csv options; each stint is imported as "
+            "an entry for its activity at its start time, followed by a cessation "
+            "of activity at its end time (unless another stint starts at that time)",
+        [this]() { m_csv = true; }
+    );
+    add_option
+    (   vector<string>{"buffer"},
+        HelpLine
+        (   "Hold no more than approximately N megabytes of entries in memory "
+                "while sorting them, spilling the remainder to temporary files "
+                "(default: 64)",
+            "<N>"
+        ),
+        nullptr,
+        &m_buffer_size_str
+    );
+}
+
+ImportCommand::~ImportCommand() = default;
+
+Command::ErrorMessages
+ImportCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    size_t buffer_size = 0;
+    stringstream ss(m_buffer_size_str);
+    ss >> buffer_size;
+    if (!ss || (buffer_size == 0))
+    {
+        return {"Could not parse \"" + m_buffer_size_str + "\" as positive numeric argument."};
+    }
+    auto const sources =
+    (   p_ordinary_args.empty() ?
+        vector<string>{k_stdin_filepath} :
+        p_ordinary_args
+    );
+    ErrorMessages ret;
+    EntrySorter sorter(buffer_size * 1024 * 1024);
+    size_t num_read = 0;
+    for (auto const& source: sources)
+    {
+        ifstream infile;
+        if (source != k_stdin_filepath)
+        {
+            infile.open(source.c_str());
+            if (!infile)
+            {
+                ret.push_back("Could not open file: " + source);
+                continue;
+            }
+        }
+        istream& is = ((source == k_stdin_filepath) ? cin : infile);
+        num_read +=
+        (   m_csv ?
+            read_csv_rows(is, source, p_config.time_format(), sorter, ret) :
+            read_log_lines(is, source, sorter, ret)
+        );
+    }
+    if (!ret.empty())
+    {
+        ret.push_back("Nothing imported.");
+        return ret;
+    }
+    auto const num_added = time_log().merge_entries
+    (   [&sorter]
+        (   string& p_activity,
+            TimePoint& p_time_point,
+            string& p_tags,
+            bool& p_provisional
+        )
+        {
+            return sorter.next(p_activity, p_time_point, p_tags, p_provisional);
+        }
+    );
+    p_ordinary_ostream << "Read " << num_read << " entries from " << sources.size()
+                       << (sources.size() == 1 ? " source" : " sources")
+                       << "; activity log grew by " << num_added << " entries."
+                       << endl;
+    return ret;
+}
+
+size_t
+ImportCommand::read_log_lines
+(   istream& p_is,
+    string const& p_source_name,
+    EntrySorter& p_sorter,
+    ErrorMessages& p_errors
+)
+{
+    size_t num_read = 0;
+    size_t line_number = 0;
+    string line;
+    string tags;
+    while (getline(p_is, line))
+    {
+        ++line_number;
+        if (trim(line).empty())
+        {
+            continue;
+        }
+        try
+        {
+            tags.clear();
+            auto const entry = time_log().parse_entry(line, line_number, &tags);
+            p_sorter.add(entry.first, entry.second, tags);
+            ++num_read;
+        }
+        catch (runtime_error& e)
+        {
+            p_errors.push_back(source_description(p_source_name) + ": " + e.what());
+        }
+    }
+    return num_read;
+}
+
+size_t
+ImportCommand::read_csv_rows
+(   istream& p_is,
+    string const& p_source_name,
+    string const& p_time_format,
+    EntrySorter& p_sorter,
+    ErrorMessages& p_errors
+)
+{
+    size_t num_read = 0;
+    size_t row_number = 0;
+    vector<string> cells;
+    try
+    {
+        while (read_csv_row(p_is, cells))
+        {
+            ++row_number;
+            if ((cells.size() == 1) && trim(cells[0]).empty())
+            {
+                continue;
+            }
+            try
+            {
+                if (cells.size() < k_csv_min_cells)
+                {
+                    throw runtime_error("Too few cells.");
+                }
+                auto const beginning = long_time_stamp_to_point
+                (   cells[k_csv_beginning_index],
+                    p_time_format
+                );
+                auto const ending = long_time_stamp_to_point
+                (   cells[k_csv_ending_index],
+                    p_time_format
+                );
+                auto const activity = trim(cells[k_csv_activity_index]);
+                p_sorter.add(activity, beginning);
+                p_sorter.add(string(), ending, string(), true);
+                ++num_read;
+            }
+            catch (runtime_error& e)
+            {
+                ostringstream oss;
+                enable_exceptions(oss);
+                oss << source_description(p_source_name) << ": Error parsing row "
+                    << row_number << ". " << e.what();
+                p_errors.push_back(oss.str());
+            }
+        }
+    }
+    catch (runtime_error& e)
+    {
+        p_errors.push_back(source_description(p_source_name) + ": " + e.what());
+    }
+    return num_read;
+}
+
+}  // namespace swx
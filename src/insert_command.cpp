@@ -0,0 +1,150 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "insert_command.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "help_line.hpp"
+#include "placeholder.hpp"
+#include "recording_command.hpp"
+#include "result.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::ostream;
+using std::runtime_error;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+InsertCommand::InsertCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    RecordingCommand
+    (   p_command_word,
+        p_aliases,
+        "Insert a switch at an earlier time",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Insert a cessation of activity at the time given by --at, "
+                    "ending the stint that was current then"
+            ),
+            HelpLine
+            (   "Insert a switch to ACTIVITY at the time given by --at, "
+                    "ending the stint that was current then; the stint that "
+                    "follows is unaffected",
+                "<ACTIVITY>"
+            )
+        },
+        true,
+        p_time_log
+    )
+{
+    add_option
+    (   vector<string>{"at"},
+        HelpLine
+        (   "Insert the switch at the time indicated by TIMESTAMP (required)",
+            "<TIMESTAMP>"
+        ),
+        nullptr,
+        &m_time_stamp
+    );
+    add_option
+    (   vector<string>{"tag"},
+        HelpLine
+        (   "Tag the inserted stint with TAG; may be passed more than once",
+            "<TAG>"
+        ),
+        &m_tags
+    );
+}
+
+InsertCommand::~InsertCommand() = default;
+
+Command::ErrorMessages
+InsertCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    if (m_time_stamp.empty())
+    {
+        return {"The time of the switch must be given with --at."};
+    }
+    auto const tp_result = time_point
+    (   m_time_stamp,
+        p_config.time_format(),
+        p_config.short_time_format()
+    );
+    if (!tp_result.errors().empty())
+    {
+        return tp_result.errors();
+    }
+    auto const tp = tp_result.get();
+    auto const activity = expand_placeholders(p_ordinary_args, time_log());
+    string previous_activity;
+    try
+    {
+        previous_activity = time_log().insert_entry(activity, tp, m_tags);
+    }
+    catch (runtime_error& e)
+    {
+        return {e.what()};
+    }
+    if (previous_activity == activity)
+    {
+        return
+        {   activity.empty() ?
+            "Already inactive at that time." :
+            "\"" + activity + "\" is already the activity at that time."
+        };
+    }
+    auto const confirmed_stamp = time_point_to_stamp
+    (   tp,
+        p_config.time_format(),
+        p_config.formatted_buf_len()
+    );
+    if (activity.empty())
+    {
+        p_ordinary_ostream << "Inserted a cessation of activity at " << confirmed_stamp;
+    }
+    else
+    {
+        p_ordinary_ostream << "Inserted a switch to \"" << activity
+                           << "\" at " << confirmed_stamp;
+    }
+    p_ordinary_ostream << '.' << endl;
+    return {};
+}
+
+bool
+InsertCommand::does_support_placeholders() const
+{
+    return true;
+}
+
+}  // namespace swx
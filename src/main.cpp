@@ -17,10 +17,13 @@
 #include "application.hpp"
 #include "config.hpp"
 #include "info.hpp"
+#include "profiler.hpp"
 #include "stream_utilities.hpp"
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <streambuf>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -30,31 +33,132 @@ using std::cerr;
 using std::cout;
 using std::endl;
 using std::move;
+using std::ostream;
 using std::runtime_error;
+using std::streambuf;
+using std::streamsize;
 using std::string;
+using std::unique_ptr;
 using std::vector;
 using swx::Application;
 using swx::enable_exceptions;
 using swx::Config;
 using swx::Info;
+using swx::Profiler;
+
+namespace
+{
+    string const k_profile_option = "--profile";
+
+    // While in existence, counts the bytes written to p_os, for profiling,
+    // by interposing itself between p_os and its streambuf.
+    class CountingStreambuf: public streambuf
+    {
+    public:
+        explicit CountingStreambuf(ostream& p_os):
+            m_os(p_os),
+            m_destination(p_os.rdbuf())
+        {
+            m_os.rdbuf(this);
+        }
+        CountingStreambuf(CountingStreambuf const& rhs) = delete;
+        CountingStreambuf(CountingStreambuf&& rhs) = delete;
+        CountingStreambuf& operator=(CountingStreambuf const& rhs) = delete;
+        CountingStreambuf& operator=(CountingStreambuf&& rhs) = delete;
+        ~CountingStreambuf()
+        {
+            m_os.rdbuf(m_destination);
+        }
+
+    protected:
+        int_type overflow(int_type p_c) override
+        {
+            if (traits_type::eq_int_type(p_c, traits_type::eof()))
+            {
+                return traits_type::not_eof(p_c);
+            }
+            Profiler::count(Profiler::Counter::bytes_written);
+            return m_destination->sputc(traits_type::to_char_type(p_c));
+        }
+
+        streamsize xsputn(char const* p_s, streamsize p_n) override
+        {
+            auto const ret = m_destination->sputn(p_s, p_n);
+            Profiler::count(Profiler::Counter::bytes_written, ret);
+            return ret;
+        }
+
+        int sync() override
+        {
+            return m_destination->pubsync();
+        }
+
+    private:
+        ostream& m_os;
+        streambuf* const m_destination;
+    };
+
+}  // end anonymous namespace
 
 int main(int argc, char** argv)
 {
     try
     {
         enable_exceptions(cout);
-        if (argc < 2)
+
+        // "--profile" or "--profile=PATH" may precede the command.
+        int command_index = 1;
+        bool profile = false;
+        string profile_path;
+        if (argc >= 2)
+        {
+            string const first_arg(argv[1]);
+            if (first_arg.compare(0, k_profile_option.size(), k_profile_option) == 0)
+            {
+                auto const rest = first_arg.substr(k_profile_option.size());
+                if (rest.empty() || rest[0] == '=')
+                {
+                    profile = true;
+                    if (!rest.empty()) profile_path = rest.substr(1);
+                    ++command_index;
+                }
+            }
+        }
+#       ifdef SWX_ALLOC_STATS
+            // In builds that count allocations, setting this variable has
+            // the same effect as "--profile".
+            if (std::getenv("SWX_ALLOC_STATS")) profile = true;
+#       endif
+        if (argc < command_index + 1)
         {
             cerr << "Command not provided.\n"
                  << Application::directions_to_get_help() << endl;
             return EXIT_FAILURE;
         }
-        assert (argc >= 2);
-        vector<string> const args(argv + 2, argv + argc);
-        auto const config_path = Info::home_dir() + "/.swxrc";  // non-portable
-        Config const config(config_path);
-        Application const application(move(config));
-        return application.process_command(argv[1], args);
+        assert (argc >= command_index + 1);
+        if (profile) Profiler::enable();
+        int ret = EXIT_FAILURE;
+        {
+            unique_ptr<CountingStreambuf> const counting_buf
+            (   profile ? new CountingStreambuf(cout) : nullptr
+            );
+            vector<string> const args(argv + command_index + 1, argv + argc);
+            unique_ptr<Config> config;
+            {
+                Profiler::Phase const phase("config");
+                auto const config_path = Info::home_dir() + "/.swxrc";  // non-portable
+                config.reset(new Config(config_path));
+            }
+            Profiler::Phase const phase("command");
+            Application const application(move(*config));
+            ret = application.process_command(argv[command_index], args);
+        }
+        if (profile)
+        {
+            if (profile_path.empty()) Profiler::write_summary(cerr);
+            else Profiler::write_trace(profile_path);
+        }
+        return ret;
     }
     catch (runtime_error& e)
     {
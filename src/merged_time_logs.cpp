@@ -0,0 +1,248 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "merged_time_logs.hpp"
+#include "activity_filter.hpp"
+#include "file_utilities.hpp"
+#include "interval.hpp"
+#include "profiler.hpp"
+#include "stint.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using std::exception;
+using std::exception_ptr;
+using std::function;
+using std::make_shared;
+using std::priority_queue;
+using std::rethrow_exception;
+using std::runtime_error;
+using std::shared_ptr;
+using std::size_t;
+using std::string;
+using std::thread;
+using std::unique_ptr;
+using std::unordered_map;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    // One source, with a cursor over its matching stints, under their
+    // activity names as in the source's own log, and storage for the
+    // labelled names under which they are passed on.
+    struct LoadedLog
+    {
+        LoadedLog
+        (   MergedTimeLogs::Source const& p_source,
+            string const& p_time_format,
+            unsigned int p_formatted_buf_len
+        ):
+            label(p_source.label),
+            time_log(p_source.filepath, p_time_format, p_formatted_buf_len)
+        {
+        }
+
+        // Return p_activity with the label prefixed to it. The names are
+        // cached by the address of p_activity, which is stable for as long
+        // as time_log is unchanged.
+        string const& labelled(string const& p_activity)
+        {
+            if (label.empty() || p_activity.empty()) return p_activity;
+            auto it = labelled_activities.find(&p_activity);
+            if (it == labelled_activities.end())
+            {
+                it = labelled_activities.emplace(&p_activity, label + ' ' + p_activity).first;
+            }
+            return it->second;
+        }
+
+        string const label;
+        TimeLog time_log;
+        unordered_map<string const*, string> labelled_activities;
+        TimeLog::StintPredicate matches;
+        unique_ptr<TimeLog::StintCursor> cursor;
+        exception_ptr error;
+    };
+
+    // Load the log, and place its cursor at the first matching stint. The
+    // filter applies to the labelled names; but the stints are produced
+    // under their own names, and only labelled as they are merged.
+    void load
+    (   ActivityFilter const& p_activity_filter,
+        TimePoint const* p_begin,
+        TimePoint const* p_end,
+        vector<string> const& p_tags,
+        LoadedLog& p_log
+    )
+    {
+        p_log.matches =
+            [&p_activity_filter, &p_log](string const& p_activity, Interval const&, string const*)
+            {
+                return p_activity_filter.matches(p_log.labelled(p_activity));
+            };
+        p_log.cursor.reset
+        (   new TimeLog::StintCursor
+            (   p_log.time_log.stint_cursor(p_log.matches, p_begin, p_end, p_tags)
+            )
+        );
+    }
+
+    // The log whose cursor is at the next stint to be merged.
+    struct Head
+    {
+        TimePoint beginning;
+        size_t log_index;
+    };
+
+    struct LaterHead
+    {
+        bool operator()(Head const& lhs, Head const& rhs) const
+        {
+            if (lhs.beginning != rhs.beginning) return lhs.beginning > rhs.beginning;
+            return lhs.log_index > rhs.log_index;
+        }
+    };
+
+}  // end anonymous namespace
+
+MergedTimeLogs::Source
+MergedTimeLogs::parse_source(string const& p_spec)
+{
+    Source ret;
+    auto const eq_pos = p_spec.find('=');
+    if ((eq_pos != string::npos) && (p_spec.find('/') > eq_pos))
+    {
+        ret.label = p_spec.substr(0, eq_pos);
+        ret.filepath = p_spec.substr(eq_pos + 1);
+    }
+    else
+    {
+        ret.filepath = p_spec;
+    }
+    return ret;
+}
+
+MergedTimeLogs::MergedTimeLogs
+(   vector<Source> const& p_sources,
+    string const& p_time_format,
+    unsigned int p_formatted_buf_len
+):
+    m_sources(p_sources),
+    m_time_format(p_time_format),
+    m_formatted_buf_len(p_formatted_buf_len)
+{
+}
+
+MergedTimeLogs::~MergedTimeLogs() = default;
+
+void
+MergedTimeLogs::for_each_stint
+(   ActivityFilter const& p_activity_filter,
+    TimePoint const* p_begin,
+    TimePoint const* p_end,
+    vector<string> const& p_tags,
+    function<void(Stint const&)> const& p_sink
+) const
+{
+    vector<shared_ptr<LoadedLog>> logs;
+    for (auto const& source: m_sources)
+    {
+        if (!file_exists_at(source.filepath))
+        {
+            throw runtime_error("No time log at " + source.filepath);
+        }
+        logs.push_back(make_shared<LoadedLog>(source, m_time_format, m_formatted_buf_len));
+    }
+    {
+        Profiler::Phase const phase("load logs");
+        vector<thread> threads;
+        for (size_t i = 0; i != logs.size(); ++i)
+        {
+            auto& log = *logs[i];
+            threads.emplace_back
+            (   [&log, &p_activity_filter, p_begin, p_end, &p_tags]()
+                {
+                    try
+                    {
+                        load(p_activity_filter, p_begin, p_end, p_tags, log);
+                    }
+                    catch (...)
+                    {
+                        log.error = std::current_exception();
+                    }
+                }
+            );
+        }
+        for (auto& t: threads) t.join();
+    }
+    for (size_t i = 0; i != logs.size(); ++i)
+    {
+        if (logs[i]->error)
+        {
+            try
+            {
+                rethrow_exception(logs[i]->error);
+            }
+            catch (exception& e)
+            {
+                throw runtime_error(m_sources[i].filepath + ": " + e.what());
+            }
+        }
+    }
+
+    // Only the stint at the head of each log is held at any time.
+    Profiler::Phase const phase("merge logs");
+    priority_queue<Head, vector<Head>, LaterHead> queue;
+    for (size_t i = 0; i != logs.size(); ++i)
+    {
+        auto const& cursor = *logs[i]->cursor;
+        if (!cursor.done()) queue.push(Head{cursor.current().interval().beginning(), i});
+    }
+    size_t num_stints = 0;
+    while (!queue.empty())
+    {
+        auto head = queue.top();
+        queue.pop();
+        auto& log = *logs[head.log_index];
+        auto& cursor = *log.cursor;
+        auto const stint = cursor.current();
+        p_sink(Stint(log.labelled(stint.activity()), stint.interval()));
+        ++num_stints;
+        cursor.advance();
+        if (!cursor.done())
+        {
+            head.beginning = cursor.current().interval().beginning();
+            queue.push(head);
+        }
+    }
+    Profiler::count(Profiler::Counter::stints_produced, num_stints);
+}
+
+}  // namespace swx
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "note_command.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "help_line.hpp"
+#include "note_store.hpp"
+#include "string_utilities.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <chrono>
+#include <iostream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::ostream;
+using std::runtime_error;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+NoteCommand::NoteCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Attach a note to the current stint, or print its notes",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print the notes attached to the current stint"
+            ),
+            HelpLine
+            (   "Attach TEXT as a note to the current stint",
+                "<TEXT>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"p", "previous"},
+        "Attach the note to, or print the notes of, the stint before the "
+            "current one (or the last stint, if currently inactive)",
+        [this]() { m_previous = true; }
+    );
+}
+
+NoteCommand::~NoteCommand() = default;
+
+Command::ErrorMessages
+NoteCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    if (!m_previous && !m_time_log.is_active())
+    {
+        return {"There is no current stint. Use -p to note the last stint."};
+    }
+    auto const key = m_time_log.last_entry_time(m_previous ? 1 : 0);
+    if (key == TimePoint::min())
+    {
+        return {"There is no such stint."};
+    }
+    NoteStore note_store
+    (   p_config.path_to_notes(),
+        p_config.time_format(),
+        p_config.formatted_buf_len()
+    );
+    if (p_ordinary_args.empty())
+    {
+        for (auto const& note: note_store.notes_within(key, key + std::chrono::seconds(1)))
+        {
+            p_ordinary_ostream << note << endl;
+        }
+        return {};
+    }
+    try
+    {
+        note_store.add(key, squish(p_ordinary_args.begin(), p_ordinary_args.end()));
+    }
+    catch (runtime_error& e)
+    {
+        return {e.what()};
+    }
+    return {};
+}
+
+}  // namespace swx
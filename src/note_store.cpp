@@ -0,0 +1,283 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "note_store.hpp"
+#include "atomic_writer.hpp"
+#include "file_utilities.hpp"
+#include "profiler.hpp"
+#include "stream_utilities.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::chrono::duration_cast;
+using std::getline;
+using std::ifstream;
+using std::ios;
+using std::istringstream;
+using std::lower_bound;
+using std::ofstream;
+using std::ostringstream;
+using std::runtime_error;
+using std::size_t;
+using std::stable_sort;
+using std::string;
+using std::to_string;
+using std::upper_bound;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    long long to_seconds(TimePoint const& p_time_point)
+    {
+        return duration_cast<std::chrono::seconds>(p_time_point.time_since_epoch()).count();
+    }
+
+    string file_status_to_string(FileStatus const& p_status)
+    {
+        return to_string(p_status.inode) + ' ' + to_string(p_status.size) + ' ' +
+            to_string(p_status.modification_nanoseconds);
+    }
+
+    // Return true if the file at p_filepath, of p_size bytes, is non-empty
+    // and does not end with a newline.
+    bool lacks_final_newline(string const& p_filepath, unsigned long long p_size)
+    {
+        if (p_size == 0) return false;
+        ifstream infile(p_filepath.c_str(), ios::binary);
+        infile.seekg(p_size - 1);
+        char c = '\n';
+        if (!infile.get(c))
+        {
+            throw runtime_error("Could not read notes file at " + p_filepath);
+        }
+        return c != '\n';
+    }
+
+}  // end anonymous namespace
+
+NoteStore::NoteStore
+(   string const& p_filepath,
+    string const& p_time_format,
+    unsigned int p_formatted_buf_len
+):
+    m_filepath(p_filepath),
+    m_index_filepath(p_filepath + ".index"),
+    m_time_format(p_time_format),
+    m_formatted_buf_len(p_formatted_buf_len),
+    m_stamp_length(time_point_to_stamp(now(), p_time_format, p_formatted_buf_len).length())
+{
+}
+
+NoteStore::~NoteStore() = default;
+
+void
+NoteStore::add(TimePoint const& p_key, string const& p_text)
+{
+    if (p_text.empty())
+    {
+        throw runtime_error("Note must not be empty.");
+    }
+    if (p_text.find('\n') != string::npos)
+    {
+        throw runtime_error("Note must not span more than one line.");
+    }
+
+    // The offset of the new note depends on the file as it is now, which
+    // may have been changed by other means since the index was loaded; in
+    // which case the index is loaded afresh.
+    FileStatus status;
+    get_file_status(m_filepath, status);
+    if (status != m_status)
+    {
+        m_index_loaded = false;
+    }
+    load_index();
+
+    // A file edited by other means may lack a final newline, in which case
+    // one is written first, so that the note starts a line of its own.
+    string const separator = (lacks_final_newline(m_filepath, m_status.size) ? "\n" : "");
+    auto const stamp = time_point_to_stamp(p_key, m_time_format, m_formatted_buf_len);
+    IndexEntry entry;
+    entry.key_seconds = to_seconds(p_key);
+    entry.offset = m_status.size + separator.length() + stamp.length() + 1;
+    {
+        ofstream outfile(m_filepath.c_str(), ios::app);
+        if (!outfile)
+        {
+            throw runtime_error("Could not open notes file at " + m_filepath);
+        }
+        outfile << separator << stamp << ' ' << p_text << '\n';
+        if (!outfile)
+        {
+            throw runtime_error("Could not write to notes file at " + m_filepath);
+        }
+    }
+    auto const position = upper_bound
+    (   m_index.begin(),
+        m_index.end(),
+        entry,
+        [](IndexEntry const& lhs, IndexEntry const& rhs)
+        {
+            return lhs.key_seconds < rhs.key_seconds;
+        }
+    );
+    m_index.insert(position, entry);
+    get_file_status(m_filepath, m_status);
+    save_index();
+}
+
+vector<string>
+NoteStore::notes_within(TimePoint const& p_beginning, TimePoint const& p_ending)
+{
+    load_index();
+    vector<string> ret;
+    auto const beginning_seconds = to_seconds(p_beginning);
+    auto const ending_seconds = to_seconds(p_ending);
+    auto it = lower_bound
+    (   m_index.begin(),
+        m_index.end(),
+        beginning_seconds,
+        [](IndexEntry const& lhs, long long rhs) { return lhs.key_seconds < rhs; }
+    );
+    if ((it == m_index.end()) || (it->key_seconds >= ending_seconds))
+    {
+        return ret;
+    }
+    ifstream infile(m_filepath.c_str());
+    if (!infile)
+    {
+        throw runtime_error("Could not open notes file at " + m_filepath);
+    }
+    for ( ; (it != m_index.end()) && (it->key_seconds < ending_seconds); ++it)
+    {
+        string text;
+        infile.seekg(it->offset);
+        if (!getline(infile, text))
+        {
+            throw runtime_error("Could not read notes file at " + m_filepath);
+        }
+        ret.push_back(text);
+    }
+    return ret;
+}
+
+void
+NoteStore::load_index()
+{
+    if (m_index_loaded) return;
+    Profiler::Phase const phase("load notes index");
+    m_index.clear();
+    m_status = FileStatus();
+    if (get_file_status(m_filepath, m_status) && !read_index())
+    {
+        rebuild_index();
+        save_index();
+    }
+    m_index_loaded = true;
+}
+
+bool
+NoteStore::read_index()
+{
+    ifstream infile(m_index_filepath.c_str());
+    if (!infile) return false;
+    string line;
+    if (!getline(infile, line)) return false;
+    istringstream iss(line);
+    string tag;
+    FileStatus status;
+    if (!(iss >> tag >> status.inode >> status.size >> status.modification_nanoseconds))
+    {
+        return false;
+    }
+    if ((tag != "notes") || (status != m_status)) return false;
+    vector<IndexEntry> index;
+    IndexEntry entry;
+    while (infile >> entry.key_seconds >> entry.offset)
+    {
+        if (entry.offset >= m_status.size) return false;
+        index.push_back(entry);
+    }
+    if (!infile.eof()) return false;
+    m_index.swap(index);
+    return true;
+}
+
+void
+NoteStore::rebuild_index()
+{
+    Profiler::Phase const phase("rebuild notes index");
+    ifstream infile(m_filepath.c_str());
+    if (!infile)
+    {
+        throw runtime_error("Could not open notes file at " + m_filepath);
+    }
+    m_index.clear();
+    string line;
+    unsigned long long offset = 0;
+    for (size_t line_number = 1; getline(infile, line); ++line_number)
+    {
+        if (line.size() <= m_stamp_length)
+        {
+            ostringstream oss;
+            enable_exceptions(oss);
+            oss << "Error parsing the notes file at line " << line_number << '.';
+            throw runtime_error(oss.str());
+        }
+        auto const key = long_time_stamp_to_point(line.substr(0, m_stamp_length), m_time_format);
+        IndexEntry entry;
+        entry.key_seconds = to_seconds(key);
+        entry.offset = offset + m_stamp_length + 1;
+        m_index.push_back(entry);
+        offset += line.size() + 1;
+    }
+    stable_sort
+    (   m_index.begin(),
+        m_index.end(),
+        [](IndexEntry const& lhs, IndexEntry const& rhs)
+        {
+            return lhs.key_seconds < rhs.key_seconds;
+        }
+    );
+}
+
+void
+NoteStore::save_index()
+{
+    ostringstream oss;
+    enable_exceptions(oss);
+    oss << "notes " << file_status_to_string(m_status) << '\n';
+    for (auto const& entry: m_index)
+    {
+        oss << entry.key_seconds << ' ' << entry.offset << '\n';
+    }
+    AtomicWriter writer(m_index_filepath);
+    writer.append(oss.str());
+    writer.commit();
+}
+
+}  // namespace swx
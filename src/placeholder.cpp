@@ -58,16 +58,11 @@ namespace
         TimeLog& p_time_log
     )
     {
-        size_t depth = 0;
-        if (p_str.empty())
+        if (!is_placeholder(p_str))
         {
             return false;
         }
-        for (char c: p_str)
-        {
-            if (c == k_tree_traversal_char) ++depth;
-            else return false;
-        }
+        size_t depth = p_str.size();
         if (p_time_log.is_active())
         {
             auto const last_activities = p_time_log.last_activities(1);
@@ -92,6 +87,20 @@ namespace
 
 }  // end anonymous namespace
 
+bool
+is_placeholder(string const& p_str)
+{
+    if (p_str.empty())
+    {
+        return false;
+    }
+    for (char c: p_str)
+    {
+        if (c != k_tree_traversal_char) return false;
+    }
+    return true;
+}
+
 string
 expand_placeholders(vector<string> const& p_components, TimeLog& p_time_log)
 {
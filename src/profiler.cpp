@@ -0,0 +1,331 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler.hpp"
+#include "stream_flag_guard.hpp"
+#include "stream_utilities.hpp"
+#include <sys/resource.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::array;
+using std::atomic;
+using std::endl;
+using std::fixed;
+using std::left;
+using std::lock_guard;
+using std::map;
+using std::memory_order_relaxed;
+using std::mutex;
+using std::ofstream;
+using std::ostream;
+using std::right;
+using std::runtime_error;
+using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+
+namespace
+{
+    using Clock = chrono::steady_clock;
+
+    struct PhaseRecord
+    {
+        char const* name;
+        Clock::time_point beginning;
+        Clock::duration duration;
+        std::thread::id thread_id;
+        unsigned long long allocations;
+        unsigned long long bytes_allocated;
+    };
+
+    size_t const k_num_counters = static_cast<size_t>(Profiler::Counter::num_counters);
+
+    char const* const k_counter_names[k_num_counters] =
+    {   "bytes read",
+        "lines parsed",
+        "strptime calls",
+        "distinct activities",
+        "stints produced",
+        "bytes written",
+        "allocations",
+        "bytes allocated"
+    };
+
+    // Allocations are only counted when the replacement operator new is
+    // built in, so the allocation counters are only shown then.
+#   ifdef SWX_ALLOC_STATS
+        bool const k_show_allocations = true;
+#   else
+        bool const k_show_allocations = false;
+#   endif
+    size_t const k_num_shown_counters =
+        k_show_allocations ?
+        k_num_counters :
+        static_cast<size_t>(Profiler::Counter::allocations);
+
+    Clock::time_point s_start;
+    mutex s_phases_mutex;
+    vector<PhaseRecord> s_phases;
+    array<atomic<unsigned long long>, k_num_counters> s_counters;
+
+    // The innermost Phase in progress on each thread.
+    thread_local Profiler::Phase* t_current_phase = nullptr;
+
+    double to_milliseconds(Clock::duration p_duration)
+    {
+        return chrono::duration<double, std::milli>(p_duration).count();
+    }
+
+    long long to_microseconds(Clock::duration p_duration)
+    {
+        return chrono::duration_cast<chrono::microseconds>(p_duration).count();
+    }
+
+    long peak_rss_kilobytes()
+    {
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        return usage.ru_maxrss;  // in kilobytes on Linux
+    }
+
+    void write_json_string(ostream& p_os, string const& p_str)
+    {
+        p_os << '"';
+        for (auto const c: p_str)
+        {
+            if (c == '"' || c == '\\') p_os << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) p_os << ' ';
+            else p_os << c;
+        }
+        p_os << '"';
+    }
+
+}  // end anonymous namespace
+
+bool Profiler::s_enabled = false;
+
+void
+Profiler::enable()
+{
+    for (auto& counter: s_counters) counter.store(0, memory_order_relaxed);
+    s_start = Clock::now();
+    s_enabled = true;
+}
+
+void
+Profiler::do_count(Counter p_counter, unsigned long long p_amount)
+{
+    s_counters[static_cast<size_t>(p_counter)].fetch_add(p_amount, memory_order_relaxed);
+}
+
+void
+Profiler::do_count_peak(Counter p_counter, unsigned long long p_value)
+{
+    auto& counter = s_counters[static_cast<size_t>(p_counter)];
+    auto current = counter.load(memory_order_relaxed);
+    while ((current < p_value) && !counter.compare_exchange_weak(current, p_value))
+    {
+    }
+}
+
+void
+Profiler::do_count_allocation(size_t p_size) noexcept
+{
+    s_counters[static_cast<size_t>(Counter::allocations)].fetch_add(1, memory_order_relaxed);
+    s_counters[static_cast<size_t>(Counter::bytes_allocated)].fetch_add
+    (   p_size,
+        memory_order_relaxed
+    );
+    if (auto const phase = t_current_phase)
+    {
+        ++phase->m_allocations;
+        phase->m_bytes_allocated += p_size;
+    }
+}
+
+void
+Profiler::Phase::begin(char const* p_name)
+{
+    PhaseRecord record
+    {   p_name,
+        Clock::now(),
+        Clock::duration::zero(),
+        std::this_thread::get_id(),
+        0,
+        0
+    };
+    {
+        lock_guard<mutex> const lock(s_phases_mutex);
+        m_index = s_phases.size();
+        s_phases.push_back(record);
+    }
+    m_parent = t_current_phase;
+    t_current_phase = this;
+}
+
+void
+Profiler::Phase::end()
+{
+    auto const ending = Clock::now();
+    t_current_phase = m_parent;
+
+    // Allocations, like time, are counted inclusive of nested phases.
+    if (m_parent)
+    {
+        m_parent->m_allocations += m_allocations;
+        m_parent->m_bytes_allocated += m_bytes_allocated;
+    }
+    lock_guard<mutex> const lock(s_phases_mutex);
+    auto& record = s_phases[m_index];
+    record.duration = ending - record.beginning;
+    record.allocations = m_allocations;
+    record.bytes_allocated = m_bytes_allocated;
+}
+
+void
+Profiler::write_summary(ostream& p_os)
+{
+    // Totals for each phase name, listed in order of first occurrence.
+    struct Totals
+    {
+        size_t calls = 0;
+        Clock::duration duration = Clock::duration::zero();
+        unsigned long long allocations = 0;
+        unsigned long long bytes_allocated = 0;
+    };
+    vector<char const*> names;
+    map<string, Totals> totals;
+    {
+        lock_guard<mutex> const lock(s_phases_mutex);
+        for (auto const& record: s_phases)
+        {
+            auto& total = totals[record.name];
+            if (total.calls == 0) names.push_back(record.name);
+            ++total.calls;
+            total.duration += record.duration;
+            total.allocations += record.allocations;
+            total.bytes_allocated += record.bytes_allocated;
+        }
+    }
+    StreamFlagGuard guard(p_os);
+    p_os << left << setw(24) << "phase" << right << setw(8) << "calls"
+         << setw(14) << "ms";
+    if (k_show_allocations) p_os << setw(14) << "allocations" << setw(16) << "bytes alloc'd";
+    p_os << endl;
+    p_os << fixed << setprecision(3);
+    for (auto const name: names)
+    {
+        auto const& total = totals[name];
+        p_os << left << setw(24) << name << right << setw(8) << total.calls
+             << setw(14) << to_milliseconds(total.duration);
+        if (k_show_allocations)
+        {
+            p_os << setw(14) << total.allocations << setw(16) << total.bytes_allocated;
+        }
+        p_os << endl;
+    }
+    p_os << left << setw(24) << "(elapsed)" << right << setw(8) << ""
+         << setw(14) << to_milliseconds(Clock::now() - s_start) << endl;
+    p_os << endl;
+    p_os << left << setw(24) << "counter" << right << setw(22) << "value" << endl;
+    for (size_t i = 0; i != k_num_shown_counters; ++i)
+    {
+        p_os << left << setw(24) << k_counter_names[i] << right << setw(22)
+             << s_counters[i].load(memory_order_relaxed) << endl;
+    }
+    p_os << left << setw(24) << "peak RSS (kB)" << right << setw(22)
+         << peak_rss_kilobytes() << endl;
+    auto const lines = counter_value(Counter::lines_parsed);
+    if (k_show_allocations && (lines != 0))
+    {
+        p_os << left << setw(24) << "allocations per entry" << right << setw(22)
+             << static_cast<double>(counter_value(Counter::allocations)) / lines << endl;
+    }
+}
+
+void
+Profiler::write_trace(string const& p_filepath)
+{
+    ofstream ofs(p_filepath.c_str());
+    if (!ofs)
+    {
+        throw runtime_error("Could not open profile file for writing: " + p_filepath);
+    }
+    enable_exceptions(ofs);
+    map<std::thread::id, size_t> thread_numbers;
+    auto const end = Clock::now();
+    ofs << "{\"traceEvents\":[";
+    {
+        lock_guard<mutex> const lock(s_phases_mutex);
+        for (size_t i = 0; i != s_phases.size(); ++i)
+        {
+            auto const& record = s_phases[i];
+            auto const thread_number = thread_numbers.emplace
+            (   record.thread_id,
+                thread_numbers.size() + 1
+            ).first->second;
+            if (i != 0) ofs << ',';
+            ofs << "\n{\"name\":";
+            write_json_string(ofs, record.name);
+            ofs << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_number
+                << ",\"ts\":" << to_microseconds(record.beginning - s_start)
+                << ",\"dur\":" << to_microseconds(record.duration);
+            if (k_show_allocations)
+            {
+                ofs << ",\"args\":{\"allocations\":" << record.allocations
+                    << ",\"bytes allocated\":" << record.bytes_allocated << '}';
+            }
+            ofs << '}';
+        }
+        if (!s_phases.empty()) ofs << ',';
+    }
+    ofs << "\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":"
+        << to_microseconds(end - s_start) << ",\"args\":{";
+    for (size_t i = 0; i != k_num_shown_counters; ++i)
+    {
+        write_json_string(ofs, k_counter_names[i]);
+        ofs << ':' << s_counters[i].load(memory_order_relaxed) << ',';
+    }
+    ofs << "\"peak RSS (kB)\":" << peak_rss_kilobytes() << "}}\n]}\n";
+}
+
+unsigned long long
+Profiler::counter_value(Counter p_counter)
+{
+    return s_counters[static_cast<size_t>(p_counter)].load(memory_order_relaxed);
+}
+
+}  // namespace swx
@@ -0,0 +1,353 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rank_command.hpp"
+#include "activity_filter.hpp"
+#include "arithmetic.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "csv_row.hpp"
+#include "help_line.hpp"
+#include "interval.hpp"
+#include "placeholder.hpp"
+#include "sliding_totals.hpp"
+#include "stint.hpp"
+#include "stream_flag_guard.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::map;
+using std::max;
+using std::ostream;
+using std::reverse;
+using std::right;
+using std::runtime_error;
+using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::string;
+using std::stringstream;
+using std::to_string;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    auto const k_date_format = "%Y-%m-%d";
+
+    bool parse_positive(string const& p_str, unsigned int& p_value)
+    {
+        stringstream ss(p_str);
+        ss >> p_value;
+        return ss && ss.eof() && (p_value != 0);
+    }
+
+}  // end anonymous namespace
+
+RankCommand::RankCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Rank the activities on which most time was spent",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print the activities on which most time was spent in the last 30 "
+                    "days (including today), from most to least"
+            ),
+            HelpLine
+            (   "Rank only ACTIVITY and its subactivities",
+                "<ACTIVITY>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"x", "exact"},
+        "Rank only the exact ACTIVITY given; not its subactivities",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::exact; }
+    );
+    add_option
+    (   vector<string>{"r", "regex"},
+        "Treat ACTIVITY as a regular expression, and rank all activities that "
+            "match it",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::regex; }
+    );
+    add_option
+    (   vector<string>{"n", "top"},
+        HelpLine("Show the N activities with most time (default 10)", "<N>"),
+        nullptr,
+        &m_top_str
+    );
+    add_option
+    (   vector<string>{"w", "window"},
+        HelpLine("Rank by the time spent in a window of N days (default 30)", "<N>"),
+        nullptr,
+        &m_window_str
+    );
+    add_option
+    (   vector<string>{"step"},
+        HelpLine
+        (   "Rather than ranking only the latest window, rank each window ending "
+                "N days after the last, from the earliest that fits, and show how "
+                "each activity has moved",
+            "<N>"
+        ),
+        nullptr,
+        &m_step_str
+    );
+    add_option
+    (   vector<string>{"f", "from"},
+        HelpLine
+        (   "With --step, begin the earliest window no earlier than TIMESTAMP "
+                "(by default the beginning of the time log)",
+            "<TIMESTAMP>"
+        ),
+        nullptr,
+        &m_since_str
+    );
+    add_option
+    (   vector<string>{"t", "to"},
+        HelpLine
+        (   "End the latest window at TIMESTAMP, or at the end of the day it falls "
+                "on (by default the end of today)",
+            "<TIMESTAMP>"
+        ),
+        nullptr,
+        &m_until_str
+    );
+    add_option
+    (   vector<string>{"csv"},
+        "Output in CSV format, with a row for each activity in each window",
+        [this]() { m_csv = true; }
+    );
+}
+
+RankCommand::~RankCommand() = default;
+
+bool
+RankCommand::does_support_placeholders() const
+{
+    return true;
+}
+
+Command::ErrorMessages
+RankCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    ErrorMessages ret;
+    unsigned int top = 0;
+    unsigned int window_days = 0;
+    unsigned int step_days = 0;
+    if (!parse_positive(m_top_str, top))
+    {
+        ret.push_back("Could not parse \"" + m_top_str + "\" as positive numeric argument.");
+    }
+    if (!parse_positive(m_window_str, window_days))
+    {
+        ret.push_back("Could not parse \"" + m_window_str + "\" as positive numeric argument.");
+    }
+    if (!m_step_str.empty() && !parse_positive(m_step_str, step_days))
+    {
+        ret.push_back("Could not parse \"" + m_step_str + "\" as positive numeric argument.");
+    }
+    auto const long_time_fmt = p_config.time_format();
+    auto const short_time_fmt = p_config.short_time_format();
+    auto until = now();
+    unique_ptr<TimePoint> since_time_point_ptr;
+    if (!m_since_str.empty())
+    {
+        try
+        {
+            since_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_since_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_since_str);
+        }
+    }
+    if (!m_until_str.empty())
+    {
+        try
+        {
+            until = time_stamp_to_point(m_until_str, long_time_fmt, short_time_fmt);
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_until_str);
+        }
+    }
+    if (!ret.empty())
+    {
+        return ret;
+    }
+
+    string comparitor;
+    auto filter_type = m_activity_filter_type;
+    if (p_ordinary_args.empty())
+    {
+        filter_type = ActivityFilter::Type::always_true;
+    }
+    else
+    {
+        comparitor = expand_placeholders(p_ordinary_args, m_time_log);
+    }
+    unique_ptr<ActivityFilter> const
+        filter(ActivityFilter::create(comparitor, filter_type));
+
+    // Windows consist of whole days, the last ending at the end of the day
+    // of "until" (or at "until" itself, if that is midnight).
+    auto const last_ending = (day_begin(until) == until) ? until : day_end(until);
+    auto const window_length = -static_cast<int>(window_days);
+    vector<TimePoint> endings{last_ending};
+    vector<Stint> stints;
+    if (step_days == 0)
+    {
+        auto const beginning = day_begin(last_ending, window_length);
+        stints = m_time_log.get_stints(*filter, &beginning, &last_ending);
+    }
+    else
+    {
+        stints = m_time_log.get_stints(*filter, since_time_point_ptr.get(), &last_ending);
+        auto earliest = last_ending;
+        if (since_time_point_ptr) earliest = day_begin(*since_time_point_ptr);
+        else if (!stints.empty()) earliest = day_begin(stints.front().interval().beginning());
+        for (int i = 1; ; ++i)
+        {
+            auto const ending = day_begin(last_ending, -static_cast<int>(i * step_days));
+            if (day_begin(ending, window_length) < earliest) break;
+            endings.push_back(ending);
+        }
+        reverse(endings.begin(), endings.end());
+    }
+
+    auto const to_rounded_hours = [&p_config](unsigned long long p_seconds)
+    {
+        return round
+        (   p_seconds / 60.0 / 60.0,
+            p_config.output_rounding_numerator(),
+            p_config.output_rounding_denominator()
+        );
+    };
+    auto const buf_len = p_config.formatted_buf_len();
+    if (m_csv)
+    {
+        CsvRow header;
+        header << "from" << "to" << "rank" << "activity" << "hours";
+        p_ordinary_ostream << header;
+    }
+    SlidingTotals totals(stints);
+    map<string const*, size_t> previous_ranks;
+    bool const show_movement = (endings.size() > 1);
+    for (size_t i = 0; i != endings.size(); ++i)
+    {
+        auto const& ending = endings[i];
+        auto const beginning = day_begin(ending, window_length);
+        totals.move_to(beginning, ending);
+        auto const ranking = totals.top(top);
+        auto const from_str = time_point_to_stamp(beginning, k_date_format, buf_len);
+        auto const to_str = time_point_to_stamp(day_begin(ending, -1), k_date_format, buf_len);
+        map<string const*, size_t> ranks;
+        for (size_t j = 0; j != ranking.size(); ++j) ranks[ranking[j].first] = j + 1;
+
+        if (m_csv)
+        {
+            for (size_t j = 0; j != ranking.size(); ++j)
+            {
+                CsvRow row;
+                row << from_str << to_str << (j + 1) << *ranking[j].first
+                    << to_rounded_hours(ranking[j].second);
+                p_ordinary_ostream << row;
+            }
+        }
+        else
+        {
+            if (i != 0) p_ordinary_ostream << endl;
+            p_ordinary_ostream << from_str << " to " << to_str << ':' << endl;
+            string::size_type activity_width = 0;
+            for (auto const& entry: ranking)
+            {
+                activity_width = max(activity_width, entry.first->length());
+            }
+            auto const rank_width = to_string(ranking.size()).length();
+            for (size_t j = 0; j != ranking.size(); ++j)
+            {
+                auto const& entry = ranking[j];
+                StreamFlagGuard guard(p_ordinary_ostream);
+                p_ordinary_ostream
+                    << right << setw(rank_width) << (j + 1) << "  "
+                    << left << setw(activity_width) << *entry.first << ' '
+                    << right << setw(p_config.output_width())
+                    << fixed << setprecision(p_config.output_precision())
+                    << to_rounded_hours(entry.second);
+                guard.reset();
+                if (show_movement && (i != 0))
+                {
+                    auto const it = previous_ranks.find(entry.first);
+                    p_ordinary_ostream << "  ";
+                    if (it == previous_ranks.end())
+                    {
+                        p_ordinary_ostream << "(new)";
+                    }
+                    else if (it->second == j + 1)
+                    {
+                        p_ordinary_ostream << "(=)";
+                    }
+                    else if (it->second > j + 1)
+                    {
+                        p_ordinary_ostream << "(+" << (it->second - j - 1) << ')';
+                    }
+                    else
+                    {
+                        p_ordinary_ostream << "(-" << (j + 1 - it->second) << ')';
+                    }
+                }
+                p_ordinary_ostream << endl;
+            }
+        }
+        previous_ranks.swap(ranks);
+    }
+    return ret;
+}
+
+}  // namespace swx
@@ -15,17 +15,28 @@
  */
 
 #include "recording_command.hpp"
+#include "arithmetic.hpp"
 #include "command.hpp"
+#include "config.hpp"
+#include "goal_tracker.hpp"
 #include "help_line.hpp"
 #include "result.hpp"
 #include "time_log.hpp"
 #include "time_point.hpp"
+#include <iomanip>
+#include <memory>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+using std::endl;
+using std::fixed;
+using std::ostream;
 using std::runtime_error;
+using std::setprecision;
 using std::string;
+using std::unique_ptr;
 using std::vector;
 
 namespace swx
@@ -82,4 +93,52 @@ RecordingCommand::time_log()
     return m_time_log;
 }
 
+unique_ptr<GoalTracker>
+RecordingCommand::track_goals(Config const& p_config, ostream& p_ostream)
+{
+    try
+    {
+        return unique_ptr<GoalTracker>
+        (   new GoalTracker(p_config.path_to_goals(), p_config.path_to_log(), m_time_log)
+        );
+    }
+    catch (runtime_error& e)
+    {
+        p_ostream << "Warning: goals not tracked. " << e.what() << endl;
+        return nullptr;
+    }
+}
+
+void
+RecordingCommand::report_goals
+(   Config const& p_config,
+    unique_ptr<GoalTracker> const& p_goal_tracker,
+    ostream& p_ostream
+)
+{
+    if (!p_goal_tracker || p_goal_tracker->goals().empty()) return;
+    auto const time_point = now();
+    try
+    {
+        p_goal_tracker->update(time_point);
+    }
+    catch (runtime_error& e)
+    {
+        p_ostream << "Warning: goals not tracked. " << e.what() << endl;
+        return;
+    }
+    for (auto const& status: p_goal_tracker->statuses(time_point))
+    {
+        if (!status.goal->is_maximum || !status.is_crossed()) continue;
+        auto const hours = round
+        (   status.seconds / 60.0 / 60.0,
+            p_config.output_rounding_numerator(),
+            p_config.output_rounding_denominator()
+        );
+        p_ostream << "Warning: over budget for \"" << status.goal->description
+                  << "\": " << fixed << setprecision(p_config.output_precision())
+                  << hours << " hours so far." << endl;
+    }
+}
+
 }  // namespace swx
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "recurring_window.hpp"
+#include "string_utilities.hpp"
+#include "time_point.hpp"
+#include <cctype>
+#include <cstddef>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::isdigit;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::tm;
+using std::tolower;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    int const k_minutes_per_day = 24 * 60;
+    unsigned int const k_all_days = (1 << 7) - 1;
+
+    // Returns the number of the day of the week named by p_name, counting
+    // from Sunday, or -1 if it names none.
+    int parse_day(string const& p_name)
+    {
+        static char const* const names[] =
+            { "sun", "mon", "tue", "wed", "thu", "fri", "sat" };
+        if (p_name.size() != 3) return -1;
+        string lower;
+        for (auto c: p_name) lower.push_back(static_cast<char>(tolower(c)));
+        for (int i = 0; i != 7; ++i)
+        {
+            if (lower == names[i]) return i;
+        }
+        return -1;
+    }
+
+    bool parse_days(string const& p_str, unsigned int& p_days)
+    {
+        p_days = 0;
+        for (auto const& item: split(p_str, ','))
+        {
+            auto const dash_pos = item.find('-');
+            auto const first = parse_day(item.substr(0, dash_pos));
+            auto const last =
+                (dash_pos == string::npos) ? first : parse_day(item.substr(dash_pos + 1));
+            if ((first < 0) || (last < 0)) return false;
+            for (int day = first; ; day = (day + 1) % 7)
+            {
+                p_days |= (1 << day);
+                if (day == last) break;
+            }
+        }
+        return true;
+    }
+
+    // Parses "HH:MM", where HH may be at most 24, into minutes past
+    // midnight.
+    bool parse_time(string const& p_str, int& p_minutes)
+    {
+        if ((p_str.size() != 5) || (p_str[2] != ':')) return false;
+        for (size_t i: {0, 1, 3, 4})
+        {
+            if (!isdigit(static_cast<unsigned char>(p_str[i]))) return false;
+        }
+        auto const hours = (p_str[0] - '0') * 10 + (p_str[1] - '0');
+        auto const minutes = (p_str[3] - '0') * 10 + (p_str[4] - '0');
+        p_minutes = hours * 60 + minutes;
+        return (minutes < 60) && (p_minutes <= k_minutes_per_day);
+    }
+
+    bool parse_times(string const& p_str, int& p_beginning, int& p_ending)
+    {
+        auto const dash_pos = p_str.find('-');
+        return
+            (dash_pos != string::npos) &&
+            parse_time(p_str.substr(0, dash_pos), p_beginning) &&
+            parse_time(p_str.substr(dash_pos + 1), p_ending);
+    }
+
+    TimePoint minutes_into(TimePoint const& p_day_beginning, int p_minutes)
+    {
+        // Via tm, so that the time is right on days when the clocks change.
+        tm time_tm = time_point_to_tm(p_day_beginning);
+        time_tm.tm_hour = 0;
+        time_tm.tm_min = p_minutes;
+        time_tm.tm_sec = 0;
+        time_tm.tm_isdst = -1;
+        return tm_to_time_point(time_tm);
+    }
+
+}  // end anonymous namespace
+
+RecurringWindow::RecurringWindow(string const& p_spec)
+{
+    auto const error_message = "Could not parse time window: " + p_spec;
+    auto const words = split(squash(p_spec));
+    if (words.empty() || words.front().empty() || (words.size() > 2))
+    {
+        throw runtime_error(error_message);
+    }
+    m_days = k_all_days;
+    auto const& last = words.back();
+    auto const has_times = isdigit(static_cast<unsigned char>(last[0]));
+    if (has_times && !parse_times(last, m_beginning_minutes, m_ending_minutes))
+    {
+        throw runtime_error(error_message);
+    }
+    if ((words.size() == 2) && !has_times)
+    {
+        throw runtime_error(error_message);
+    }
+    if (((words.size() == 2) || !has_times) && !parse_days(words.front(), m_days))
+    {
+        throw runtime_error(error_message);
+    }
+    if (m_ending_minutes <= m_beginning_minutes)
+    {
+        m_ending_minutes += k_minutes_per_day;
+    }
+}
+
+bool
+RecurringWindow::occurs_on
+(   TimePoint const& p_day_beginning,
+    TimePoint& p_beginning,
+    TimePoint& p_ending
+) const
+{
+    auto const day = time_point_to_tm(p_day_beginning).tm_wday;
+    if (!(m_days & (1 << day))) return false;
+    p_beginning = minutes_into(p_day_beginning, m_beginning_minutes);
+    p_ending = minutes_into(p_day_beginning, m_ending_minutes);
+    return p_beginning < p_ending;
+}
+
+}  // namespace swx
@@ -17,11 +17,14 @@
 #include "report_writer.hpp"
 #include "arithmetic.hpp"
 #include "config.hpp"
+#include "csv_bucket_report_writer.hpp"
 #include "csv_list_report_writer.hpp"
 #include "csv_summary_report_writer.hpp"
+#include "human_bucket_report_writer.hpp"
 #include "human_list_report_writer.hpp"
 #include "human_summary_report_writer.hpp"
 #include "interval.hpp"
+#include "profiler.hpp"
 #include "stint.hpp"
 #include <ostream>
 #include <string>
@@ -43,10 +46,15 @@ ReportWriter::create
 {
     auto const csv = (p_flags & Flags::csv);
     auto const show_stints = (p_flags & Flags::show_stints);
+    auto const by_period = (p_flags & Flags::by_period);
     if (csv && show_stints)
     {
         return new CsvListReportWriter(p_stints, p_options);
     }
+    else if (csv && by_period)
+    {
+        return new CsvBucketReportWriter(p_stints, p_options, p_flags);
+    }
     else if (csv)
     {
         return new CsvSummaryReportWriter(p_stints, p_options, p_flags);
@@ -55,6 +63,10 @@ ReportWriter::create
     {
         return new HumanListReportWriter(p_stints, p_options);
     }
+    else if (by_period)
+    {
+        return new HumanBucketReportWriter(p_stints, p_options, p_flags);
+    }
     else
     {
         return new HumanSummaryReportWriter(p_stints, p_options, p_flags);
@@ -114,6 +126,24 @@ ReportWriter::depth() const
     return m_options.depth;
 }
 
+vector<ReportWriter::Period> const&
+ReportWriter::comparison_periods() const
+{
+    return m_options.comparison_periods;
+}
+
+bool
+ReportWriter::shows_notes() const
+{
+    return static_cast<bool>(m_options.note_lookup);
+}
+
+vector<string>
+ReportWriter::notes(Interval const& p_interval) const
+{
+    return shows_notes() ? m_options.note_lookup(p_interval) : vector<string>();
+}
+
 double
 ReportWriter::seconds_to_rounded_hours(unsigned long long p_seconds) const
 {
@@ -133,9 +163,25 @@ ReportWriter::round_hours(Interval const& p_interval) const
 void
 ReportWriter::write(ostream& p_os)
 {
+    {
+        Profiler::Phase const phase("report: process stints");
         do_preprocess_stints(p_os, m_stints);
         for (auto const& stint: m_stints) do_process_stint(p_os, stint);
-        do_postprocess_stints(p_os, m_stints);
+    }
+    Profiler::Phase const phase("report: postprocess");
+    do_postprocess_stints(p_os, m_stints);
+}
+
+void
+ReportWriter::write(ostream& p_os, StintStream const& p_stints)
+{
+    {
+        Profiler::Phase const phase("report: process stints");
+        do_preprocess_stints(p_os, m_stints);
+        p_stints([this, &p_os](Stint const& p_stint) { do_process_stint(p_os, p_stint); });
+    }
+    Profiler::Phase const phase("report: postprocess");
+    do_postprocess_stints(p_os, m_stints);
 }
 
 void
@@ -160,7 +206,9 @@ ReportWriter::Options::Options
     unsigned int p_output_width,
     unsigned int p_formatted_buf_len,
     string const& p_time_format,
-    unsigned int p_depth
+    unsigned int p_depth,
+    vector<Period> const& p_comparison_periods,
+    NoteLookup const& p_note_lookup
 ):
     output_rounding_numerator(p_output_rounding_numerator),
     output_rounding_denominator(p_output_rounding_denominator),
@@ -168,7 +216,9 @@ ReportWriter::Options::Options
     output_width(p_output_width),
     formatted_buf_len(p_formatted_buf_len),
     time_format(p_time_format),
-    depth(p_depth)
+    depth(p_depth),
+    comparison_periods(p_comparison_periods),
+    note_lookup(p_note_lookup)
 {
 }
 
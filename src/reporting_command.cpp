@@ -19,21 +19,37 @@
 #include "command.hpp"
 #include "config.hpp"
 #include "help_line.hpp"
+#include "interval.hpp"
 #include "list_report_writer.hpp"
+#include "merged_time_logs.hpp"
+#include "note_store.hpp"
 #include "placeholder.hpp"
+#include "recurring_window.hpp"
 #include "stream_utilities.hpp"
+#include "stint.hpp"
+#include "stint_query.hpp"
 #include "summary_report_writer.hpp"
 #include "time_log.hpp"
+#include "time_point.hpp"
+#include "time_windows.hpp"
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <ostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+using std::any_of;
 using std::endl;
+using std::function;
+using std::max;
+using std::min;
 using std::ostream;
 using std::ostringstream;
+using std::runtime_error;
 using std::string;
 using std::stringstream;
 using std::unique_ptr;
@@ -87,6 +103,12 @@ ReportingCommand::ReportingCommand
         [this]() { m_report_flags |= ReportWriter::Flags::show_stints; }
     );
 
+    add_option
+    (   vector<string>{"notes"},
+        "With -l, show the notes on each stint (see the \"note\" command)",
+        [this]() { m_show_notes = true; }
+    );
+
     add_option
     (   vector<string>{"b", "beginning"},
         "In addition to any other information, output the earliest time at "
@@ -103,6 +125,15 @@ ReportingCommand::ReportingCommand
         [this]() { m_report_flags |= ReportWriter::Flags::include_ending; }
     );
 
+    add_option
+    (   vector<string>{"durations"},
+        "In addition to any other information, output the number of stints "
+            "spent on each activity, and their mean, median, 90th and 99th "
+            "percentile and longest length, in hours; percentiles are estimated "
+            "to within 1% (ignored in list mode)",
+        [this]() { m_report_flags |= ReportWriter::Flags::durations; }
+    );
+
     add_option
     (   vector<string>{"depth"},
         HelpLine
@@ -132,6 +163,79 @@ ReportingCommand::ReportingCommand
         "Succinct output: show grand total only (ignored in list mode)",
         [this]() { m_report_flags |= ReportWriter::Flags::succinct; }
     );
+
+    add_option
+    (   vector<string>{"bucket"},
+        HelpLine
+        (   "Show the time spent on each activity in each calendar day, week "
+                "(beginning Monday) or month of the relevant period, as a table "
+                "with a column for each; PERIOD may be \"day\", \"week\" or "
+                "\"month\" (ignored in list mode)",
+            "<PERIOD>"
+        ),
+        nullptr,
+        &m_bucket_str
+    );
+
+    add_option
+    (   vector<string>{"compare"},
+        HelpLine
+        (   "As well as the time spent on each activity during the relevant "
+                "period, show the time spent during the period from FROM to TO, "
+                "and the change from that to the relevant period; may be passed "
+                "more than once, to compare several periods (FROM or TO may be "
+                "omitted to leave the period unbounded; ignored in list mode and "
+                "with --bucket)",
+            "<[FROM]..[TO]>"
+        ),
+        &m_compare_specs
+    );
+
+    add_option
+    (   vector<string>{"within"},
+        HelpLine
+        (   "Include only time within WINDOW, such as \"Mon-Fri 09:00-17:30\"; "
+                "WINDOW consists of days of the week (a comma-separated list of "
+                "days or ranges of days), times (HH:MM-HH:MM), or both; may be "
+                "passed more than once, to include time within any of several "
+                "windows",
+            "<WINDOW>"
+        ),
+        &m_within_specs
+    );
+
+    add_option
+    (   vector<string>{"except"},
+        HelpLine
+        (   "Exclude time within WINDOW, given as for --within, such as "
+                "\"12:30-13:30\"; may be passed more than once",
+            "<WINDOW>"
+        ),
+        &m_except_specs
+    );
+
+    add_option
+    (   vector<string>{"tag"},
+        HelpLine
+        (   "Include only stints tagged with TAG; may be passed more than once, "
+                "to include only stints bearing all of the TAGs given",
+            "<TAG>"
+        ),
+        &m_tags
+    );
+
+    add_option
+    (   vector<string>{"log"},
+        HelpLine
+        (   "Report on the time log at FILE instead of the usual one; may be "
+                "passed more than once, to report on several logs together. If "
+                "LABEL is given, the activities from FILE are reported as "
+                "subactivities of LABEL. Not supported with --notes, or with "
+                "placeholders in the activity",
+            "<[LABEL=]FILE>"
+        ),
+        &m_log_specs
+    );
 }
 
 ReportingCommand::~ReportingCommand() = default;
@@ -142,12 +246,37 @@ ReportingCommand::print_report
     Config const& p_config,
     vector<string> const& p_activity_components,
     TimePoint const* p_begin,
-    TimePoint const* p_end
+    TimePoint const* p_end,
+    StintQuery* p_query
 )
 {
+    // The notes and the current activity belong to the usual time log, so
+    // have no bearing on other logs.
+    if (!m_log_specs.empty())
+    {
+        if (p_query)
+        {
+            return ErrorMessages{"The --log option is not supported by this command."};
+        }
+        if (m_show_notes)
+        {
+            return ErrorMessages{"The --notes option cannot be used with --log."};
+        }
+        if
+        (   any_of
+            (   p_activity_components.begin(),
+                p_activity_components.end(),
+                is_placeholder
+            )
+        )
+        {
+            return ErrorMessages{"Placeholders cannot be used with --log."};
+        }
+    }
+
     string comparitor;
 
-    if (p_activity_components.empty())
+    if (p_activity_components.empty() || p_query)
     {
         m_activity_filter_type = ActivityFilter::Type::always_true;
     }
@@ -158,7 +287,6 @@ ReportingCommand::print_report
 
     unique_ptr<ActivityFilter>
         filter(ActivityFilter::create(comparitor, m_activity_filter_type));
-    auto const stints = m_time_log.get_stints(*filter, p_begin, p_end);
 
     unsigned int depth = 0;
     stringstream ss(m_depth_str);
@@ -170,6 +298,91 @@ ReportingCommand::print_report
         };
     }
 
+    auto report_flags = m_report_flags;
+    if (m_bucket_str == "day") report_flags |= ReportWriter::Flags::by_day;
+    else if (m_bucket_str == "week") report_flags |= ReportWriter::Flags::by_week;
+    else if (m_bucket_str == "month") report_flags |= ReportWriter::Flags::by_month;
+    else if (!m_bucket_str.empty())
+    {
+        return ErrorMessages
+        {   "Unrecognized period \"" + m_bucket_str + "\"; expected \"day\", "
+                "\"week\" or \"month\"."
+        };
+    }
+
+    // When comparing periods, the stints read are those covering all of
+    // them, and each stint is counted in each period it overlaps, so that
+    // there is still a single pass over the time log.
+    vector<ReportWriter::Period> comparison_periods;
+    auto const compare =
+        !m_compare_specs.empty() &&
+        !(report_flags & (ReportWriter::Flags::show_stints | ReportWriter::Flags::by_period));
+    if (compare)
+    {
+        comparison_periods.push_back
+        (   ReportWriter::Period
+            (   (p_begin ? *p_begin : TimePoint::min()),
+                (p_end ? *p_end : TimePoint::max())
+            )
+        );
+        for (auto const& spec: m_compare_specs)
+        {
+            ReportWriter::Period period;
+            if (!parse_period(spec, p_config, period))
+            {
+                return ErrorMessages
+                {   "Could not parse period \"" + spec + "\"; expected "
+                        "FROM..TO, where FROM and TO are timestamps."
+                };
+            }
+            comparison_periods.push_back(period);
+        }
+    }
+    TimePoint union_begin = TimePoint::max();
+    TimePoint union_end = TimePoint::min();
+    for (auto const& period: comparison_periods)
+    {
+        union_begin = min(union_begin, period.first);
+        union_end = max(union_end, period.second);
+    }
+    if (compare)
+    {
+        p_begin = (union_begin == TimePoint::min()) ? nullptr : &union_begin;
+        p_end = (union_end == TimePoint::max()) ? nullptr : &union_end;
+    }
+
+    vector<RecurringWindow> within;
+    vector<RecurringWindow> except;
+    try
+    {
+        for (auto const& spec: m_within_specs) within.push_back(RecurringWindow(spec));
+        for (auto const& spec: m_except_specs) except.push_back(RecurringWindow(spec));
+    }
+    catch (runtime_error& e)
+    {
+        return ErrorMessages{e.what()};
+    }
+    TimeWindows windows(within, except);
+
+    // The notes are read only if they are to be shown, and then only those
+    // on the stints listed.
+    unique_ptr<NoteStore> note_store;
+    ReportWriter::NoteLookup note_lookup;
+    if (m_show_notes && (report_flags & ReportWriter::Flags::show_stints))
+    {
+        note_store.reset
+        (   new NoteStore
+            (   p_config.path_to_notes(),
+                p_config.time_format(),
+                p_config.formatted_buf_len()
+            )
+        );
+        note_lookup = [&note_store](Interval const& p_interval)
+        {
+            return note_store->notes_within(p_interval.beginning(), p_interval.ending());
+        };
+    }
+
     ReportWriter::Options const options
     (   p_config.output_rounding_numerator(),
         p_config.output_rounding_denominator(),
@@ -177,16 +390,107 @@ ReportingCommand::print_report
         p_config.output_width(),
         p_config.formatted_buf_len(),
         p_config.time_format(),
-        depth
+        depth,
+        comparison_periods,
+        note_lookup
     );
 
+    if (!m_log_specs.empty())
+    {
+        vector<MergedTimeLogs::Source> sources;
+        for (auto const& spec: m_log_specs)
+        {
+            sources.push_back(MergedTimeLogs::parse_source(spec));
+        }
+        MergedTimeLogs const logs
+        (   sources,
+            p_config.time_format(),
+            p_config.formatted_buf_len()
+        );
+        vector<Stint> const no_stints;
+        unique_ptr<ReportWriter>
+            report_writer(ReportWriter::create(no_stints, options, report_flags));
+        report_writer->write
+        (   p_os,
+            [&](function<void(Stint const&)> const& p_sink)
+            {
+                logs.for_each_stint
+                (   *filter,
+                    p_begin,
+                    p_end,
+                    m_tags,
+                    [&](Stint const& p_stint) { windows.restrict(p_stint, p_sink); }
+                );
+            }
+        );
+        return ErrorMessages{};
+    }
+
+    vector<Stint> stints;
+    if (p_query)
+    {
+        auto const predicate =
+            [p_query](string const& p_activity, Interval const& p_interval, string const* p_tags)
+        {
+            return !p_activity.empty() && p_query->matches(p_activity, p_interval, p_tags);
+        };
+        stints = m_time_log.get_stints(predicate, p_begin, p_end, m_tags);
+    }
+    else
+    {
+        stints = m_time_log.get_stints(*filter, p_begin, p_end, m_tags);
+    }
+    if (!windows.is_unrestricted())
+    {
+        vector<Stint> restricted;
+        for (auto const& stint: stints)
+        {
+            windows.restrict
+            (   stint,
+                [&restricted](Stint const& p_part) { restricted.push_back(p_part); }
+            );
+        }
+        stints.swap(restricted);
+    }
     unique_ptr<ReportWriter>
-        report_writer(ReportWriter::create(stints, options, m_report_flags));
+        report_writer(ReportWriter::create(stints, options, report_flags));
     report_writer->write(p_os);
 
     return ErrorMessages{};
 }
 
+bool
+ReportingCommand::parse_period
+(   string const& p_spec,
+    Config const& p_config,
+    ReportWriter::Period& p_period
+) const
+{
+    auto const separator_pos = p_spec.find("..");
+    if (separator_pos == string::npos) return false;
+    auto const from_str = p_spec.substr(0, separator_pos);
+    auto const to_str = p_spec.substr(separator_pos + 2);
+    p_period = ReportWriter::Period(TimePoint::min(), TimePoint::max());
+    try
+    {
+        auto const long_time_fmt = p_config.time_format();
+        auto const short_time_fmt = p_config.short_time_format();
+        if (!from_str.empty())
+        {
+            p_period.first = time_stamp_to_point(from_str, long_time_fmt, short_time_fmt);
+        }
+        if (!to_str.empty())
+        {
+            p_period.second = time_stamp_to_point(to_str, long_time_fmt, short_time_fmt);
+        }
+    }
+    catch (runtime_error&)
+    {
+        return false;
+    }
+    return p_period.first < p_period.second;
+}
+
 bool
 ReportingCommand::does_support_placeholders() const
 {
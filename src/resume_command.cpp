@@ -78,9 +78,10 @@ ResumeCommand::do_process
     ostream& p_ordinary_ostream
 )
 {
-    (void)p_ordinary_args; (void)p_config;  // silence compiler re. unused params
+    (void)p_ordinary_args;  // silence compiler re. unused param
 
     ErrorMessages ret;
+    auto const goal_tracker = track_goals(p_config, p_ordinary_ostream);
     bool const is_active = time_log().is_active();
     auto const last_activities = time_log().last_activities(2);
 
@@ -124,6 +125,7 @@ ResumeCommand::do_process
         time_log().append_entry(activity, tp);
         p_ordinary_ostream << "Resumed \"" << activity << "\" at "
                            << confirmed_stamp << '.' << endl;
+        report_goals(p_config, goal_tracker, p_ordinary_ostream);
     }
     else if (last_activities.size() == 1)
     {
@@ -138,6 +140,7 @@ ResumeCommand::do_process
         time_log().append_entry(activity, tp);
         p_ordinary_ostream << "Resumed \"" << activity << "\" at "
                            << confirmed_stamp << '.' << endl;
+        report_goals(p_config, goal_tracker, p_ordinary_ostream);
     }
     return ret;
 }
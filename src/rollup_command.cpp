@@ -0,0 +1,239 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rollup_command.hpp"
+#include "atomic_writer.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "help_line.hpp"
+#include "interval.hpp"
+#include "report_writer.hpp"
+#include "stint.hpp"
+#include "team_rollup.hpp"
+#include "time_point.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::cerr;
+using std::endl;
+using std::getline;
+using std::istringstream;
+using std::ostream;
+using std::ostringstream;
+using std::string;
+using std::stringstream;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    auto const k_date_format = "%Y-%m-%d";
+
+}  // end anonymous namespace
+
+RollupCommand::RollupCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Print daily totals over a directory of time logs",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print a summary of the time spent on each activity on each day, "
+                    "summed over the time logs in DIRECTORY (being the files named "
+                    "*.swx)",
+                "<DIRECTORY>"
+            )
+        }
+    )
+{
+    add_option
+    (   vector<string>{"u", "by-user"},
+        "Instead of summing time across logs, show the activities from each log "
+            "as subactivities of the name of the log (less \".swx\")",
+        [this]() { m_label_by_user = true; }
+    );
+    add_option
+    (   vector<string>{"w", "watch"},
+        HelpLine
+        (   "Keep running, and print the summary again every N seconds; only logs "
+                "that have changed are read again, and logs that have only grown "
+                "are read only from where they were read up to",
+            "<N>"
+        ),
+        nullptr,
+        &m_watch_str
+    );
+    add_option
+    (   vector<string>{"o", "output"},
+        HelpLine
+        (   "Write the summary to FILE rather than to standard output, replacing "
+                "the contents of FILE atomically",
+            "<FILE>"
+        ),
+        nullptr,
+        &m_output_filepath
+    );
+    add_option
+    (   vector<string>{"depth"},
+        HelpLine
+        (   "Output activity tree only to depth N (ignored in succinct and verbose "
+                "mode); or if passed 0, print to any depth (the default)",
+            "<N>"
+        ),
+        nullptr,
+        &m_depth_str
+    );
+    add_option
+    (   vector<string>{"csv"},
+        "Output in CSV format, with the date in the first column",
+        [this]() { m_report_flags |= ReportWriter::Flags::csv; }
+    );
+    add_option
+    (   vector<string>{"v", "verbose"},
+        "Instead of printing the summary in \"tree\" form, print the full name of "
+            "each activity (ignored in succinct mode)",
+        [this]() { m_report_flags |= ReportWriter::Flags::verbose; }
+    );
+    add_option
+    (   vector<string>{"s", "succinct"},
+        "Succinct output: show only the total for each day",
+        [this]() { m_report_flags |= ReportWriter::Flags::succinct; }
+    );
+}
+
+RollupCommand::~RollupCommand() = default;
+
+Command::ErrorMessages
+RollupCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    if (p_ordinary_args.size() != 1)
+    {
+        return ErrorMessages{"Too few or too many arguments passed to this command."};
+    }
+    unsigned int depth = 0;
+    stringstream depth_ss(m_depth_str);
+    depth_ss >> depth;
+    if (!depth_ss)
+    {
+        return ErrorMessages{"Could not parse \"" + m_depth_str + "\" as numeric argument."};
+    }
+    unsigned int watch_seconds = 0;
+    if (!m_watch_str.empty())
+    {
+        stringstream watch_ss(m_watch_str);
+        watch_ss >> watch_seconds;
+        if (!watch_ss || (watch_seconds == 0))
+        {
+            return ErrorMessages
+            {   "Could not parse \"" + m_watch_str + "\" as positive numeric argument."
+            };
+        }
+    }
+    ReportWriter::Options const options
+    (   p_config.output_rounding_numerator(),
+        p_config.output_rounding_denominator(),
+        p_config.output_precision(),
+        p_config.output_width(),
+        p_config.formatted_buf_len(),
+        p_config.time_format(),
+        depth
+    );
+    TeamRollup rollup
+    (   p_ordinary_args[0],
+        p_config.time_format(),
+        p_config.formatted_buf_len(),
+        m_label_by_user
+    );
+    while (true)
+    {
+        auto errors = rollup.refresh();
+        if (m_output_filepath.empty())
+        {
+            write_rollups(p_ordinary_ostream, rollup.rollups(now()), options);
+        }
+        else
+        {
+            ostringstream oss;
+            write_rollups(oss, rollup.rollups(now()), options);
+            AtomicWriter writer(m_output_filepath);
+            writer.append(oss.str());
+            writer.commit();
+        }
+        if (watch_seconds == 0)
+        {
+            return errors;
+        }
+        for (auto const& error: errors) cerr << error << endl;
+        p_ordinary_ostream.flush();
+        std::this_thread::sleep_for(std::chrono::seconds(watch_seconds));
+    }
+}
+
+void
+RollupCommand::write_rollups
+(   ostream& p_os,
+    TeamRollup::Rollups const& p_rollups,
+    ReportWriter::Options const& p_options
+) const
+{
+    bool const csv = (m_report_flags & ReportWriter::Flags::csv);
+    bool first = true;
+    for (auto const& day: p_rollups)
+    {
+        vector<Stint> stints;
+        for (auto const& activity: day.second)
+        {
+            stints.push_back(Stint(activity.first, Interval(day.first, activity.second)));
+        }
+        auto const date =
+            time_point_to_stamp(day.first, k_date_format, p_options.formatted_buf_len);
+        unique_ptr<ReportWriter> const
+            report_writer(ReportWriter::create(stints, p_options, m_report_flags));
+        if (csv)
+        {
+            ostringstream oss;
+            report_writer->write(oss);
+            istringstream iss(oss.str());
+            string line;
+            while (getline(iss, line)) p_os << date << ',' << line << endl;
+        }
+        else
+        {
+            if (!first) p_os << endl;
+            p_os << date << ':' << endl;
+            report_writer->write(p_os);
+        }
+        first = false;
+    }
+}
+
+}  // namespace swx
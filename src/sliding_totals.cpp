@@ -0,0 +1,152 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sliding_totals.hpp"
+#include "interval.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <vector>
+
+using std::chrono::system_clock;
+using std::max;
+using std::min;
+using std::priority_queue;
+using std::reverse;
+using std::size_t;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    // Orders entries from most to least time, then by activity name.
+    struct Ranks
+    {
+        bool operator()(SlidingTotals::Entry const& lhs, SlidingTotals::Entry const& rhs) const
+        {
+            if (lhs.second != rhs.second) return lhs.second > rhs.second;
+            return *lhs.first < *rhs.first;
+        }
+    };
+
+}  // end anonymous namespace
+
+SlidingTotals::SlidingTotals(vector<Stint> const& p_stints): m_stints(p_stints)
+{
+}
+
+SlidingTotals::~SlidingTotals() = default;
+
+void
+SlidingTotals::move_to(TimePoint const& p_beginning, TimePoint const& p_ending)
+{
+    if (!m_is_positioned)
+    {
+        accumulate(p_beginning, p_ending, m_entering_cursor, false);
+        m_is_positioned = true;
+    }
+    else
+    {
+        assert (p_beginning >= m_beginning);
+        assert (p_ending >= m_ending);
+        accumulate(m_beginning, min(p_beginning, m_ending), m_leaving_cursor, true);
+        accumulate(max(p_beginning, m_ending), p_ending, m_entering_cursor, false);
+    }
+    m_beginning = p_beginning;
+    m_ending = p_ending;
+}
+
+vector<SlidingTotals::Entry>
+SlidingTotals::top(size_t p_k) const
+{
+    // Keep the best p_k seen so far in a heap whose top is the worst of them.
+    priority_queue<Entry, vector<Entry>, Ranks> heap;
+    if (p_k == 0) return vector<Entry>();
+    for (auto const& entry: m_totals)
+    {
+        if (heap.size() < p_k)
+        {
+            heap.push(entry);
+        }
+        else if (Ranks()(entry, heap.top()))
+        {
+            heap.pop();
+            heap.push(entry);
+        }
+    }
+    vector<Entry> ret;
+    ret.reserve(heap.size());
+    for ( ; !heap.empty(); heap.pop()) ret.push_back(heap.top());
+    reverse(ret.begin(), ret.end());
+    return ret;
+}
+
+void
+SlidingTotals::accumulate
+(   TimePoint const& p_beginning,
+    TimePoint const& p_ending,
+    size_t& p_cursor,
+    bool p_subtract
+)
+{
+    if (p_beginning >= p_ending) return;
+
+    // As the stints do not overlap, their endings are in order too; so those
+    // before the cursor, which ended before some earlier range, cannot touch
+    // this one.
+    auto const num_stints = m_stints.size();
+    while ((p_cursor != num_stints) && (m_stints[p_cursor].interval().ending() <= p_beginning))
+    {
+        ++p_cursor;
+    }
+    for (auto i = p_cursor; i != num_stints; ++i)
+    {
+        auto const& stint = m_stints[i];
+        auto const interval = stint.interval();
+        if (interval.beginning() >= p_ending) break;
+        auto const& activity = stint.activity();
+        if (activity.empty()) continue;
+        // Whole seconds are counted, each time being truncated first, so
+        // that the time added for a range always equals the sum of the
+        // time subtracted for the ranges that make it up.
+        auto const overlap =
+            system_clock::to_time_t(min(interval.ending(), p_ending)) -
+            system_clock::to_time_t(max(interval.beginning(), p_beginning));
+        if (overlap <= 0) continue;
+        if (p_subtract)
+        {
+            auto const it = m_totals.find(&activity);
+            assert (it != m_totals.end());
+            assert (it->second >= static_cast<unsigned long long>(overlap));
+            it->second -= overlap;
+            if (it->second == 0) m_totals.erase(it);
+        }
+        else
+        {
+            m_totals[&activity] += overlap;
+        }
+    }
+}
+
+}  // namespace swx
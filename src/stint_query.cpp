@@ -0,0 +1,455 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "stint_query.hpp"
+#include "activity_filter.hpp"
+#include "exact_activity_filter.hpp"
+#include "interval.hpp"
+#include "ordinary_activity_filter.hpp"
+#include "regex_activity_filter.hpp"
+#include "string_utilities.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::binary_search;
+using std::chrono::duration_cast;
+using std::find;
+using std::isdigit;
+using std::isspace;
+using std::llround;
+using std::regex_error;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    string const k_special_characters = "()=~<>";
+
+    struct Token
+    {
+        string text;
+        bool is_quoted = false;
+    };
+
+    [[noreturn]] void fail(string const& p_detail)
+    {
+        throw runtime_error("Could not parse query: " + p_detail);
+    }
+
+    vector<Token> tokenize(string const& p_expression)
+    {
+        vector<Token> ret;
+        auto it = p_expression.begin();
+        auto const end = p_expression.end();
+        while (it != end)
+        {
+            auto const c = *it;
+            Token token;
+            if (isspace(static_cast<unsigned char>(c)))
+            {
+                ++it;
+                continue;
+            }
+            if ((c == '"') || (c == '\''))
+            {
+                auto const closing = find(it + 1, end, c);
+                if (closing == end) fail("unterminated quote");
+                token.text.assign(it + 1, closing);
+                token.is_quoted = true;
+                it = closing + 1;
+            }
+            else if (k_special_characters.find(c) != string::npos)
+            {
+                token.text.push_back(c);
+                ++it;
+                if (((c == '<') || (c == '>')) && (it != end) && (*it == '='))
+                {
+                    token.text.push_back('=');
+                    ++it;
+                }
+            }
+            else
+            {
+                for
+                (   ;
+                    (it != end) &&
+                        !isspace(static_cast<unsigned char>(*it)) &&
+                        (k_special_characters.find(*it) == string::npos) &&
+                        (*it != '"') &&
+                        (*it != '\'');
+                    ++it
+                )
+                {
+                    token.text.push_back(*it);
+                }
+            }
+            ret.push_back(token);
+        }
+        return ret;
+    }
+
+    // Parses a duration such as "1h30m", "15m", "90s" or "1.5h".
+    long long parse_duration(string const& p_str)
+    {
+        double seconds = 0.0;
+        auto it = p_str.begin();
+        if (it == p_str.end()) fail("expected a duration");
+        while (it != p_str.end())
+        {
+            auto const number_beginning = it;
+            while ((it != p_str.end()) && (isdigit(static_cast<unsigned char>(*it)) || (*it == '.')))
+            {
+                ++it;
+            }
+            if ((it == number_beginning) || (it == p_str.end()))
+            {
+                fail("could not parse duration \"" + p_str + "\"");
+            }
+            double number = 0.0;
+            try
+            {
+                number = std::stod(string(number_beginning, it));
+            }
+            catch (std::exception&)
+            {
+                fail("could not parse duration \"" + p_str + "\"");
+            }
+            switch (*it)
+            {
+            case 'h': seconds += number * 60 * 60; break;
+            case 'm': seconds += number * 60; break;
+            case 's': seconds += number; break;
+            default: fail("could not parse duration \"" + p_str + "\"");
+            }
+            ++it;
+        }
+        return llround(seconds);
+    }
+
+    long long to_seconds(TimePoint const& p_time_point)
+    {
+        return duration_cast<std::chrono::seconds>(p_time_point.time_since_epoch()).count();
+    }
+
+}  // end anonymous namespace
+
+// Compiles an expression into the program of a StintQuery, by recursive
+// descent, emitting each test once its operands have been emitted.
+class StintQuery::Parser
+{
+public:
+    Parser
+    (   StintQuery& p_query,
+        string const& p_expression,
+        string const& p_time_format,
+        string const& p_short_time_format
+    ):
+        m_query(p_query),
+        m_tokens(tokenize(p_expression)),
+        m_time_format(p_time_format),
+        m_short_time_format(p_short_time_format)
+    {
+    }
+
+    void parse()
+    {
+        if (m_tokens.empty()) fail("the query is empty");
+        parse_disjunction();
+        if (m_position != m_tokens.size())
+        {
+            fail("unexpected \"" + m_tokens[m_position].text + "\"");
+        }
+    }
+
+private:
+    void parse_disjunction()
+    {
+        parse_conjunction();
+        while (accept_keyword("or"))
+        {
+            parse_conjunction();
+            emit(Opcode::disjunction);
+        }
+    }
+
+    void parse_conjunction()
+    {
+        parse_negation();
+        while (accept_keyword("and"))
+        {
+            parse_negation();
+            emit(Opcode::conjunction);
+        }
+    }
+
+    void parse_negation()
+    {
+        if (accept_keyword("not"))
+        {
+            parse_negation();
+            emit(Opcode::negation);
+            return;
+        }
+        if (accept_keyword("("))
+        {
+            parse_disjunction();
+            if (!accept_keyword(")")) fail("expected \")\"");
+            return;
+        }
+        parse_test();
+    }
+
+    void parse_test()
+    {
+        auto const& keyword = next("a test").text;
+        if (keyword == "activity")
+        {
+            auto const& op = next("\"=\" or \"~\"");
+            auto const& name = next("an activity");
+            if (op.is_quoted || ((op.text != "=") && (op.text != "~")))
+            {
+                fail("expected \"=\" or \"~\" after \"activity\"");
+            }
+            if (op.text == "=")
+            {
+                add_activity_test(new ExactActivityFilter(name.text));
+            }
+            else
+            {
+                try
+                {
+                    add_activity_test(new RegexActivityFilter(name.text));
+                }
+                catch (regex_error&)
+                {
+                    fail("invalid regular expression \"" + name.text + "\"");
+                }
+            }
+        }
+        else if (keyword == "under")
+        {
+            add_activity_test(new OrdinaryActivityFilter(next("an activity").text));
+        }
+        else if (keyword == "tag")
+        {
+            m_query.m_tag_tests.push_back(next("a tag").text);
+            emit(Opcode::test_tag, Comparison::less, m_query.m_tag_tests.size() - 1);
+        }
+        else if (keyword == "duration")
+        {
+            auto const comparison = parse_comparison();
+            auto const seconds = parse_duration(next("a duration").text);
+            emit(Opcode::compare_duration, comparison, 0, seconds);
+        }
+        else if (keyword == "start")
+        {
+            auto const comparison = parse_comparison();
+            auto const& stamp = next("a timestamp").text;
+            TimePoint time_point;
+            try
+            {
+                time_point = time_stamp_to_point(stamp, m_time_format, m_short_time_format);
+            }
+            catch (runtime_error&)
+            {
+                fail("could not parse timestamp \"" + stamp + "\"");
+            }
+            emit(Opcode::compare_start, comparison, 0, to_seconds(time_point));
+        }
+        else
+        {
+            fail("expected a test at \"" + keyword + "\"");
+        }
+    }
+
+    Comparison parse_comparison()
+    {
+        auto const& op = next("a comparison");
+        if (!op.is_quoted)
+        {
+            if (op.text == "<") return Comparison::less;
+            if (op.text == "<=") return Comparison::less_or_equal;
+            if (op.text == ">") return Comparison::greater;
+            if (op.text == ">=") return Comparison::greater_or_equal;
+        }
+        fail("expected \"<\", \"<=\", \">\" or \">=\" at \"" + op.text + "\"");
+    }
+
+    bool accept_keyword(string const& p_keyword)
+    {
+        if
+        (   (m_position != m_tokens.size()) &&
+            !m_tokens[m_position].is_quoted &&
+            (m_tokens[m_position].text == p_keyword)
+        )
+        {
+            ++m_position;
+            return true;
+        }
+        return false;
+    }
+
+    Token const& next(string const& p_expected)
+    {
+        if (m_position == m_tokens.size()) fail("expected " + p_expected + " at end");
+        return m_tokens[m_position++];
+    }
+
+    void add_activity_test(ActivityFilter* p_filter)
+    {
+        m_query.m_activity_tests.push_back(unique_ptr<ActivityFilter>(p_filter));
+        emit(Opcode::test_activity, Comparison::less, m_query.m_activity_tests.size() - 1);
+    }
+
+    void emit
+    (   Opcode p_opcode,
+        Comparison p_comparison = Comparison::less,
+        size_t p_operand = 0,
+        long long p_value = 0
+    )
+    {
+        Instruction const instruction{p_opcode, p_comparison, p_operand, p_value};
+        m_query.m_program.push_back(instruction);
+    }
+
+    StintQuery& m_query;
+    vector<Token> const m_tokens;
+    size_t m_position = 0;
+    string const& m_time_format;
+    string const& m_short_time_format;
+};
+
+StintQuery::StintQuery
+(   string const& p_expression,
+    string const& p_time_format,
+    string const& p_short_time_format
+)
+{
+    Parser parser(*this, p_expression, p_time_format, p_short_time_format);
+    parser.parse();
+    m_stack.reserve(m_program.size());
+}
+
+StintQuery::~StintQuery() = default;
+
+bool
+StintQuery::matches
+(   string const& p_activity,
+    Interval const& p_interval,
+    string const* p_tags
+)
+{
+    vector<char> const* activity_results_ptr = nullptr;
+    vector<char> const* tag_results_ptr = nullptr;
+    m_stack.clear();
+    for (auto const& instruction: m_program)
+    {
+        long long lhs = 0;
+        switch (instruction.opcode)
+        {
+        case Opcode::test_activity:
+            if (!activity_results_ptr) activity_results_ptr = &activity_results(p_activity);
+            m_stack.push_back((*activity_results_ptr)[instruction.operand]);
+            continue;
+        case Opcode::test_tag:
+            if (!tag_results_ptr) tag_results_ptr = &tag_results(p_tags);
+            m_stack.push_back((*tag_results_ptr)[instruction.operand]);
+            continue;
+        case Opcode::conjunction:
+        case Opcode::disjunction:
+            {
+                assert (m_stack.size() >= 2);
+                auto const rhs = m_stack.back();
+                m_stack.pop_back();
+                auto& top = m_stack.back();
+                top = (instruction.opcode == Opcode::conjunction) ? (top && rhs) : (top || rhs);
+            }
+            continue;
+        case Opcode::negation:
+            assert (!m_stack.empty());
+            m_stack.back() = !m_stack.back();
+            continue;
+        case Opcode::compare_duration:
+            lhs = static_cast<long long>(p_interval.duration().count());
+            break;
+        case Opcode::compare_start:
+            lhs = to_seconds(p_interval.beginning());
+            break;
+        }
+        auto const rhs = instruction.value;
+        switch (instruction.comparison)
+        {
+        case Comparison::less: m_stack.push_back(lhs < rhs); break;
+        case Comparison::less_or_equal: m_stack.push_back(lhs <= rhs); break;
+        case Comparison::greater: m_stack.push_back(lhs > rhs); break;
+        case Comparison::greater_or_equal: m_stack.push_back(lhs >= rhs); break;
+        }
+    }
+    assert (m_stack.size() == 1);
+    return m_stack.back();
+}
+
+vector<char> const&
+StintQuery::activity_results(string const& p_activity)
+{
+    auto it = m_activity_results.find(&p_activity);
+    if (it == m_activity_results.end())
+    {
+        vector<char> results;
+        for (auto const& test: m_activity_tests) results.push_back(test->matches(p_activity));
+        it = m_activity_results.emplace(&p_activity, results).first;
+    }
+    return it->second;
+}
+
+vector<char> const&
+StintQuery::tag_results(string const* p_tags)
+{
+    auto it = m_tag_results.find(p_tags);
+    if (it == m_tag_results.end())
+    {
+        vector<char> results(m_tag_tests.size(), false);
+        if (p_tags)
+        {
+            auto const tags = split(*p_tags);  // sorted
+            for (size_t i = 0; i != m_tag_tests.size(); ++i)
+            {
+                results[i] = binary_search(tags.begin(), tags.end(), m_tag_tests[i]);
+            }
+        }
+        it = m_tag_results.emplace(p_tags, results).first;
+    }
+    return it->second;
+}
+
+}  // namespace swx
@@ -23,6 +23,7 @@
 #include <iterator>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -33,6 +34,7 @@ using std::ostream_iterator;
 using std::ostringstream;
 using std::regex;
 using std::regex_replace;
+using std::runtime_error;
 using std::string;
 using std::stringstream;
 using std::vector;
@@ -48,14 +50,14 @@ trim(string const& p_string)
         return p_string;
     }
     string::const_iterator it = p_string.begin();
-    while (isspace(*it)) ++it;
     string::const_iterator rit = p_string.end();
+    while ((it != rit) && isspace(static_cast<unsigned char>(*it))) ++it;
     if (it == rit)
     {
         return string();
     }
     --rit;
-    while (isspace(*rit))
+    while (isspace(static_cast<unsigned char>(*rit)))
     {
         assert (it != rit);
         --rit;
@@ -88,6 +90,51 @@ split(string const& p_str, char p_delimiter)
     return ret;
 }
 
+vector<string>
+split_command_line(string const& p_line)
+{
+    vector<string> ret;
+    string current;
+    bool in_argument = false;
+    char quote = '\0';
+    for (auto it = p_line.begin(); it != p_line.end(); ++it)
+    {
+        auto const c = *it;
+        if (quote != '\0')
+        {
+            if (c == quote) quote = '\0';
+            else current.push_back(c);
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quote = c;
+            in_argument = true;
+        }
+        else if (c == '\\' && (it + 1) != p_line.end())
+        {
+            current.push_back(*++it);
+            in_argument = true;
+        }
+        else if (isspace(static_cast<unsigned char>(c)))
+        {
+            if (in_argument) ret.push_back(current);
+            current.clear();
+            in_argument = false;
+        }
+        else
+        {
+            current.push_back(c);
+            in_argument = true;
+        }
+    }
+    if (quote != '\0')
+    {
+        throw runtime_error("Unterminated quote.");
+    }
+    if (in_argument) ret.push_back(current);
+    return ret;
+}
+
 string
 wrap
 (   string const& p_string,
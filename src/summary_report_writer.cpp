@@ -20,7 +20,11 @@
 #include "seconds.hpp"
 #include "stint.hpp"
 #include "stream_utilities.hpp"
+#include "time_point.hpp"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <ostream>
 #include <sstream>
@@ -28,10 +32,14 @@
 #include <string>
 #include <vector>
 
+using std::chrono::duration_cast;
 using std::map;
+using std::max;
+using std::min;
 using std::ostringstream;
 using std::ostream;
 using std::runtime_error;
+using std::size_t;
 using std::string;
 using std::vector;
 
@@ -59,6 +67,8 @@ SummaryReportWriter::do_preprocess_stints
 {
     (void)p_os; (void)p_stints;  // silence compiler warnings re. unused params.
     assert (m_activity_stats_map.empty());
+    assert (m_period_stats_maps.empty());
+    m_period_stats_maps.resize(comparison_periods().size());
 }
 
 void
@@ -68,10 +78,29 @@ SummaryReportWriter::do_process_stint(ostream& p_os, Stint const& p_stint)
     auto const interval = p_stint.interval();
     unsigned long long const seconds = interval.duration().count();
     auto const& activity = p_stint.activity();
-    if (!activity.empty())
+    if (activity.empty()) return;
+    auto const& periods = comparison_periods();
+    if (!periods.empty())
     {
-        m_activity_stats_map[activity] +=
-            ActivityStats(seconds, interval.beginning(), interval.ending());
+        // The stints span all the periods, so each contributes to every
+        // period it overlaps.
+        for (size_t i = 0; i != periods.size(); ++i)
+        {
+            auto const beginning = max(interval.beginning(), periods[i].first);
+            auto const ending = min(interval.ending(), periods[i].second);
+            if (beginning >= ending) continue;
+            unsigned long long const overlap =
+                duration_cast<Seconds>(ending - beginning).count();
+            auto& stats = m_period_stats_maps[i][activity];
+            stats += ActivityStats(overlap, beginning, ending);
+            if (has_flag(Flags::durations)) stats.durations.add(overlap);
+        }
+    }
+    else
+    {
+        auto& stats = m_activity_stats_map[activity];
+        stats += ActivityStats(seconds, interval.beginning(), interval.ending());
+        if (has_flag(Flags::durations)) stats.durations.add(seconds);
     }
 }
 
@@ -82,8 +111,16 @@ SummaryReportWriter::do_postprocess_stints
 )
 {
     (void)p_stints;  // silence compiler warning re. unused param.
-    do_write_summary(p_os, m_activity_stats_map);
+    if (comparison_periods().empty())
+    {
+        do_write_summary(p_os, m_activity_stats_map);
+    }
+    else
+    {
+        do_write_comparison(p_os, m_period_stats_maps);
+    }
     m_activity_stats_map.clear();  // hygienic even if unnecessary
+    m_period_stats_maps.clear();
 }
 
 bool
@@ -92,4 +129,20 @@ SummaryReportWriter::has_flag(Flags::Type p_flag) const
     return m_flags & p_flag;
 }
 
+string
+SummaryReportWriter::describe_period(size_t p_index) const
+{
+    auto const& period = comparison_periods().at(p_index);
+    auto const describe = [this](TimePoint const& p_time_point, char const* p_unbounded)
+    {
+        if ((p_time_point == TimePoint::min()) || (p_time_point == TimePoint::max()))
+        {
+            return string(p_unbounded);
+        }
+        return time_point_to_stamp(p_time_point, time_format(), formatted_buf_len());
+    };
+    return describe(period.first, "start of log") + " to " +
+        describe(period.second, "end of log");
+}
+
 }  // namespace swx
@@ -94,6 +94,15 @@ SwitchCommand::SwitchCommand
         [this]() { m_time_stamp_provided = true; },
         &m_time_stamp
     );
+    add_option
+    (   vector<string>{"tag"},
+        HelpLine
+        (   "Tag the new stint (or, with -a, the current stint) with TAG, such "
+                "as \"billable\" or \"client:acme\"; may be passed more than once",
+            "<TAG>"
+        ),
+        &m_tags
+    );
 }
 
 SwitchCommand::~SwitchCommand() = default;
@@ -105,10 +114,9 @@ SwitchCommand::do_process
     ostream& p_ordinary_ostream
 )
 {
-    (void)p_config;  // silence compiler re. unused param.
-
     ErrorMessages error_messages;
 
+    auto const goal_tracker = track_goals(p_config, p_ordinary_ostream);
     auto const last_two_activities = time_log().last_activities(2);
     bool const log_active = time_log().is_active();
     auto const current_activity = (log_active ? last_two_activities.front() : string());
@@ -140,7 +148,8 @@ SwitchCommand::do_process
     {
         auto const activity_changing = (activity != current_activity);
         auto const timestamp_changing = (m_amend && m_time_stamp_provided);
-        if (!activity_changing && !timestamp_changing)
+        auto const tags_changing = (m_amend && !m_tags.empty());
+        if (!activity_changing && !timestamp_changing && !tags_changing)
         {
             return ErrorMessages
             {   log_active ?
@@ -207,7 +216,7 @@ SwitchCommand::do_process
                 }
             }
             auto const last_entry_time = time_log().last_entry_time(0);
-            auto const last_activity = time_log().amend_last(activity, tp);
+            auto const last_activity = time_log().amend_last(activity, tp, m_tags);
             if (activity != last_activity)
             {
                 auto const desc = [](string const& p_activity)
@@ -229,6 +238,11 @@ SwitchCommand::do_process
                                    << last_time_stamp << " to "
                                    << confirmed_stamp << "." << endl;
             }
+            if (!m_tags.empty())
+            {
+                p_ordinary_ostream << "Tags of current stint amended." << endl;
+            }
+            report_goals(p_config, goal_tracker, p_ordinary_ostream);
         }
         else
         {
@@ -239,7 +253,7 @@ SwitchCommand::do_process
                 {   "Timestamp must not be earlier than date of last entry."
                 };
             }
-            time_log().append_entry(activity, tp);
+            time_log().append_entry(activity, tp, m_tags);
             if (activity.empty())
             {
                 p_ordinary_ostream << "Activity ceased at " << confirmed_stamp;
@@ -255,6 +269,7 @@ SwitchCommand::do_process
                                    << "\" at " << confirmed_stamp;
             }
             p_ordinary_ostream << '.' << endl;
+            report_goals(p_config, goal_tracker, p_ordinary_ostream);
         }
     }
     else
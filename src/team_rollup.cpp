@@ -0,0 +1,303 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "team_rollup.hpp"
+#include "file_utilities.hpp"
+#include "profiler.hpp"
+#include "seconds.hpp"
+#include "stream_utilities.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::chrono::duration_cast;
+using std::ifstream;
+using std::ios;
+using std::istreambuf_iterator;
+using std::min;
+using std::move;
+using std::ostringstream;
+using std::runtime_error;
+using std::set;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    string const k_log_extension = ".swx";
+
+    bool is_log_name(string const& p_filename)
+    {
+        auto const len = k_log_extension.size();
+        return
+            (p_filename.size() > len) &&
+            (p_filename[0] != '.') &&
+            (p_filename.compare(p_filename.size() - len, len, k_log_extension) == 0);
+    }
+
+    // Read the file at p_filepath from byte p_offset to the end.
+    string read_from(string const& p_filepath, unsigned long long p_offset)
+    {
+        ifstream infile(p_filepath.c_str(), ios::in | ios::binary);
+        if (!infile || !infile.seekg(p_offset))
+        {
+            throw runtime_error("Could not read file.");
+        }
+        string const ret
+        (   (istreambuf_iterator<char>(infile)),
+            istreambuf_iterator<char>()
+        );
+        Profiler::count(Profiler::Counter::bytes_read, ret.size());
+        return ret;
+    }
+
+    void add(TeamRollup::Rollups& p_lhs, TeamRollup::Rollups const& p_rhs)
+    {
+        for (auto const& day: p_rhs)
+        {
+            auto& lhs_day = p_lhs[day.first];
+            for (auto const& activity: day.second) lhs_day[activity.first] += activity.second;
+        }
+    }
+
+    void subtract(TeamRollup::Rollups& p_lhs, TeamRollup::Rollups const& p_rhs)
+    {
+        for (auto const& day: p_rhs)
+        {
+            auto const day_it = p_lhs.find(day.first);
+            if (day_it == p_lhs.end()) continue;
+            auto& lhs_day = day_it->second;
+            for (auto const& activity: day.second)
+            {
+                auto const it = lhs_day.find(activity.first);
+                if (it == lhs_day.end()) continue;
+                if (it->second > activity.second) it->second -= activity.second;
+                else lhs_day.erase(it);
+            }
+            if (lhs_day.empty()) p_lhs.erase(day_it);
+        }
+    }
+
+}  // end anonymous namespace
+
+TeamRollup::TeamRollup
+(   string const& p_dirpath,
+    string const& p_time_format,
+    unsigned int p_formatted_buf_len,
+    bool p_label_by_user
+):
+    m_label_by_user(p_label_by_user),
+    m_formatted_buf_len(p_formatted_buf_len),
+    m_dirpath(p_dirpath),
+    m_time_format(p_time_format)
+{
+}
+
+TeamRollup::~TeamRollup() = default;
+
+vector<string>
+TeamRollup::refresh()
+{
+    Profiler::Phase const phase("rollup: refresh");
+    m_bytes_read_by_last_refresh = 0;
+    vector<string> errors;
+    set<string> present;
+    for (auto const& filename: directory_entries(m_dirpath))
+    {
+        if (!is_log_name(filename)) continue;
+        auto const filepath = m_dirpath + '/' + filename;
+        FileStatus status;
+        if (!get_file_status(filepath, status)) continue;
+        present.insert(filename);
+        auto it = m_files.find(filename);
+        if ((it != m_files.end()) && (it->second.status == status)) continue;
+        try
+        {
+            // If the log has only grown, resume from the start of the last
+            // line parsed, checking it is still there; otherwise start over.
+            bool resume = (it != m_files.end()) && (status.size > it->second.status.size);
+            auto position = resume ? it->second.position : Position();
+            auto const last_line = position.last_line + '\n';
+            auto buffer_position =
+                position.parsed_size - (position.line_count == 0 ? 0 : last_line.size());
+            auto buffer = read_from(filepath, buffer_position);
+            string::size_type offset = 0;
+            if (resume && (position.line_count != 0))
+            {
+                offset = last_line.size();
+                if (buffer.compare(0, offset, last_line) != 0)
+                {
+                    resume = false;
+                    position = Position();
+                    m_bytes_read_by_last_refresh += buffer.size();
+                    buffer_position = offset = 0;
+                    buffer = read_from(filepath, buffer_position);
+                }
+            }
+            m_bytes_read_by_last_refresh += buffer.size();
+            Rollups delta;
+            parse(filename, buffer, buffer_position, offset, position, delta);
+            if (it == m_files.end())
+            {
+                it = m_files.emplace(filename, FileState()).first;
+            }
+            auto& state = it->second;
+            if (!resume)
+            {
+                subtract(m_combined, state.rollups);
+                state.rollups.clear();
+            }
+            add(state.rollups, delta);
+            add(m_combined, delta);
+            state.status = status;
+            state.position = move(position);
+        }
+        catch (runtime_error& e)
+        {
+            errors.push_back(filepath + ": " + e.what());
+            if (it != m_files.end())
+            {
+                subtract(m_combined, it->second.rollups);
+                m_files.erase(it);
+            }
+        }
+    }
+    for (auto it = m_files.begin(); it != m_files.end(); )
+    {
+        if (present.count(it->first) == 0)
+        {
+            subtract(m_combined, it->second.rollups);
+            it = m_files.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return errors;
+}
+
+TeamRollup::Rollups
+TeamRollup::rollups(TimePoint const& p_now) const
+{
+    auto ret = m_combined;
+    for (auto const& file: m_files)
+    {
+        auto const& position = file.second.position;
+        if (position.has_entry && (position.last_time_point < p_now))
+        {
+            add_stint
+            (   ret,
+                file.first,
+                position.last_activity,
+                position.last_time_point,
+                p_now
+            );
+        }
+    }
+    return ret;
+}
+
+unsigned long long
+TeamRollup::bytes_read_by_last_refresh() const
+{
+    return m_bytes_read_by_last_refresh;
+}
+
+void
+TeamRollup::parse
+(   string const& p_filename,
+    string const& p_buffer,
+    unsigned long long p_buffer_position,
+    string::size_type p_offset,
+    Position& p_position,
+    Rollups& p_delta
+) const
+{
+    TimeLog const parser(m_dirpath + '/' + p_filename, m_time_format, m_formatted_buf_len);
+    auto pos = p_offset;
+    string line;
+    for (auto end = p_buffer.find('\n', pos); end != string::npos; end = p_buffer.find('\n', pos))
+    {
+        line.assign(p_buffer, pos, end - pos);
+        pos = end + 1;
+        Profiler::count(Profiler::Counter::lines_parsed);
+        auto entry = parser.parse_entry(line, ++p_position.line_count);
+        if (p_position.has_entry)
+        {
+            if (entry.second < p_position.last_time_point)
+            {
+                ostringstream oss;
+                enable_exceptions(oss);
+                oss << "Time log entries out of order at line "
+                    << p_position.line_count << '.';
+                throw runtime_error(oss.str());
+            }
+            add_stint
+            (   p_delta,
+                p_filename,
+                p_position.last_activity,
+                p_position.last_time_point,
+                entry.second
+            );
+        }
+        p_position.has_entry = true;
+        p_position.last_activity = move(entry.first);
+        p_position.last_time_point = entry.second;
+        p_position.last_line.swap(line);
+    }
+    // Any incomplete final line may still be being written, so is left to
+    // be parsed on a later refresh.
+    p_position.parsed_size = p_buffer_position + pos;
+}
+
+void
+TeamRollup::add_stint
+(   Rollups& p_rollups,
+    string const& p_filename,
+    string const& p_activity,
+    TimePoint const& p_beginning,
+    TimePoint const& p_ending
+) const
+{
+    if (p_activity.empty()) return;
+    auto const activity =
+        m_label_by_user ?
+        (p_filename.substr(0, p_filename.size() - k_log_extension.size()) + ' ' + p_activity) :
+        p_activity;
+    for (auto beginning = p_beginning; beginning < p_ending; )
+    {
+        auto const day = day_begin(beginning);
+        auto const ending = min(day_begin(beginning, 1), p_ending);
+        p_rollups[day][activity] += duration_cast<Seconds>(ending - beginning);
+        beginning = ending;
+    }
+}
+
+}  // namespace swx
@@ -19,6 +19,7 @@
 #include "atomic_writer.hpp"
 #include "file_utilities.hpp"
 #include "interval.hpp"
+#include "profiler.hpp"
 #include "regex_activity_filter.hpp"
 #include "stint.hpp"
 #include "stream_utilities.hpp"
@@ -26,6 +27,7 @@
 #include "time_point.hpp"
 #include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
@@ -34,15 +36,26 @@
 #include <fstream>
 #include <iomanip>
 #include <ios>
+#include <memory>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+using std::all_of;
+using std::any_of;
+using std::binary_search;
+using std::find;
 using std::getline;
+using std::iota;
 using std::ifstream;
+using std::ios;
+using std::isspace;
+using std::lower_bound;
 using std::make_pair;
 using std::move;
 using std::ofstream;
@@ -50,9 +63,13 @@ using std::ostringstream;
 using std::pair;
 using std::runtime_error;
 using std::size_t;
+using std::sort;
 using std::string;
+using std::unique;
+using std::unique_ptr;
 using std::upper_bound;
 using std::unordered_map;
+using std::unordered_set;
 using std::vector;
 
 namespace chrono = std::chrono;
@@ -60,6 +77,55 @@ namespace chrono = std::chrono;
 namespace swx
 {
 
+namespace
+{
+    // Marks each tag in the time log file.
+    char const k_tag_marker = '#';
+
+    void validate_tags(vector<string> const& p_tags)
+    {
+        for (auto const& tag: p_tags)
+        {
+            auto const is_space = [](char c) { return isspace(static_cast<unsigned char>(c)); };
+            if (tag.empty() || any_of(tag.begin(), tag.end(), is_space))
+            {
+                throw runtime_error
+                (   "Tag must be non-empty and must not contain whitespace: \"" + tag + "\""
+                );
+            }
+        }
+    }
+
+    /**
+     * Parse the tags between \e p_begin and \e p_end, each of which must
+     * be marked by k_tag_marker, and separated by spaces from the others.
+     *
+     * @returns \e true, having written the tags, without their markers and
+     * separated by single spaces, to \e p_tags, if there is at least one
+     * tag, and all are well formed; otherwise \e false.
+     */
+    bool parse_tags
+    (   string::const_iterator p_begin,
+        string::const_iterator const& p_end,
+        string& p_tags
+    )
+    {
+        p_tags.clear();
+        while (true)
+        {
+            while ((p_begin != p_end) && (*p_begin == ' ')) ++p_begin;
+            if (p_begin == p_end) return !p_tags.empty();
+            if (*p_begin != k_tag_marker) return false;
+            auto const tag_end = find(++p_begin, p_end, ' ');
+            if (tag_end == p_begin) return false;
+            if (!p_tags.empty()) p_tags += ' ';
+            p_tags.append(p_begin, tag_end);
+            p_begin = tag_end;
+        }
+    }
+
+}  // end anonymous namespace
+
 /**
  * Provides implementation for TimeLog.
  */
@@ -69,12 +135,18 @@ class TimeLog::Impl
 private:
     class Transaction;
     friend class Transaction;
+    friend class TimeLog::StintScan;
     struct Entry;     // a single entry in the log, registered in the cache
     using Entries = vector<Entry>;
     using ReferenceCount = Entries::size_type;  // number of entries with a given activity
     using ActivityId = pair<string const, ReferenceCount>*;
     using ActivityRegistry = unordered_map<string, ReferenceCount>;
 
+    // Each distinct set of tags is stored once, as its tags sorted and
+    // joined with spaces, and entries point to it.
+    using TagSets = unordered_set<string>;
+    using TagIndex = unordered_map<string, vector<Entries::size_type>>;
+
 // special member functions
 public:
     Impl
@@ -94,20 +166,40 @@ public:
 
     // These implement the corresponding public functions of TimeLog.
 
-    void append_entry(string const& p_activity, TimePoint const& p_time_point);
-    string amend_last(string const& p_activity, TimePoint const& p_time_point);
+    void defer_saving();
+    void save_deferred();
+    void append_entry
+    (   string const& p_activity,
+        TimePoint const& p_time_point,
+        vector<string> const& p_tags
+    );
+    string amend_last
+    (   string const& p_activity,
+        TimePoint const& p_time_point,
+        vector<string> const& p_tags
+    );
+    string insert_entry
+    (   string const& p_activity,
+        TimePoint const& p_time_point,
+        vector<string> const& p_tags
+    );
+    string delete_entry(TimePoint const& p_time_point);
     vector<Stint>::size_type rename_activity
     (   ActivityFilter const& p_activity_filter,
         string const& p_new
     );
+    size_t merge_entries(EntrySource const& p_source);
     vector<Stint> get_stints
-    (   ActivityFilter const& p_activity_filter,
+    (   ActivityFilter const* p_activity_filter,
+        StintPredicate const* p_predicate,
         TimePoint const* p_begin,
-        TimePoint const* p_end
+        TimePoint const* p_end,
+        vector<string> const& p_tags
     );
     string last_activity_to_match(string const& p_regex);
     vector<string> last_activities(size_t p_num);
     TimePoint last_entry_time(size_t p_ago);
+    vector<string> activities_at(vector<TimePoint> const& p_time_points);
     bool is_active_at(TimePoint const& p_time_point);
     bool is_active();
     bool has_activity(string const& p_activity);
@@ -122,6 +214,17 @@ private:
     void load();
     void save() const;
 
+    // Persist any changes whose saving has been deferred. Call this
+    // before a change that may fail part way through, so that a failure
+    // discards only that change.
+    void save_unsaved_changes();
+
+    // Persist a change that only added entries after the first
+    // p_num_kept, which it left untouched. If the file still ends with the
+    // last of those, as it would be written, the new entries are appended
+    // to it; otherwise the whole file is rewritten, as by save().
+    void save_appended(Entries::size_type p_num_kept) const;
+
     // Record that an entry refers to an activity, or that it has ceased
     // to do so. The activity register contains a reference count for each
     // activity and calling these functions causes this to be updated and
@@ -129,39 +232,101 @@ private:
     // longer referred to.
     //
     // NOTE register_activity_reference and deregister_activity_reference
-    // are implementation details for push_entry, pop_entry and put_entry,
-    // and should not be called from elsewhere.
+    // are implementation details for push_entry, pop_entry, put_entry,
+    // splice_entry and erase_entry, and should not be called from
+    // elsewhere.
     ActivityId register_activity_reference(string const& p_activity);
     void deregister_activity_reference(ActivityId p_activity_id);
 
     string const& activity_at(Entry const& p_entry) const;
 
-    void push_entry(string const& p_activity, TimePoint const& p_time_point);
+    void push_entry
+    (   string const& p_activity,
+        TimePoint const& p_time_point,
+        string const* p_tags = nullptr
+    );
     void pop_entry();
 
     // Place a new entry at a specific index in m_entries, but only if it
-    // would not result in consecutive identical activities. Return true
-    // if and only if entry placed.
+    // would not result in consecutive identical activities; otherwise add
+    // its tags to those of the entry before it. Return true if and only if
+    // entry placed. The tag index is not updated.
     bool put_entry
     (   string const& p_activity,
         TimePoint const& p_time_point,
+        string const* p_tags,
+        Entries::size_type p_index
+    );
+
+    // Insert a new entry at a specific index in m_entries, but only if it
+    // would not result in consecutive identical activities; and remove the
+    // entry following it if that has the same activity as it, adding its
+    // tags to those of the new entry. Return true if and only if entry
+    // inserted. The tag index is not updated.
+    bool splice_entry
+    (   string const& p_activity,
+        TimePoint const& p_time_point,
+        string const* p_tags,
         Entries::size_type p_index
     );
 
+    // Remove the entry at a specific index in m_entries, and then the
+    // entry following it too if that would otherwise have the same
+    // activity as the entry preceding it, adding its tags to those of the
+    // entry preceding it. The tag index is not updated.
+    void erase_entry(Entries::size_type p_index);
+
+    // Return the index of the first entry not earlier than p_time_point,
+    // or the number of entries if there is no such entry.
+    Entries::size_type index_of_entry_from(TimePoint const& p_time_point) const;
+
+    // Return a pointer to the stored set of p_tags, or null if p_tags is
+    // empty.
+    string const* register_tags(vector<string> p_tags);
+
+    // Return a pointer to the stored union of the sets of tags p_lhs and
+    // p_rhs, either of which may be null.
+    string const* merge_tags(string const* p_lhs, string const* p_rhs);
+
+    // Maintenance of the index from each tag to the positions, in
+    // ascending order, of the entries bearing it. unindex_tags may only
+    // be called for the last entry indexed.
+    void index_tags(Entries::size_type p_index);
+    void unindex_tags(Entries::size_type p_index);
+    void rebuild_tag_index();
+
+    // Return the interval of the stint beginning with the entry at p_it,
+    // clipped to the given range.
+    Interval make_interval
+    (   Entries::const_iterator p_it,
+        TimePoint const* p_begin,
+        TimePoint const* p_end,
+        TimePoint const& p_now
+    ) const;
+
+public:
     // Parse a line provided from the log file, returning a pair of
-    // activity name and TimePoint.
+    // activity name and TimePoint, and assigning any tags on the line to
+    // *p_tags if p_tags is non-null.
     pair<string, TimePoint> parse_line
     (   string const& p_entry_string,
-        size_t p_line_number
+        size_t p_line_number,
+        string* p_tags = nullptr
     ) const;
 
-    // Append an entry to the log file.
-    void write_entry
-    (   AtomicWriter& p_writer,
+private:
+    // Append to p_out the line of the log file recording an entry.
+    void format_entry
+    (   string& p_out,
         string const& p_activity,
-        TimePoint const& p_time_point
+        TimePoint const& p_time_point,
+        string const* p_tags
     ) const;
 
+    // Return the lines of the log file recording the entries from
+    // p_index onwards.
+    string format_tail(Entries::size_type p_index) const;
+
     string const& id_to_activity(ActivityId p_activity_id) const;
     Entries::const_iterator find_entry_just_before(TimePoint const& p_time_point);
 
@@ -180,11 +345,15 @@ private:
 // member variables
 private:
     bool m_loaded = false;
+    bool m_saving_deferred = false;
+    bool m_has_unsaved_changes = false;
     unsigned int m_formatted_buf_len;
     unsigned int m_expected_time_stamp_length;
     string m_filepath;
     Entries m_entries;
     ActivityRegistry m_activity_registry;
+    TagSets m_tag_sets;
+    TagIndex m_tag_index;
     string const m_time_format;
 };
 
@@ -192,9 +361,14 @@ private:
 // to a line in the log file.
 struct TimeLog::Impl::Entry
 {
-    Entry(ActivityId p_activity_id, TimePoint const& p_time_point);
+    Entry
+    (   ActivityId p_activity_id,
+        TimePoint const& p_time_point,
+        string const* p_tags = nullptr
+    );
     ActivityId activity_id;
     TimePoint time_point;
+    string const* tags;  // null if untagged
 };
 
 // Provides RAII mechanism for managing changes to time log as a transaction.
@@ -208,12 +382,68 @@ public:
     Transaction& operator=(Transaction&&) = delete;
     ~Transaction();
     void commit();
+
+    // As for commit(), but persisting a change that only added entries
+    // after the first p_num_kept; see TimeLog::Impl::save_appended.
+    void commit(Entries::size_type p_num_kept);
 private:
     void rollback();
     bool m_committed = false;
     TimeLog::Impl& m_time_log_impl;
 };
 
+// The position of a scan over the stints of a time log, filtered as for
+// TimeLog::get_stints by either an activity filter or a predicate. Each
+// matching stint is found only when the scan advances to it.
+class TimeLog::StintScan
+{
+public:
+    StintScan
+    (   TimeLog::Impl& p_time_log,
+        ActivityFilter const* p_activity_filter,
+        StintPredicate const* p_predicate,
+        TimePoint const* p_begin,
+        TimePoint const* p_end,
+        vector<string> const& p_tags
+    );
+    StintScan(StintScan const&) = delete;
+    StintScan(StintScan&&) = delete;
+    StintScan& operator=(StintScan const&) = delete;
+    StintScan& operator=(StintScan&&) = delete;
+    ~StintScan() = default;
+    bool done() const;
+    Stint current() const;
+    void advance();
+private:
+    using Entries = TimeLog::Impl::Entries;
+    using Positions = vector<Entries::size_type>;
+
+    // Move to the first matching stint at or after m_next, if any.
+    void seek();
+    bool matches(Entries::const_iterator p_it) const;
+    Interval interval(Entries::const_iterator p_it) const;
+
+    TimeLog::Impl const& m_time_log;
+    ActivityFilter const* const m_activity_filter;
+    StintPredicate const* const m_predicate;
+    bool const m_has_begin;
+    bool const m_has_end;
+    TimePoint const m_begin;
+    TimePoint const m_end;
+    TimePoint const m_now;
+
+    // If tags were given, the positions of the entries bearing each of
+    // them, the rarest first; and then the scan walks the positions of the
+    // rarest, rather than the entries themselves.
+    vector<Positions const*> m_position_lists;
+
+    // Index, into the entries or the positions of the rarest tag, of the
+    // current stint, and then of the next one to be considered.
+    Positions::size_type m_current = 0;
+    Positions::size_type m_next = 0;
+    bool m_done = false;
+};
+
 // Implementation of public TimeLog class. Implementation defer to Impl.
 
 TimeLog::TimeLog
@@ -228,15 +458,51 @@ TimeLog::TimeLog
 TimeLog::~TimeLog() = default;
 
 void
-TimeLog::append_entry(string const& p_activity, TimePoint const& p_time_point)
+TimeLog::defer_saving()
+{
+    m_impl->defer_saving();
+}
+
+void
+TimeLog::save_deferred()
+{
+    m_impl->save_deferred();
+}
+
+void
+TimeLog::append_entry
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    vector<string> const& p_tags
+)
 {
-    return m_impl->append_entry(p_activity, p_time_point);
+    return m_impl->append_entry(p_activity, p_time_point, p_tags);
 }
 
 string
-TimeLog::amend_last(string const& p_activity, TimePoint const& p_time_point)
+TimeLog::amend_last
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    vector<string> const& p_tags
+)
 {
-    return m_impl->amend_last(p_activity, p_time_point);
+    return m_impl->amend_last(p_activity, p_time_point, p_tags);
+}
+
+string
+TimeLog::insert_entry
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    vector<string> const& p_tags
+)
+{
+    return m_impl->insert_entry(p_activity, p_time_point, p_tags);
+}
+
+string
+TimeLog::delete_entry(TimePoint const& p_time_point)
+{
+    return m_impl->delete_entry(p_time_point);
 }
 
 vector<Stint>::size_type
@@ -245,14 +511,57 @@ TimeLog::rename_activity(ActivityFilter const& p_activity_filter, string const&
     return m_impl->rename_activity(p_activity_filter, p_new);
 }
 
+size_t
+TimeLog::merge_entries(EntrySource const& p_source)
+{
+    return m_impl->merge_entries(p_source);
+}
+
+pair<string, TimePoint>
+TimeLog::parse_entry
+(   string const& p_line,
+    size_t p_line_number,
+    string* p_tags
+) const
+{
+    return m_impl->parse_line(p_line, p_line_number, p_tags);
+}
+
 vector<Stint>
 TimeLog::get_stints
 (   ActivityFilter const& p_activity_filter,
     TimePoint const* p_begin,
-    TimePoint const* p_end
+    TimePoint const* p_end,
+    vector<string> const& p_tags
+)
+{
+    return m_impl->get_stints(&p_activity_filter, nullptr, p_begin, p_end, p_tags);
+}
+
+vector<Stint>
+TimeLog::get_stints
+(   StintPredicate const& p_predicate,
+    TimePoint const* p_begin,
+    TimePoint const* p_end,
+    vector<string> const& p_tags
 )
 {
-    return m_impl->get_stints(p_activity_filter, p_begin, p_end);
+    return m_impl->get_stints(nullptr, &p_predicate, p_begin, p_end, p_tags);
+}
+
+TimeLog::StintCursor
+TimeLog::stint_cursor
+(   StintPredicate const& p_predicate,
+    TimePoint const* p_begin,
+    TimePoint const* p_end,
+    vector<string> const& p_tags
+)
+{
+    return StintCursor
+    (   unique_ptr<StintScan>
+        (   new StintScan(*m_impl, nullptr, &p_predicate, p_begin, p_end, p_tags)
+        )
+    );
 }
 
 string
@@ -273,6 +582,12 @@ TimeLog::last_entry_time(size_t p_ago)
     return m_impl->last_entry_time(p_ago);
 }
 
+vector<string>
+TimeLog::activities_at(vector<TimePoint> const& p_time_points)
+{
+    return m_impl->activities_at(p_time_points);
+}
+
 bool
 TimeLog::is_active()
 {
@@ -308,42 +623,134 @@ TimeLog::Impl::Impl
 TimeLog::Impl::~Impl() = default;
 
 void
-TimeLog::Impl::append_entry(string const& p_activity, TimePoint const& p_time_point)
+TimeLog::Impl::defer_saving()
 {
-    Transaction transaction(*this);
+    m_saving_deferred = true;
+}
+
+void
+TimeLog::Impl::save_deferred()
+{
+    save_unsaved_changes();
+    m_saving_deferred = false;
+}
+
+void
+TimeLog::Impl::append_entry
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    vector<string> const& p_tags
+)
+{
+    // Validate before opening the transaction, so that a rejected entry
+    // does not cause the rollback of any deferred changes.
     if (p_time_point > now())
     {
         throw runtime_error("Entry must not be future-dated.");
     }
-    push_entry(p_activity, p_time_point);
-    transaction.commit();
+    validate_tags(p_tags);
+    Transaction transaction(*this);
+    auto const num_kept = m_entries.size();
+
+    // Switching to the current activity changes nothing, so its tags are
+    // discarded rather than added to those of the current stint.
+    if (m_entries.empty() || (activity_at(m_entries.back()) != p_activity))
+    {
+        push_entry(p_activity, p_time_point, register_tags(p_tags));
+    }
+    transaction.commit(num_kept);
 }
 
 string
-TimeLog::Impl::amend_last(string const& p_activity, TimePoint const& p_time_point)
+TimeLog::Impl::amend_last
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    vector<string> const& p_tags
+)
 {
-    Transaction transaction(*this);
     if (p_time_point > now())
     {
         throw runtime_error("Entry must not be future-dated.");
     }
+    validate_tags(p_tags);
+    Transaction transaction(*this);
     string last_activity;
     if (!m_entries.empty())
     {
         last_activity = activity_at(m_entries.back());
         pop_entry();
-        push_entry(p_activity, p_time_point);
+        push_entry(p_activity, p_time_point, register_tags(p_tags));
     }
     transaction.commit();
     return last_activity;
 }
 
+string
+TimeLog::Impl::insert_entry
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    vector<string> const& p_tags
+)
+{
+    if (p_time_point > now())
+    {
+        throw runtime_error("Entry must not be future-dated.");
+    }
+    validate_tags(p_tags);
+    load();
+    auto const index = index_of_entry_from(p_time_point);
+    if ((index != m_entries.size()) && (m_entries[index].time_point == p_time_point))
+    {
+        throw runtime_error("There is already an entry at that time.");
+    }
+    string previous_activity;
+    if (index != 0)
+    {
+        previous_activity = activity_at(m_entries[index - 1]);
+    }
+    if (previous_activity == p_activity)
+    {
+        return previous_activity;
+    }
+    Transaction transaction(*this);
+    auto const appending = (index == m_entries.size());
+    splice_entry(p_activity, p_time_point, register_tags(p_tags), index);
+    rebuild_tag_index();
+    if (appending)
+    {
+        transaction.commit(index);
+    }
+    else
+    {
+        transaction.commit();
+    }
+    return previous_activity;
+}
+
+string
+TimeLog::Impl::delete_entry(TimePoint const& p_time_point)
+{
+    load();
+    auto const index = index_of_entry_from(p_time_point);
+    if ((index == m_entries.size()) || (m_entries[index].time_point != p_time_point))
+    {
+        throw runtime_error("There is no entry at that time.");
+    }
+    Transaction transaction(*this);
+    auto const deleted_activity = activity_at(m_entries[index]);
+    erase_entry(index);
+    rebuild_tag_index();
+    transaction.commit();
+    return deleted_activity;
+}
+
 vector<Stint>::size_type
 TimeLog::Impl::rename_activity(ActivityFilter const& p_activity_filter, string const& p_new)
 {
     // There is far from the most efficient implementation, but it is fairly straightforward.
     // Note we do it this way using put_entry() to avoid consecutive entries with the same
     // activity.
+    save_unsaved_changes();
     Transaction transaction(*this);
     Entries::size_type const num_entries = m_entries.size();
     Entries::size_type num_amended = 0;
@@ -358,12 +765,13 @@ TimeLog::Impl::rename_activity(ActivityFilter const& p_activity_filter, string c
         {
             ++num_amended;
         }
-        if (put_entry(new_activity, time_point, num_written))
+        if (put_entry(new_activity, time_point, old_entry.tags, num_written))
         {
             ++num_written; 
         }
     }
     assert (num_written <= m_entries.size());
+    rebuild_tag_index();
     while (m_entries.size() != num_written)
     {
         pop_entry();
@@ -372,38 +780,86 @@ TimeLog::Impl::rename_activity(ActivityFilter const& p_activity_filter, string c
     return num_amended;
 }
 
+size_t
+TimeLog::Impl::merge_entries(EntrySource const& p_source)
+{
+    save_unsaved_changes();
+    Transaction transaction(*this);
+    auto const num_entries_before = m_entries.size();
+    Entries old_entries;
+    old_entries.swap(m_entries);
+    m_entries.reserve(old_entries.size());
+    m_tag_index.clear();
+
+    // Each old entry is pushed afresh, and only then is its original
+    // reference deregistered, so that its activity remains registered
+    // throughout.
+    auto const n = now();
+    auto const old_begin = old_entries.cbegin();
+    auto old_it = old_begin;
+    auto const old_end = old_entries.cend();
+    string activity;
+    TimePoint time_point;
+    string tags;
+    bool provisional = false;
+    TimePoint previous_time_point = TimePoint::min();
+    while (p_source(activity, time_point, tags, provisional))
+    {
+        if (time_point > n)
+        {
+            throw runtime_error("Entry must not be future-dated.");
+        }
+        if (time_point < previous_time_point)
+        {
+            throw runtime_error("Entries to be merged are out of order.");
+        }
+        previous_time_point = time_point;
+        for ( ; (old_it != old_end) && (old_it->time_point <= time_point); ++old_it)
+        {
+            push_entry(activity_at(*old_it), old_it->time_point, old_it->tags);
+            deregister_activity_reference(old_it->activity_id);
+        }
+        auto const existing_at_time_point =
+            (old_it != old_begin) && ((old_it - 1)->time_point == time_point);
+        if (!(provisional && existing_at_time_point))
+        {
+            push_entry
+            (   activity,
+                time_point,
+                (tags.empty() ? nullptr : register_tags(split(squash(tags))))
+            );
+        }
+    }
+    for ( ; old_it != old_end; ++old_it)
+    {
+        push_entry(activity_at(*old_it), old_it->time_point, old_it->tags);
+        deregister_activity_reference(old_it->activity_id);
+    }
+    assert_valid();
+    transaction.commit();
+    assert (m_entries.size() >= num_entries_before);
+    return m_entries.size() - num_entries_before;
+}
+
 vector<Stint>
 TimeLog::Impl::get_stints
-(   ActivityFilter const& p_activity_filter,
+(   ActivityFilter const* p_activity_filter,
+    StintPredicate const* p_predicate,
     TimePoint const* p_begin,
-    TimePoint const* p_end
+    TimePoint const* p_end,
+    vector<string> const& p_tags
 )
 {
+    assert ((p_activity_filter == nullptr) != (p_predicate == nullptr));
     load();
+    Profiler::Phase const phase("get_stints");
     vector<Stint> ret;
-    auto const e = m_entries.end();
-    auto it = (p_begin ? find_entry_just_before(*p_begin) : m_entries.begin());
-    auto const n = now();
-    for ( ; (it != e) && (!p_end || (it->time_point < *p_end)); ++it)
+    StintScan scan(*this, p_activity_filter, p_predicate, p_begin, p_end, p_tags);
+    for ( ; !scan.done(); scan.advance())
     {
-        string const& activity = id_to_activity(it->activity_id);
-        if (p_activity_filter.matches(activity))
-        {
-            auto tp = it->time_point;
-            if (p_begin && (tp < *p_begin)) tp = *p_begin;
-            auto const next_it = it + 1;
-            auto const done = (next_it == e);
-            auto next_tp = (done ? (n > tp ? n: tp) : next_it->time_point);
-            if (p_end && (next_tp > *p_end)) next_tp = *p_end;
-            assert (next_tp >= tp);
-            assert (!p_begin || (tp >= *p_begin));
-            assert (!p_end || (next_tp <= *p_end));
-            auto const duration = next_tp - tp;
-            auto const seconds = chrono::duration_cast<Seconds>(duration);
-            Interval const interval(tp, seconds, done);
-            ret.push_back(Stint(activity, interval));
-        }
+        ret.push_back(scan.current());
     }
+    Profiler::count(Profiler::Counter::stints_produced, ret.size());
     return ret;
 }
 
@@ -464,6 +920,51 @@ TimeLog::Impl::last_entry_time(size_t p_ago)
     return m_entries[index].time_point;
 }
 
+vector<string>
+TimeLog::Impl::activities_at(vector<TimePoint> const& p_time_points)
+{
+    load();
+    Profiler::Phase const phase("activities_at");
+    vector<string> ret(p_time_points.size());
+    auto const b = m_entries.cbegin();
+    auto const e = m_entries.cend();
+    size_t log_num_entries = 1;
+    for (auto n = m_entries.size(); n > 1; n /= 2) ++log_num_entries;
+    if (p_time_points.size() * log_num_entries < m_entries.size())
+    {
+        for (size_t i = 0; i != p_time_points.size(); ++i)
+        {
+            auto const& time_point = p_time_points[i];
+            auto const it = find_entry_just_before(time_point);
+            if ((it != e) && (it->time_point <= time_point))
+            {
+                ret[i] = id_to_activity(it->activity_id);
+            }
+        }
+        return ret;
+    }
+    vector<size_t> order(p_time_points.size());
+    iota(order.begin(), order.end(), 0);
+    sort
+    (   order.begin(),
+        order.end(),
+        [&p_time_points](size_t lhs, size_t rhs)
+        {
+            return p_time_points[lhs] < p_time_points[rhs];
+        }
+    );
+    auto it = b;
+    for (auto const i: order)
+    {
+        auto const& time_point = p_time_points[i];
+        for ( ; (it != e) && (it->time_point <= time_point); ++it)
+        {
+        }
+        if (it != b) ret[i] = id_to_activity((it - 1)->activity_id);
+    }
+    return ret;
+}
+
 bool
 TimeLog::Impl::is_active()
 {
@@ -483,6 +984,8 @@ TimeLog::Impl::clear_cache()
 {
     m_entries.clear();
     m_activity_registry.clear();
+    m_tag_sets.clear();
+    m_tag_index.clear();
     mark_cache_as_stale();
 }
 
@@ -498,17 +1001,37 @@ TimeLog::Impl::load()
     assert_valid();
     if (!m_loaded)
     {
+        Profiler::Phase const phase("load");
         clear_cache();
         if (file_exists_at(m_filepath))
         {
             ifstream infile(m_filepath.c_str());
             enable_exceptions(infile);
             string line;
+            string tags;
             size_t line_number = 1;
             while (infile.peek() != EOF)
             {
                 getline(infile, line);
-                pair<string, TimePoint> const parsed_line = parse_line(line, line_number);
+                auto const is_terminated = !infile.eof();
+                Profiler::count(Profiler::Counter::bytes_read, line.size() + 1);
+                Profiler::count(Profiler::Counter::lines_parsed);
+                tags.clear();
+                pair<string, TimePoint> parsed_line;
+                try
+                {
+                    parsed_line = parse_line(line, line_number, &tags);
+                }
+                catch (runtime_error&)
+                {
+                    // Every entry is written with its newline, so an
+                    // unreadable final line without one is what is left of
+                    // an append cut short by a crash. It is ignored; and as
+                    // the log then no longer ends with its last entry, it
+                    // is rewritten in full, without it, when next saved.
+                    if (is_terminated) throw;
+                    break;
+                }
                 auto const& activity = parsed_line.first;
                 auto const& time_point = parsed_line.second;
                 if (!m_entries.empty() && (time_point < m_entries.back().time_point))
@@ -518,7 +1041,11 @@ TimeLog::Impl::load()
                     oss << "Time log entries out of order at line " << line_number << '.'; 
                     throw runtime_error(oss.str());
                 }
-                push_entry(activity, time_point);
+                push_entry
+                (   activity,
+                    time_point,
+                    (tags.empty() ? nullptr : register_tags(split(squash(tags))))
+                );
                 ++line_number;
             }
             if (!m_entries.empty() && (m_entries.back().time_point > now()))
@@ -529,6 +1056,10 @@ TimeLog::Impl::load()
                 );
             }
         }
+        Profiler::count_peak
+        (   Profiler::Counter::distinct_activities,
+            m_activity_registry.size()
+        );
         m_loaded = true;
     }
     assert_valid();
@@ -537,17 +1068,80 @@ TimeLog::Impl::load()
 void
 TimeLog::Impl::save() const
 {
+    Profiler::Phase const phase("save");
     assert_valid();
     AtomicWriter writer(m_filepath);
+    string line;
     for (auto const& entry: m_entries)
     {
-        write_entry(writer, activity_at(entry), entry.time_point);
+        line.clear();
+        format_entry(line, activity_at(entry), entry.time_point, entry.tags);
+        writer.append(line);
     }
     assert_valid();
     writer.commit();
     assert_valid();
 }
 
+void
+TimeLog::Impl::save_appended(Entries::size_type p_num_kept) const
+{
+    auto const appended = format_tail(p_num_kept);
+    if (appended.empty())
+    {
+        return;
+    }
+    FileStatus status;
+    if ((p_num_kept == 0) || !get_file_status(m_filepath, status))
+    {
+        save();
+        return;
+    }
+    Profiler::Phase const phase("save appended");
+    assert_valid();
+
+    // The new entries are appended only if the file still ends, at a line
+    // boundary, with exactly what the last kept entry would be written as;
+    // anything else (such as an edit by hand, or tags written in a
+    // different order) calls for the whole file to be rewritten.
+    string last_line;
+    auto const& last_kept = m_entries[p_num_kept - 1];
+    format_entry(last_line, activity_at(last_kept), last_kept.time_point, last_kept.tags);
+    if (last_line.size() > status.size)
+    {
+        save();
+        return;
+    }
+    auto const offset = status.size - last_line.size();
+    auto const start = (offset == 0 ? offset : offset - 1);
+    string found(status.size - start, '\0');
+    ifstream infile(m_filepath.c_str(), ios::in | ios::binary);
+    if
+    (   !infile.seekg(start) ||
+        !infile.read(&found[0], found.size()) ||
+        ((offset != 0) && (found[0] != '\n')) ||
+        (found.compare(offset - start, string::npos, last_line) != 0)
+    )
+    {
+        save();
+        return;
+    }
+    Profiler::count(Profiler::Counter::bytes_written, appended.size());
+    append_to_file(m_filepath, appended);
+    assert_valid();
+}
+
+void
+TimeLog::Impl::save_unsaved_changes()
+{
+    if (m_has_unsaved_changes)
+    {
+        assert (m_loaded);
+        save();
+        m_has_unsaved_changes = false;
+    }
+}
+
 TimeLog::Impl::ActivityId
 TimeLog::Impl::register_activity_reference(string const& p_activity)
 {
@@ -580,17 +1174,30 @@ TimeLog::Impl::activity_at(Entry const& p_entry) const
 }
 
 void
-TimeLog::Impl::push_entry(string const& p_activity, TimePoint const& p_time_point)
+TimeLog::Impl::push_entry
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    string const* p_tags
+)
 {
     auto const next_activity_id = register_activity_reference(p_activity);
     if (!m_entries.empty() && (next_activity_id == m_entries.back().activity_id))
     {
         // avoid consecutive entries with the same activity
         deregister_activity_reference(next_activity_id);
+        auto const last = m_entries.size() - 1;
+        auto const tags = merge_tags(m_entries[last].tags, p_tags);
+        if (tags != m_entries[last].tags)
+        {
+            unindex_tags(last);
+            m_entries[last].tags = tags;
+            index_tags(last);
+        }
     }
     else
     {
-        m_entries.emplace_back(next_activity_id, p_time_point);
+        m_entries.emplace_back(next_activity_id, p_time_point, p_tags);
+        index_tags(m_entries.size() - 1);
     }
 }
 
@@ -598,6 +1205,7 @@ bool
 TimeLog::Impl::put_entry
 (   string const& p_activity,
     TimePoint const& p_time_point,
+    string const* p_tags,
     Entries::size_type p_index
 )
 {
@@ -608,22 +1216,187 @@ TimeLog::Impl::put_entry
     if ((p_index != 0) && (m_entries[p_index - 1].activity_id == new_activity_id))
     {
         deregister_activity_reference(new_activity_id);
+        auto& previous = m_entries[p_index - 1];
+        previous.tags = merge_tags(previous.tags, p_tags);
         return false;
     }
     deregister_activity_reference(old_activity_id);
-    m_entries[p_index] = Entry(new_activity_id, p_time_point);
+    m_entries[p_index] = Entry(new_activity_id, p_time_point, p_tags);
+    return true;
+}
+
+bool
+TimeLog::Impl::splice_entry
+(   string const& p_activity,
+    TimePoint const& p_time_point,
+    string const* p_tags,
+    Entries::size_type p_index
+)
+{
+    assert (p_index <= m_entries.size());
+    auto const new_activity_id = register_activity_reference(p_activity);
+
+    // prevent consecutive identical activities
+    if ((p_index != 0) && (m_entries[p_index - 1].activity_id == new_activity_id))
+    {
+        deregister_activity_reference(new_activity_id);
+        return false;
+    }
+    auto const it = m_entries.emplace
+    (   m_entries.begin() + p_index,
+        new_activity_id,
+        p_time_point,
+        p_tags
+    );
+    auto const next_it = it + 1;
+    if ((next_it != m_entries.end()) && (next_it->activity_id == new_activity_id))
+    {
+        it->tags = merge_tags(it->tags, next_it->tags);
+        deregister_activity_reference(next_it->activity_id);
+        m_entries.erase(next_it);
+    }
     return true;
 }
 
+void
+TimeLog::Impl::erase_entry(Entries::size_type p_index)
+{
+    assert (p_index < m_entries.size());
+    deregister_activity_reference(m_entries[p_index].activity_id);
+    auto const it = m_entries.erase(m_entries.begin() + p_index);
+
+    // prevent consecutive identical activities
+    if
+    (   (p_index != 0) &&
+        (it != m_entries.end()) &&
+        ((it - 1)->activity_id == it->activity_id)
+    )
+    {
+        (it - 1)->tags = merge_tags((it - 1)->tags, it->tags);
+        deregister_activity_reference(it->activity_id);
+        m_entries.erase(it);
+    }
+}
+
+TimeLog::Impl::Entries::size_type
+TimeLog::Impl::index_of_entry_from(TimePoint const& p_time_point) const
+{
+    auto const comp = [](Entry const& lhs, TimePoint const& rhs)
+    {
+        return lhs.time_point < rhs;
+    };
+    auto const it = lower_bound(m_entries.begin(), m_entries.end(), p_time_point, comp);
+    return it - m_entries.begin();
+}
+
 void
 TimeLog::Impl::pop_entry()
 {
+    unindex_tags(m_entries.size() - 1);
     deregister_activity_reference(m_entries.back().activity_id);
     m_entries.pop_back();
 }
 
+string const*
+TimeLog::Impl::register_tags(vector<string> p_tags)
+{
+    if (p_tags.empty())
+    {
+        return nullptr;
+    }
+    sort(p_tags.begin(), p_tags.end());
+    p_tags.erase(unique(p_tags.begin(), p_tags.end()), p_tags.end());
+    return &*m_tag_sets.insert(squish(p_tags.begin(), p_tags.end())).first;
+}
+
+string const*
+TimeLog::Impl::merge_tags(string const* p_lhs, string const* p_rhs)
+{
+    if (!p_lhs || (p_lhs == p_rhs))
+    {
+        return p_rhs;
+    }
+    if (!p_rhs)
+    {
+        return p_lhs;
+    }
+    auto tags = split(*p_lhs);
+    auto const rhs_tags = split(*p_rhs);
+    tags.insert(tags.end(), rhs_tags.begin(), rhs_tags.end());
+    return register_tags(move(tags));
+}
+
+void
+TimeLog::Impl::index_tags(Entries::size_type p_index)
+{
+    auto const tags = m_entries[p_index].tags;
+    if (tags)
+    {
+        for (auto const& tag: split(*tags))
+        {
+            auto& positions = m_tag_index[tag];
+            assert (positions.empty() || (positions.back() < p_index));
+            positions.push_back(p_index);
+        }
+    }
+}
+
+void
+TimeLog::Impl::unindex_tags(Entries::size_type p_index)
+{
+    auto const tags = m_entries[p_index].tags;
+    if (tags)
+    {
+        for (auto const& tag: split(*tags))
+        {
+            auto const index_it = m_tag_index.find(tag);
+            assert (index_it != m_tag_index.end());
+            auto& positions = index_it->second;
+            assert (!positions.empty() && (positions.back() == p_index));
+            positions.pop_back();
+            if (positions.empty()) m_tag_index.erase(index_it);
+        }
+    }
+}
+
+void
+TimeLog::Impl::rebuild_tag_index()
+{
+    m_tag_index.clear();
+    for (Entries::size_type i = 0; i != m_entries.size(); ++i)
+    {
+        index_tags(i);
+    }
+}
+
+Interval
+TimeLog::Impl::make_interval
+(   Entries::const_iterator p_it,
+    TimePoint const* p_begin,
+    TimePoint const* p_end,
+    TimePoint const& p_now
+) const
+{
+    auto tp = p_it->time_point;
+    if (p_begin && (tp < *p_begin)) tp = *p_begin;
+    auto const next_it = p_it + 1;
+    auto const done = (next_it == m_entries.cend());
+    auto next_tp = (done ? (p_now > tp ? p_now : tp) : next_it->time_point);
+    if (p_end && (next_tp > *p_end)) next_tp = *p_end;
+    assert (next_tp >= tp);
+    assert (!p_begin || (tp >= *p_begin));
+    assert (!p_end || (next_tp <= *p_end));
+    auto const duration = next_tp - tp;
+    auto const seconds = chrono::duration_cast<Seconds>(duration);
+    return Interval(tp, seconds, done);
+}
+
 pair<string, TimePoint>
-TimeLog::Impl::parse_line(string const& p_entry_string, size_t p_line_number) const
+TimeLog::Impl::parse_line
+(   string const& p_entry_string,
+    size_t p_line_number,
+    string* p_tags
+) const
 {
     if (p_entry_string.size() < m_expected_time_stamp_length)
     {
@@ -636,24 +1409,74 @@ TimeLog::Impl::parse_line(string const& p_entry_string, size_t p_line_number) co
     assert (it > p_entry_string.begin());
     string const time_stamp(p_entry_string.begin(), it);
     auto const time_point = long_time_stamp_to_point(time_stamp, m_time_format);
-    auto const activity = trim(string(it, p_entry_string.end()));
+
+    // Any tags follow the activity after a tab, each marked by
+    // k_tag_marker. As an activity may itself contain a tab (in a log
+    // written before tags were supported), what follows the last tab is
+    // taken for tags only if it starts with a marker; and if it does, but
+    // is not a well formed list of tags, the line is ambiguous.
+    auto activity_end = p_entry_string.end();
+    auto const tab_pos = p_entry_string.rfind('\t');
+    if ((tab_pos != string::npos) && (tab_pos >= m_expected_time_stamp_length))
+    {
+        auto const tab_it = p_entry_string.begin() + tab_pos;
+        auto const first = p_entry_string.find_first_not_of(' ', tab_pos + 1);
+        if ((first != string::npos) && (p_entry_string[first] == k_tag_marker))
+        {
+            string tags;
+            if (!parse_tags(tab_it + 1, p_entry_string.end(), tags))
+            {
+                ostringstream oss;
+                enable_exceptions(oss);
+                oss << "Error parsing the tags in the time log at line "
+                    << p_line_number << '.';
+                throw runtime_error(oss.str());
+            }
+            activity_end = tab_it;
+            if (p_tags) p_tags->swap(tags);
+        }
+    }
+    auto const activity = trim(string(it, activity_end));
     return make_pair(move(activity), move(time_point));
 }
 
 void
-TimeLog::Impl::write_entry
-(   AtomicWriter& p_writer,
+TimeLog::Impl::format_entry
+(   string& p_out,
     string const& p_activity,
-    TimePoint const& p_time_point
+    TimePoint const& p_time_point,
+    string const* p_tags
 ) const
 {
-    p_writer.append(time_point_to_stamp(p_time_point, m_time_format, m_formatted_buf_len));
+    p_out += time_point_to_stamp(p_time_point, m_time_format, m_formatted_buf_len);
     if (!p_activity.empty())
     {
-        p_writer.append(" ");
-        p_writer.append(p_activity);
+        p_out += ' ';
+        p_out += p_activity;
+    }
+    if (p_tags)
+    {
+        p_out += '\t';
+        p_out += k_tag_marker;
+        for (char c: *p_tags)
+        {
+            p_out += c;
+            if (c == ' ') p_out += k_tag_marker;
+        }
     }
-    p_writer.append("\n");
+    p_out += '\n';
+}
+
+string
+TimeLog::Impl::format_tail(Entries::size_type p_index) const
+{
+    string ret;
+    for (auto i = p_index; i < m_entries.size(); ++i)
+    {
+        auto const& entry = m_entries[i];
+        format_entry(ret, activity_at(entry), entry.time_point, entry.tags);
+    }
+    return ret;
 }
 
 string const&
@@ -712,14 +1535,34 @@ TimeLog::Impl::find_entry_just_before(TimePoint const& p_time_point)
             auto const registry_count = registry_iter->second;
             assert (registry_count == check_count);
         }
+
+        // The tag index lists exactly the positions of the entries bearing
+        // each tag.
+        Entries::size_type tagged_total = 0;
+        for (auto const& index_entry: m_tag_index)
+        {
+            assert (!index_entry.second.empty());
+            tagged_total += index_entry.second.size();
+        }
+        Entries::size_type check_tagged_total = 0;
+        for (auto const& entry: m_entries)
+        {
+            if (entry.tags) check_tagged_total += split(*entry.tags).size();
+        }
+        assert (tagged_total == check_tagged_total);
     }
 #endif
 
 // Implementation of TimeLog::Impl::Entry
 
-TimeLog::Impl::Entry::Entry(ActivityId p_activity_id, TimePoint const& p_time_point):
+TimeLog::Impl::Entry::Entry
+(   ActivityId p_activity_id,
+    TimePoint const& p_time_point,
+    string const* p_tags
+):
     activity_id(p_activity_id),
-    time_point(p_time_point)
+    time_point(p_time_point),
+    tags(p_tags)
 {
 }
 
@@ -742,14 +1585,217 @@ TimeLog::Impl::Transaction::~Transaction()
 void
 TimeLog::Impl::Transaction::commit()
 {
-    m_time_log_impl.save();
+    if (m_time_log_impl.m_saving_deferred)
+    {
+        m_time_log_impl.m_has_unsaved_changes = true;
+    }
+    else
+    {
+        m_time_log_impl.save();
+    }
+    m_committed = true;
+}
+
+void
+TimeLog::Impl::Transaction::commit(Entries::size_type p_num_kept)
+{
+    if (m_time_log_impl.m_saving_deferred)
+    {
+        m_time_log_impl.m_has_unsaved_changes = true;
+    }
+    else
+    {
+        m_time_log_impl.save_appended(p_num_kept);
+    }
     m_committed = true;
 }
 
 void
 TimeLog::Impl::Transaction::rollback()
 {
-    m_time_log_impl.mark_cache_as_stale();
+    // The in-memory cache may be part way through a change, so it is
+    // discarded; which also discards any changes whose saving has been
+    // deferred.
+    m_time_log_impl.m_has_unsaved_changes = false;
+    m_time_log_impl.clear_cache();
+}
+
+
+// Implementation of TimeLog::StintScan
+
+TimeLog::StintScan::StintScan
+(   TimeLog::Impl& p_time_log,
+    ActivityFilter const* p_activity_filter,
+    StintPredicate const* p_predicate,
+    TimePoint const* p_begin,
+    TimePoint const* p_end,
+    vector<string> const& p_tags
+):
+    m_time_log(p_time_log),
+    m_activity_filter(p_activity_filter),
+    m_predicate(p_predicate),
+    m_has_begin(p_begin != nullptr),
+    m_has_end(p_end != nullptr),
+    m_begin(p_begin ? *p_begin : TimePoint()),
+    m_end(p_end ? *p_end : TimePoint()),
+    m_now(now())
+{
+    assert ((p_activity_filter == nullptr) != (p_predicate == nullptr));
+    p_time_log.load();
+    auto const& entries = m_time_log.m_entries;
+    Positions::size_type const first =
+        (p_begin ? p_time_log.find_entry_just_before(*p_begin) - entries.cbegin() : 0);
+    if (p_tags.empty())
+    {
+        m_next = first;
+        seek();
+        return;
+    }
+    for (auto const& tag: p_tags)
+    {
+        auto const index_it = m_time_log.m_tag_index.find(tag);
+        if (index_it == m_time_log.m_tag_index.end())
+        {
+            m_done = true;
+            return;
+        }
+        m_position_lists.push_back(&index_it->second);
+    }
+    sort
+    (   m_position_lists.begin(),
+        m_position_lists.end(),
+        [](Positions const* lhs, Positions const* rhs)
+        {
+            return lhs->size() < rhs->size();
+        }
+    );
+    auto const& rarest = *m_position_lists.front();
+    m_next = lower_bound(rarest.begin(), rarest.end(), first) - rarest.begin();
+    seek();
+}
+
+bool
+TimeLog::StintScan::done() const
+{
+    return m_done;
+}
+
+Stint
+TimeLog::StintScan::current() const
+{
+    assert (!m_done);
+    auto const it = m_time_log.m_entries.cbegin() + m_current;
+    return Stint(m_time_log.activity_at(*it), interval(it));
+}
+
+void
+TimeLog::StintScan::advance()
+{
+    assert (!m_done);
+    seek();
+}
+
+void
+TimeLog::StintScan::seek()
+{
+    auto const b = m_time_log.m_entries.cbegin();
+    if (m_position_lists.empty())
+    {
+        auto const size = m_time_log.m_entries.size();
+        for ( ; m_next != size; ++m_next)
+        {
+            auto const it = b + m_next;
+            if (m_has_end && (it->time_point >= m_end))
+            {
+                break;
+            }
+            if (matches(it))
+            {
+                m_current = m_next++;
+                return;
+            }
+        }
+        m_done = true;
+        return;
+    }
+
+    // Walk the positions of the rarest tag, checking each against the
+    // positions of the others.
+    auto const& rarest = *m_position_lists.front();
+    for ( ; m_next != rarest.size(); ++m_next)
+    {
+        auto const position = rarest[m_next];
+        auto const it = b + position;
+        if (m_has_end && (it->time_point >= m_end))
+        {
+            break;
+        }
+        auto const has_tag = [position](Positions const* p_positions)
+        {
+            return binary_search(p_positions->begin(), p_positions->end(), position);
+        };
+        if (all_of(m_position_lists.begin() + 1, m_position_lists.end(), has_tag) && matches(it))
+        {
+            m_current = position;
+            ++m_next;
+            return;
+        }
+    }
+    m_done = true;
+}
+
+bool
+TimeLog::StintScan::matches(Entries::const_iterator p_it) const
+{
+    auto const& activity = m_time_log.activity_at(*p_it);
+    if (m_activity_filter)
+    {
+        return m_activity_filter->matches(activity);
+    }
+    return (*m_predicate)(activity, interval(p_it), p_it->tags);
+}
+
+Interval
+TimeLog::StintScan::interval(Entries::const_iterator p_it) const
+{
+    return m_time_log.make_interval
+    (   p_it,
+        (m_has_begin ? &m_begin : nullptr),
+        (m_has_end ? &m_end : nullptr),
+        m_now
+    );
+}
+
+// Implementation of TimeLog::StintCursor
+
+TimeLog::StintCursor::StintCursor(unique_ptr<StintScan> p_scan):
+    m_scan(move(p_scan))
+{
+}
+
+TimeLog::StintCursor::StintCursor(StintCursor&& rhs) = default;
+
+TimeLog::StintCursor&
+TimeLog::StintCursor::operator=(StintCursor&& rhs) = default;
+
+TimeLog::StintCursor::~StintCursor() = default;
+
+bool
+TimeLog::StintCursor::done() const
+{
+    return m_scan->done();
+}
+
+Stint
+TimeLog::StintCursor::current() const
+{
+    return m_scan->current();
+}
+
+void
+TimeLog::StintCursor::advance()
+{
+    m_scan->advance();
 }
 
 }  // namespace swx
@@ -16,6 +16,7 @@
 
 #include "time_point.hpp"
 #include "config.hpp"
+#include "profiler.hpp"
 #include <chrono>
 #include <cstring>
 #include <ctime>
@@ -25,7 +26,6 @@
 
 namespace chrono = std::chrono;
 
-using std::localtime;
 using std::memset;
 using std::mktime;
 using std::runtime_error;
@@ -74,12 +74,34 @@ day_end(TimePoint const& p_time_point, int p_days_diff)
     return tm_to_time_point(time_tm);
 }
 
+TimePoint
+week_begin(TimePoint const& p_time_point, int p_weeks_diff)
+{
+    tm const time_tm = time_point_to_tm(p_time_point);
+    int const days_since_monday = (time_tm.tm_wday + 6) % 7;
+    return day_begin(p_time_point, p_weeks_diff * 7 - days_since_monday);
+}
+
+TimePoint
+month_begin(TimePoint const& p_time_point, int p_months_diff)
+{
+    tm time_tm = time_point_to_tm(p_time_point);
+    time_tm.tm_mon += p_months_diff;
+    time_tm.tm_mday = 1;
+    time_tm.tm_hour = time_tm.tm_min = time_tm.tm_sec = 0;
+    time_tm.tm_isdst = -1;
+    return tm_to_time_point(time_tm);
+}
+
 tm
 time_point_to_tm(TimePoint const& p_time_point)
 {
     time_t const time_time_t = chrono::system_clock::to_time_t(p_time_point);
-    tm* const time_tm_ptr = localtime(&time_time_t);
-    return *time_tm_ptr;
+    // localtime_r rather than localtime, as time logs may be loaded on
+    // several threads at once.
+    tm ret;
+    localtime_r(&time_time_t, &ret);  // non-portable
+    return ret;
 }
 
 TimePoint
@@ -98,6 +120,7 @@ long_time_stamp_to_point(string const& p_time_stamp, string const& p_format)
     auto tm = zeroed_tm();
     
     // non-portable
+    Profiler::count(Profiler::Counter::strptime_calls);
     if (strptime(p_time_stamp.c_str(), format, &tm) == nullptr)
     {
         string const errmsg = "Could not parse timestamp: " + p_time_stamp;
@@ -121,11 +144,13 @@ time_stamp_to_point
     // non-portable
 
     // try long format first
+    Profiler::count(Profiler::Counter::strptime_calls);
     if (strptime(p_time_stamp.c_str(), long_format, &tm) == nullptr)
     {
         // try short format instead
         char const* short_format = p_short_format.c_str();
         tm = time_point_to_tm(day_begin(now()));
+        Profiler::count(Profiler::Counter::strptime_calls);
 
         if (strptime(p_time_stamp.c_str(), short_format, &tm) == nullptr)
         {
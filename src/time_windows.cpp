@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "time_windows.hpp"
+#include "interval.hpp"
+#include "recurring_window.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using std::chrono::duration_cast;
+using std::function;
+using std::max;
+using std::min;
+using std::pair;
+using std::sort;
+using std::vector;
+
+namespace swx
+{
+
+namespace
+{
+    using Span = pair<TimePoint, TimePoint>;
+
+    // Appends to p_spans the occurrence of each of p_windows beginning on
+    // the day beginning at p_day_beginning.
+    void add_occurrences
+    (   vector<RecurringWindow> const& p_windows,
+        TimePoint const& p_day_beginning,
+        vector<Span>& p_spans
+    )
+    {
+        Span span;
+        for (auto const& window: p_windows)
+        {
+            if (window.occurs_on(p_day_beginning, span.first, span.second))
+            {
+                p_spans.push_back(span);
+            }
+        }
+    }
+
+}  // end anonymous namespace
+
+TimeWindows::TimeWindows
+(   vector<RecurringWindow> const& p_within,
+    vector<RecurringWindow> const& p_except
+):
+    m_within(p_within),
+    m_except(p_except)
+{
+}
+
+TimeWindows::~TimeWindows() = default;
+
+bool
+TimeWindows::is_unrestricted() const
+{
+    return m_within.empty() && m_except.empty();
+}
+
+void
+TimeWindows::restrict(Stint const& p_stint, function<void(Stint const&)> const& p_sink)
+{
+    if (is_unrestricted())
+    {
+        p_sink(p_stint);
+        return;
+    }
+    auto const interval = p_stint.interval();
+    auto const beginning = interval.beginning();
+    auto const ending = interval.ending();
+    if (!m_is_started)
+    {
+        // An occurrence beginning the day before may run on into this one.
+        m_next_day = day_begin(beginning, -1);
+        m_is_started = true;
+    }
+    while (m_next_day < ending) generate_day();
+
+    // Later stints begin no earlier than this one, so nothing ending before
+    // it is needed again.
+    while (!m_allowed.empty() && (m_allowed.front().second <= beginning))
+    {
+        m_allowed.pop_front();
+    }
+    for (auto const& span: m_allowed)
+    {
+        if (span.first >= ending) break;
+        auto const part_beginning = max(beginning, span.first);
+        auto const part_ending = min(ending, span.second);
+        if (part_beginning >= part_ending) continue;
+        Interval const part
+        (   part_beginning,
+            duration_cast<Seconds>(part_ending - part_beginning),
+            interval.is_live() && (part_ending == ending)
+        );
+        p_sink(Stint(p_stint.activity(), part));
+    }
+}
+
+void
+TimeWindows::generate_day()
+{
+    auto const day = m_next_day;
+    m_next_day = day_begin(day, 1);
+    vector<Span> within;
+    if (m_within.empty()) within.push_back(Span(day, m_next_day));
+    else add_occurrences(m_within, day, within);
+    if (within.empty()) return;
+    sort(within.begin(), within.end());
+
+    // An occurrence may run into the next day, so may overlap exclusions
+    // beginning the day before, the same day or the day after.
+    vector<Span> except;
+    add_occurrences(m_except, day_begin(day, -1), except);
+    add_occurrences(m_except, day, except);
+    add_occurrences(m_except, m_next_day, except);
+    sort(except.begin(), except.end());
+
+    for (auto const& span: within)
+    {
+        auto remaining_beginning = span.first;
+        for (auto const& excluded: except)
+        {
+            if (excluded.first >= span.second) break;
+            if (excluded.second <= remaining_beginning) continue;
+            if (excluded.first > remaining_beginning)
+            {
+                append(remaining_beginning, excluded.first);
+            }
+            remaining_beginning = max(remaining_beginning, excluded.second);
+        }
+        if (remaining_beginning < span.second)
+        {
+            append(remaining_beginning, span.second);
+        }
+    }
+}
+
+void
+TimeWindows::append(TimePoint const& p_beginning, TimePoint const& p_ending)
+{
+    if (!m_allowed.empty() && (p_beginning <= m_allowed.back().second))
+    {
+        auto& last = m_allowed.back();
+        last.second = max(last.second, p_ending);
+        return;
+    }
+    m_allowed.push_back(Span(p_beginning, p_ending));
+}
+
+}  // namespace swx
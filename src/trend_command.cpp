@@ -0,0 +1,410 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "trend_command.hpp"
+#include "activity_filter.hpp"
+#include "arithmetic.hpp"
+#include "command.hpp"
+#include "config.hpp"
+#include "csv_row.hpp"
+#include "help_line.hpp"
+#include "interval.hpp"
+#include "placeholder.hpp"
+#include "profiler.hpp"
+#include "report_writer.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "stream_flag_guard.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include "trend_series.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::endl;
+using std::fixed;
+using std::left;
+using std::map;
+using std::max;
+using std::min;
+using std::ostream;
+using std::right;
+using std::runtime_error;
+using std::setprecision;
+using std::setw;
+using std::size_t;
+using std::string;
+using std::stringstream;
+using std::to_string;
+using std::unique_ptr;
+using std::vector;
+using std::chrono::duration_cast;
+
+namespace swx
+{
+
+namespace
+{
+    auto const k_date_format = "%Y-%m-%d";
+
+    bool parse_positive(string const& p_str, unsigned int& p_value)
+    {
+        stringstream ss(p_str);
+        ss >> p_value;
+        return ss && ss.eof() && (p_value != 0);
+    }
+
+}  // end anonymous namespace
+
+TrendCommand::TrendCommand
+(   string const& p_command_word,
+    vector<string> const& p_aliases,
+    TimeLog& p_time_log
+):
+    Command
+    (   p_command_word,
+        p_aliases,
+        "Print daily totals with moving averages",
+        vector<HelpLine>
+        {   HelpLine
+            (   "Print, for each day and each activity, the hours spent that day, "
+                    "the mean daily hours over the last 7 and 30 days, and an "
+                    "exponentially smoothed average of the daily hours"
+            ),
+            HelpLine
+            (   "Print the same, but only for ACTIVITY and its subactivities",
+                "<ACTIVITY>"
+            )
+        }
+    ),
+    m_time_log(p_time_log)
+{
+    add_option
+    (   vector<string>{"x", "exact"},
+        "Include only the exact ACTIVITY given; not its subactivities",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::exact; }
+    );
+    add_option
+    (   vector<string>{"r", "regex"},
+        "Treat ACTIVITY as a regular expression, and include all activities "
+            "that match it",
+        [this]() { m_activity_filter_type = ActivityFilter::Type::regex; }
+    );
+    add_option
+    (   vector<string>{"c", "combine"},
+        "Rather than a series for each activity, print a single series for "
+            "all the activities included",
+        [this]() { m_combine = true; }
+    );
+    add_option
+    (   vector<string>{"a", "average"},
+        HelpLine
+        (   "Show the mean daily hours over the last N days; may be passed more "
+                "than once (by default, averages over 7 and 30 days are shown)",
+            "<N>"
+        ),
+        &m_period_strs
+    );
+    add_option
+    (   vector<string>{"e", "ema"},
+        HelpLine
+        (   "Give the exponentially smoothed average a span of N days, weighting "
+                "each day by 2 / (N + 1) (default 7)",
+            "<N>"
+        ),
+        nullptr,
+        &m_span_str
+    );
+    add_option
+    (   vector<string>{"f", "from"},
+        HelpLine
+        (   "Begin with the day on which TIMESTAMP falls (by default the first "
+                "day with an activity included); averages still take account "
+                "of earlier days",
+            "<TIMESTAMP>"
+        ),
+        nullptr,
+        &m_since_str
+    );
+    add_option
+    (   vector<string>{"t", "to"},
+        HelpLine
+        (   "End with the day on which TIMESTAMP falls (by default today)",
+            "<TIMESTAMP>"
+        ),
+        nullptr,
+        &m_until_str
+    );
+    add_option
+    (   vector<string>{"csv"},
+        "Output in CSV format, with a row for each activity on each day",
+        [this]() { m_csv = true; }
+    );
+}
+
+TrendCommand::~TrendCommand() = default;
+
+bool
+TrendCommand::does_support_placeholders() const
+{
+    return true;
+}
+
+Command::ErrorMessages
+TrendCommand::do_process
+(   Config const& p_config,
+    vector<string> const& p_ordinary_args,
+    ostream& p_ordinary_ostream
+)
+{
+    ErrorMessages ret;
+    vector<size_t> periods;
+    for (auto const& period_str: m_period_strs)
+    {
+        unsigned int period = 0;
+        if (parse_positive(period_str, period))
+        {
+            periods.push_back(period);
+        }
+        else
+        {
+            ret.push_back("Could not parse \"" + period_str + "\" as positive numeric argument.");
+        }
+    }
+    if (m_period_strs.empty()) periods = vector<size_t>{7, 30};
+    unsigned int span = 0;
+    if (!parse_positive(m_span_str, span))
+    {
+        ret.push_back("Could not parse \"" + m_span_str + "\" as positive numeric argument.");
+    }
+    auto const long_time_fmt = p_config.time_format();
+    auto const short_time_fmt = p_config.short_time_format();
+    auto until = now();
+    unique_ptr<TimePoint> since_time_point_ptr;
+    if (!m_since_str.empty())
+    {
+        try
+        {
+            since_time_point_ptr.reset
+            (   new TimePoint
+                (   time_stamp_to_point(m_since_str, long_time_fmt, short_time_fmt)
+                )
+            );
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_since_str);
+        }
+    }
+    if (!m_until_str.empty())
+    {
+        try
+        {
+            until = time_stamp_to_point(m_until_str, long_time_fmt, short_time_fmt);
+        }
+        catch (runtime_error&)
+        {
+            ret.push_back("Could not parse timestamp: " + m_until_str);
+        }
+    }
+    if (!ret.empty())
+    {
+        return ret;
+    }
+
+    string comparitor;
+    auto filter_type = m_activity_filter_type;
+    if (p_ordinary_args.empty())
+    {
+        filter_type = ActivityFilter::Type::always_true;
+    }
+    else
+    {
+        comparitor = expand_placeholders(p_ordinary_args, m_time_log);
+    }
+    unique_ptr<ActivityFilter> const
+        filter(ActivityFilter::create(comparitor, filter_type));
+    string const combined_label = comparitor.empty() ? string("TOTAL") : comparitor;
+
+    // Days run up to the end of the day of "until" (or to "until" itself, if
+    // that is midnight). When the first day shown is given, the days before it
+    // are still read, far enough back for the averages to be full from the
+    // start.
+    auto const last_ending = (day_begin(until) == until) ? until : day_end(until);
+    size_t const longest_index =
+        max_element(periods.begin(), periods.end()) - periods.begin();
+    auto const warm_up_days = max<size_t>(periods[longest_index], span);
+    vector<Stint> stints;
+    TimePoint first_shown = last_ending;
+    TimePoint reading_beginning = last_ending;
+    if (since_time_point_ptr)
+    {
+        first_shown = day_begin(*since_time_point_ptr);
+        reading_beginning = day_begin(first_shown, -static_cast<int>(warm_up_days));
+        stints = m_time_log.get_stints(*filter, &reading_beginning, &last_ending);
+    }
+    else
+    {
+        stints = m_time_log.get_stints(*filter, nullptr, &last_ending);
+        for (auto const& stint: stints)
+        {
+            if (stint.activity().empty()) continue;
+            first_shown = reading_beginning = day_begin(stint.interval().beginning());
+            break;
+        }
+    }
+
+    ReportWriter::Options const options
+    (   p_config.output_rounding_numerator(),
+        p_config.output_rounding_denominator(),
+        p_config.output_precision(),
+        p_config.output_width(),
+        p_config.formatted_buf_len(),
+        p_config.time_format(),
+        0
+    );
+    auto const to_rounded_hours = [&options](double p_seconds)
+    {
+        return round
+        (   p_seconds / 60.0 / 60.0,
+            options.output_rounding_numerator,
+            options.output_rounding_denominator
+        );
+    };
+    vector<string> column_labels{"hours"};
+    for (auto const period: periods) column_labels.push_back(to_string(period) + "-day");
+    column_labels.push_back("EMA");
+    vector<string::size_type> column_widths;
+    for (auto const& label: column_labels)
+    {
+        column_widths.push_back(max<string::size_type>(label.length(), options.output_width));
+    }
+    auto const date_width = time_point_to_stamp
+    (   first_shown,
+        k_date_format,
+        options.formatted_buf_len
+    ).length();
+
+    if (m_csv)
+    {
+        CsvRow header;
+        header << "date" << "activity";
+        for (auto const& label: column_labels) header << label;
+        p_ordinary_ostream << header;
+    }
+    else if (first_shown < last_ending)
+    {
+        StreamFlagGuard guard(p_ordinary_ostream);
+        p_ordinary_ostream << left << setw(date_width) << "date" << right;
+        for (size_t i = 0; i != column_labels.size(); ++i)
+        {
+            p_ordinary_ostream << "  " << setw(column_widths[i]) << column_labels[i];
+        }
+        guard.reset();
+        p_ordinary_ostream << "  activity" << endl;
+    }
+
+    Profiler::Phase const phase("trend");
+    map<string, TrendSeries> series;
+    map<string, unsigned long long> day_totals;
+    size_t day_number = 0;
+    auto day_beginning = reading_beginning;
+    auto day_ending = day_begin(day_beginning, 1);
+
+    // Pushes the totals for the current day to every series, writes a row for
+    // each series that has had time within its longest period, and moves on
+    // to the next day.
+    auto const close_day = [&]()
+    {
+        auto const shown = (day_beginning >= first_shown);
+        auto const date = shown ?
+            time_point_to_stamp(day_beginning, k_date_format, options.formatted_buf_len) :
+            string();
+        for (auto& entry: series)
+        {
+            auto& trend = entry.second;
+            auto const it = day_totals.find(entry.first);
+            trend.push((it == day_totals.end()) ? 0 : it->second);
+            if (!shown || (trend.sum(longest_index) == 0)) continue;
+            vector<double> values{static_cast<double>(trend.latest())};
+            for (size_t i = 0; i != periods.size(); ++i)
+            {
+                values.push_back(trend.moving_average(i));
+            }
+            values.push_back(trend.smoothed_average());
+            if (m_csv)
+            {
+                CsvRow row;
+                row << date << entry.first;
+                for (auto const value: values) row << to_rounded_hours(value);
+                p_ordinary_ostream << row;
+            }
+            else
+            {
+                StreamFlagGuard guard(p_ordinary_ostream);
+                p_ordinary_ostream << left << setw(date_width) << date
+                                   << right << fixed
+                                   << setprecision(options.output_precision);
+                for (size_t i = 0; i != values.size(); ++i)
+                {
+                    p_ordinary_ostream << "  " << setw(column_widths[i])
+                                       << to_rounded_hours(values[i]);
+                }
+                guard.reset();
+                p_ordinary_ostream << "  " << entry.first << endl;
+            }
+        }
+        day_totals.clear();
+        ++day_number;
+        day_beginning = day_ending;
+        day_ending = day_begin(day_ending, 1);
+    };
+
+    for (auto const& stint: stints)
+    {
+        if (stint.activity().empty()) continue;
+        auto const& label = m_combine ? combined_label : stint.activity();
+        if (series.find(label) == series.end())
+        {
+            // The days already closed had no time on this activity.
+            series.emplace(label, TrendSeries(periods, span, day_number));
+        }
+        auto const interval = stint.interval();
+        auto beginning = max(interval.beginning(), reading_beginning);
+        auto const ending = min(interval.ending(), last_ending);
+        while (beginning < ending)
+        {
+            while (beginning >= day_ending) close_day();
+            auto const piece_ending = min(ending, day_ending);
+            day_totals[label] += duration_cast<Seconds>(piece_ending - beginning).count();
+            beginning = piece_ending;
+        }
+    }
+    while (day_beginning < last_ending) close_day();
+    return ret;
+}
+
+}  // namespace swx
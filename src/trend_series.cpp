@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "trend_series.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using std::invalid_argument;
+using std::max;
+using std::min;
+using std::size_t;
+using std::vector;
+
+namespace swx
+{
+
+TrendSeries::TrendSeries
+(   vector<size_t> const& p_periods,
+    size_t p_smoothing_span,
+    size_t p_leading_days
+):
+    m_days(p_leading_days),
+    m_smoothing_factor(2.0 / (p_smoothing_span + 1.0)),
+    m_periods(p_periods),
+    m_sums(p_periods.size(), 0)
+{
+    if (p_smoothing_span == 0)
+    {
+        throw invalid_argument("Smoothing span must be positive.");
+    }
+    size_t longest = 1;
+    for (auto const period: m_periods)
+    {
+        if (period == 0) throw invalid_argument("Period must be positive.");
+        longest = max(longest, period);
+    }
+    m_ring.assign(longest, 0);
+}
+
+void
+TrendSeries::push(unsigned long long p_seconds)
+{
+    auto const capacity = m_ring.size();
+    auto const slot = m_days % capacity;
+    for (size_t i = 0; i != m_periods.size(); ++i)
+    {
+        auto const period = m_periods[i];
+        if (m_days >= period)
+        {
+            // The day leaving this period was pushed "period" days ago. For
+            // the longest period, this is the slot about to be overwritten.
+            m_sums[i] -= m_ring[(m_days - period) % capacity];
+        }
+        m_sums[i] += p_seconds;
+    }
+    m_ring[slot] = p_seconds;
+    if (m_days == 0)
+    {
+        m_smoothed_average = static_cast<double>(p_seconds);
+    }
+    else
+    {
+        m_smoothed_average +=
+            m_smoothing_factor * (static_cast<double>(p_seconds) - m_smoothed_average);
+    }
+    ++m_days;
+}
+
+size_t
+TrendSeries::days() const
+{
+    return m_days;
+}
+
+unsigned long long
+TrendSeries::latest() const
+{
+    if (m_days == 0) return 0;
+    return m_ring[(m_days - 1) % m_ring.size()];
+}
+
+unsigned long long
+TrendSeries::sum(size_t p_index) const
+{
+    assert (p_index < m_sums.size());
+    return m_sums[p_index];
+}
+
+double
+TrendSeries::moving_average(size_t p_index) const
+{
+    assert (p_index < m_sums.size());
+    auto const days = min(m_days, m_periods[p_index]);
+    if (days == 0) return 0.0;
+    return static_cast<double>(m_sums[p_index]) / days;
+}
+
+double
+TrendSeries::smoothed_average() const
+{
+    return m_smoothed_average;
+}
+
+}  // namespace swx
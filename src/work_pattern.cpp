@@ -0,0 +1,188 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "work_pattern.hpp"
+#include "duration_sketch.hpp"
+#include "interval.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::hash;
+using std::max_element;
+using std::partial_sort;
+using std::size_t;
+using std::sort;
+using std::string;
+using std::vector;
+
+namespace swx
+{
+
+size_t
+WorkPattern::ActivityPairHash::operator()(ActivityPair const& p_pair) const
+{
+    hash<string const*> const hasher;
+    return hasher(p_pair.first) * 31 + hasher(p_pair.second);
+}
+
+void
+WorkPattern::add(Stint const& p_stint, bool p_is_included)
+{
+    auto const interval = p_stint.interval();
+    auto const& activity = p_stint.activity();
+    if (activity.empty())
+    {
+        // Only a closed gap that is followed by activity is counted, so
+        // the idle time before the first activity, and since the last, is
+        // left out.
+        m_previous_activity = nullptr;
+        m_has_pending_gap = m_has_been_active && !interval.is_live();
+        m_pending_gap = interval.duration().count();
+        return;
+    }
+    if (m_has_pending_gap)
+    {
+        m_idle_gaps.add(m_pending_gap);
+        m_has_pending_gap = false;
+    }
+    m_has_been_active = true;
+    auto const is_switch =
+        m_previous_activity &&
+        (m_previous_activity != &activity) &&
+        (p_is_included || m_is_previous_included);
+    if (p_is_included || is_switch)
+    {
+        begin_day(day_begin(interval.beginning()));
+    }
+    if (is_switch)
+    {
+        ++m_day_switches;
+        ++m_switches;
+        auto key = (*m_previous_activity < activity) ?
+            ActivityPair(m_previous_activity, &activity) :
+            ActivityPair(&activity, m_previous_activity);
+        ++m_pair_counts[key];
+    }
+    if (p_is_included && !interval.is_live())
+    {
+        m_focus_blocks.add(interval.duration().count());
+    }
+    m_previous_activity = &activity;
+    m_is_previous_included = p_is_included;
+}
+
+size_t
+WorkPattern::days() const
+{
+    return m_closed_daily_switches.size() + (m_is_day_open ? 1 : 0);
+}
+
+unsigned long long
+WorkPattern::switches() const
+{
+    return m_switches;
+}
+
+double
+WorkPattern::mean_daily_switches() const
+{
+    auto const num_days = days();
+    return (num_days == 0) ? 0.0 : (static_cast<double>(m_switches) / num_days);
+}
+
+double
+WorkPattern::median_daily_switches() const
+{
+    auto counts = daily_switches();
+    if (counts.empty()) return 0.0;
+    sort(counts.begin(), counts.end());
+    auto const middle = counts.size() / 2;
+    if (counts.size() % 2 == 1) return counts[middle];
+    return (counts[middle - 1] + counts[middle]) / 2.0;
+}
+
+unsigned long long
+WorkPattern::most_daily_switches() const
+{
+    auto const counts = daily_switches();
+    return counts.empty() ? 0 : *max_element(counts.begin(), counts.end());
+}
+
+DurationSketch const&
+WorkPattern::focus_blocks() const
+{
+    return m_focus_blocks;
+}
+
+DurationSketch const&
+WorkPattern::idle_gaps() const
+{
+    return m_idle_gaps;
+}
+
+vector<WorkPattern::SwitchCount>
+WorkPattern::top_switches(size_t p_k) const
+{
+    vector<SwitchCount> ret;
+    ret.reserve(m_pair_counts.size());
+    for (auto const& entry: m_pair_counts)
+    {
+        ret.push_back(SwitchCount{entry.first.first, entry.first.second, entry.second});
+    }
+    auto const comp = [](SwitchCount const& lhs, SwitchCount const& rhs)
+    {
+        if (lhs.count != rhs.count) return lhs.count > rhs.count;
+        if (*lhs.first != *rhs.first) return *lhs.first < *rhs.first;
+        return *lhs.second < *rhs.second;
+    };
+    if (p_k < ret.size())
+    {
+        partial_sort(ret.begin(), ret.begin() + p_k, ret.end(), comp);
+        ret.resize(p_k);
+    }
+    else
+    {
+        sort(ret.begin(), ret.end(), comp);
+    }
+    return ret;
+}
+
+void
+WorkPattern::begin_day(TimePoint const& p_day_beginning)
+{
+    if (m_is_day_open && (p_day_beginning == m_day_beginning)) return;
+    if (m_is_day_open) m_closed_daily_switches.push_back(m_day_switches);
+    m_is_day_open = true;
+    m_day_beginning = p_day_beginning;
+    m_day_switches = 0;
+}
+
+vector<unsigned long long>
+WorkPattern::daily_switches() const
+{
+    auto ret = m_closed_daily_switches;
+    if (m_is_day_open) ret.push_back(m_day_switches);
+    return ret;
+}
+
+}  // namespace swx
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "application.hpp"
+#include "config.hpp"
+#include "exit_code.hpp"
+#include "temp_directory.hpp"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::ostringstream;
+using std::string;
+using std::vector;
+using swx::Application;
+using swx::Config;
+
+namespace test
+{
+
+BOOST_AUTO_TEST_CASE(batch_command_failed_line)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "swxrc",
+        "path_to_log=" + dir.path("log.swx") + "\n"
+        "path_to_goals=" + dir.path("goals") + "\n"
+        "path_to_notes=" + dir.path("notes") + "\n"
+    );
+    dir.write("future.swx", "2099-01-01T00:00 gamma\n");
+    dir.write
+    (   "batch",
+        "switch -c alpha --at 2020-03-01T09:00\n"
+        "switch -c beta --at 2020-03-01T10:00\n"
+        "import " + dir.path("future.swx") + "\n"
+        "switch alpha --at 2020-03-01T11:00\n"
+    );
+    Config const config(dir.path("swxrc"));
+    ostringstream ordinary_stream;
+    ostringstream error_stream;
+    {
+        Application const application(config, ordinary_stream, error_stream);
+        auto const exit_code =
+            application.process_command("batch", vector<string>{dir.path("batch")});
+        BOOST_CHECK(exit_code != EXIT_SUCCESS);
+    }
+    BOOST_CHECK(error_stream.str().find("Line 3:") != string::npos);
+
+    // The failed import discards only itself, and not the lines before it.
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-01T10:00 beta\n"
+        "2020-03-01T11:00 alpha\n"
+    );
+}
+
+}  // namespace test
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bucket_report_writer.hpp"
+#include "interval.hpp"
+#include "report_writer.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::ostringstream;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+using swx::Interval;
+using swx::ReportWriter;
+using swx::Seconds;
+using swx::Stint;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+
+    Stint make_stint(string const& p_activity, string const& p_beginning, unsigned int p_hours)
+    {
+        return Stint
+        (   p_activity,
+            Interval
+            (   long_time_stamp_to_point(p_beginning, k_time_format),
+                Seconds(p_hours * 60 * 60)
+            )
+        );
+    }
+
+    string write(vector<Stint> const& p_stints, ReportWriter::Flags::Type p_flags)
+    {
+        ReportWriter::Options const options(1, 10, 1, 6, 80, k_time_format, 0);
+        unique_ptr<ReportWriter> const writer
+        (   ReportWriter::create
+            (   p_stints,
+                options,
+                p_flags | ReportWriter::Flags::csv
+            )
+        );
+        ostringstream oss;
+        writer->write(oss);
+        return oss.str();
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(bucket_report_writer)
+{
+    string const alpha = "alpha";
+    string const beta = "beta";
+    string const inactive;
+    vector<Stint> const stints
+    {   make_stint(alpha, "2020-02-28T22:00", 4),
+        make_stint(inactive, "2020-02-29T02:00", 7),
+        make_stint(beta, "2020-02-29T09:00", 40),
+        // Stints from merged logs may overlap, and precede the first bucket.
+        make_stint(alpha, "2020-02-26T23:00", 2)
+    };
+    BOOST_CHECK_EQUAL
+    (   write(stints, ReportWriter::Flags::by_day),
+        "activity,2020-02-26,2020-02-27,2020-02-28,2020-02-29,2020-03-01,2020-03-02\n"
+        "alpha,1,1,2,2,0,0\n"
+        "beta,0,0,0,15,24,1\n"
+    );
+    BOOST_CHECK_EQUAL
+    (   write(stints, ReportWriter::Flags::by_week),
+        "activity,2020-02-24,2020-03-02\n"
+        "alpha,6,0\n"
+        "beta,39,1\n"
+    );
+    BOOST_CHECK_EQUAL
+    (   write(stints, ReportWriter::Flags::by_month | ReportWriter::Flags::succinct),
+        "2020-02,2020-03\n"
+        "21,25\n"
+    );
+    BOOST_CHECK_EQUAL(write(vector<Stint>(), ReportWriter::Flags::by_day), "");
+}
+
+}  // namespace test
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "columnar_writer.hpp"
+#include "interval.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::ostringstream;
+using std::size_t;
+using std::string;
+using std::uint64_t;
+using std::vector;
+using swx::ColumnarWriter;
+using swx::Interval;
+using swx::Seconds;
+using swx::Stint;
+using swx::TimePoint;
+
+namespace test
+{
+
+namespace
+{
+    uint64_t read(string const& p_bytes, size_t p_offset, size_t p_size)
+    {
+        uint64_t ret = 0;
+        for (size_t i = 0; i != p_size; ++i)
+        {
+            auto const byte = static_cast<unsigned char>(p_bytes[p_offset + i]);
+            ret |= static_cast<uint64_t>(byte) << (8 * i);
+        }
+        return ret;
+    }
+
+    Stint make_stint(string const& p_activity, long long p_beginning, long long p_duration)
+    {
+        return Stint
+        (   p_activity,
+            Interval(TimePoint(std::chrono::seconds(p_beginning)), Seconds(p_duration))
+        );
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(columnar_writer)
+{
+    string const alpha = "alpha";
+    string const inactive;
+    string const beta = "beta gamma";
+    vector<Stint> const stints
+    {   make_stint(alpha, 1000, 60),
+        make_stint(inactive, 1060, 20),
+        make_stint(beta, 1080, 300),
+        make_stint(alpha, 1380, 7)
+    };
+    ostringstream oss;
+    auto const num_bytes = ColumnarWriter(stints).write(oss);
+    auto const bytes = oss.str();
+    BOOST_CHECK_EQUAL(num_bytes, bytes.size());
+
+    // header
+    BOOST_CHECK_EQUAL(bytes.substr(0, 4), "SWXC");
+    BOOST_CHECK_EQUAL(read(bytes, 4, 4), 1);
+    BOOST_CHECK_EQUAL(read(bytes, 8, 8), 3);
+    BOOST_CHECK_EQUAL(read(bytes, 16, 8), 2);
+    BOOST_CHECK_EQUAL(read(bytes, 24, 8), 15);
+
+    // beginnings
+    BOOST_CHECK_EQUAL(read(bytes, 32, 8), 1000);
+    BOOST_CHECK_EQUAL(read(bytes, 40, 8), 1080);
+    BOOST_CHECK_EQUAL(read(bytes, 48, 8), 1380);
+
+    // durations, padded to 16 bytes
+    BOOST_CHECK_EQUAL(read(bytes, 56, 4), 60);
+    BOOST_CHECK_EQUAL(read(bytes, 60, 4), 300);
+    BOOST_CHECK_EQUAL(read(bytes, 64, 4), 7);
+    BOOST_CHECK_EQUAL(read(bytes, 68, 4), 0);
+
+    // activity ids, padded to 16 bytes
+    BOOST_CHECK_EQUAL(read(bytes, 72, 4), 0);
+    BOOST_CHECK_EQUAL(read(bytes, 76, 4), 1);
+    BOOST_CHECK_EQUAL(read(bytes, 80, 4), 0);
+
+    // dictionary
+    BOOST_CHECK_EQUAL(read(bytes, 88, 8), 0);
+    BOOST_CHECK_EQUAL(read(bytes, 96, 8), 5);
+    BOOST_CHECK_EQUAL(read(bytes, 104, 8), 15);
+    BOOST_CHECK_EQUAL(bytes.substr(112, 15), "alphabeta gamma");
+    BOOST_CHECK_EQUAL(bytes.size(), 128);
+}
+
+}  // namespace test
@@ -17,9 +17,16 @@
 #include "csv_row.hpp"
 #include <boost/test/unit_test.hpp>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+using std::istringstream;
 using std::ostringstream;
+using std::string;
+using std::vector;
 using swx::CsvRow;
+using swx::read_csv_row;
 
 namespace test
 {
@@ -113,4 +120,39 @@ BOOST_AUTO_TEST_CASE(csv_row_output_operator)
         "Hello,33.905,\"\"\"Yes indeed\"\"\",-5,\"Interesting, \"\"hey\"\"?\"\n"
     );
 }
+
+BOOST_AUTO_TEST_CASE(csv_row_read_csv_row)
+{
+    vector<string> cells;
+
+    // nothing to read
+    istringstream iss0("");
+    BOOST_CHECK(!read_csv_row(iss0, cells));
+
+    // round trip of what CsvRow writes
+    CsvRow row;
+    row << "Hello" << 33.905 << "\"Yes indeed\"" << -5 << "Interesting, \"hey\"?";
+    ostringstream oss;
+    oss << row << row;
+    istringstream iss1(oss.str());
+    vector<string> const expected
+    {   "Hello", "33.905", "\"Yes indeed\"", "-5", "Interesting, \"hey\"?"
+    };
+    BOOST_CHECK(read_csv_row(iss1, cells));
+    BOOST_CHECK(cells == expected);
+    BOOST_CHECK(read_csv_row(iss1, cells));
+    BOOST_CHECK(cells == expected);
+    BOOST_CHECK(!read_csv_row(iss1, cells));
+
+    // quoted cell spanning lines, and empty cells
+    istringstream iss2("\"Hello\n\nthere\",,x\r\n");
+    vector<string> const expected2{"Hello\n\nthere", "", "x"};
+    BOOST_CHECK(read_csv_row(iss2, cells));
+    BOOST_CHECK(cells == expected2);
+
+    // unterminated quote
+    istringstream iss3("a,\"b\nc");
+    BOOST_CHECK_THROW(read_csv_row(iss3, cells), std::runtime_error);
+}
+
 }  // namespace test
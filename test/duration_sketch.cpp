@@ -0,0 +1,129 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "duration_sketch.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using std::fabs;
+using std::minstd_rand;
+using std::size_t;
+using std::sort;
+using std::uniform_int_distribution;
+using std::vector;
+using swx::DurationSketch;
+
+namespace test
+{
+
+namespace
+{
+    // Checks that each quantile estimated by p_sketch is within the sketch's
+    // relative accuracy of the duration at that rank in p_durations.
+    void check_quantiles(DurationSketch const& p_sketch, vector<unsigned long long> p_durations)
+    {
+        sort(p_durations.begin(), p_durations.end());
+        for (auto const quantile: {0.0, 0.01, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0})
+        {
+            auto const rank = static_cast<size_t>(quantile * (p_durations.size() - 1));
+            auto const expected = static_cast<double>(p_durations[rank]);
+            auto const estimate = p_sketch.quantile(quantile);
+            BOOST_CHECK
+            (   fabs(estimate - expected) <=
+                    expected * DurationSketch::k_relative_accuracy + 1e-9
+            );
+        }
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(duration_sketch_empty_and_small)
+{
+    DurationSketch sketch;
+    BOOST_CHECK_EQUAL(sketch.count(), 0u);
+    BOOST_CHECK_EQUAL(sketch.mean(), 0.0);
+    BOOST_CHECK_EQUAL(sketch.max(), 0u);
+    BOOST_CHECK_EQUAL(sketch.quantile(0.5), 0.0);
+
+    sketch.add(0);
+    sketch.add(0);
+    sketch.add(3600);
+    BOOST_CHECK_EQUAL(sketch.count(), 3u);
+    BOOST_CHECK_EQUAL(sketch.total(), 3600u);
+    BOOST_CHECK_EQUAL(sketch.mean(), 1200.0);
+    BOOST_CHECK_EQUAL(sketch.max(), 3600u);
+    BOOST_CHECK_EQUAL(sketch.quantile(0.5), 0.0);
+    BOOST_CHECK_EQUAL(sketch.quantile(1.0), 3600.0);
+    // Quantiles take the duration at rank q * (count - 1), rounded down.
+    BOOST_CHECK_EQUAL(sketch.quantile(0.99), 0.0);
+    sketch.add(7200);
+    BOOST_CHECK(fabs(sketch.quantile(0.75) - 3600.0) <= 36.0);
+}
+
+BOOST_AUTO_TEST_CASE(duration_sketch_accuracy)
+{
+    minstd_rand engine(3);
+    // Mostly short stints with a long tail, as in a typical time log.
+    uniform_int_distribution<unsigned long long> short_dist(60, 45 * 60);
+    uniform_int_distribution<unsigned long long> long_dist(1, 10 * 60 * 60);
+    vector<unsigned long long> durations;
+    DurationSketch sketch;
+    for (int i = 0; i != 10000; ++i)
+    {
+        auto const seconds = (i % 10 == 0) ? long_dist(engine) : short_dist(engine);
+        durations.push_back(seconds);
+        sketch.add(seconds);
+    }
+    check_quantiles(sketch, durations);
+}
+
+BOOST_AUTO_TEST_CASE(duration_sketch_merge)
+{
+    minstd_rand engine(8);
+    uniform_int_distribution<unsigned long long> dist(0, 100000);
+    vector<unsigned long long> all;
+    DurationSketch whole;
+    DurationSketch left;
+    DurationSketch right;
+    for (int i = 0; i != 5000; ++i)
+    {
+        // Give the parts different ranges, so that merging must extend the
+        // buckets at both ends.
+        auto const seconds = (i % 2 == 0) ? dist(engine) / 100 : dist(engine) * 10;
+        all.push_back(seconds);
+        whole.add(seconds);
+        ((i % 2 == 0) ? left : right).add(seconds);
+    }
+    DurationSketch merged;
+    merged += right;
+    merged += left;
+    merged += DurationSketch();
+    BOOST_CHECK_EQUAL(merged.count(), whole.count());
+    BOOST_CHECK_EQUAL(merged.total(), whole.total());
+    BOOST_CHECK_EQUAL(merged.max(), whole.max());
+    for (auto const quantile: {0.0, 0.1, 0.5, 0.9, 0.99, 1.0})
+    {
+        BOOST_CHECK_EQUAL(merged.quantile(quantile), whole.quantile(quantile));
+    }
+    check_quantiles(merged, all);
+}
+
+}  // namespace test
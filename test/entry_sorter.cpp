@@ -0,0 +1,138 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "entry_sorter.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::make_pair;
+using std::pair;
+using std::string;
+using std::vector;
+using swx::EntrySorter;
+using swx::TimePoint;
+
+namespace test
+{
+
+namespace
+{
+    TimePoint at(long long p_seconds)
+    {
+        return TimePoint(std::chrono::seconds(p_seconds));
+    }
+
+    // Read back every entry, appending the tags of each to *p_tags if
+    // p_tags is non-null.
+    vector<pair<string, long long>> read_all
+    (   EntrySorter& p_sorter,
+        vector<string>* p_tags = nullptr
+    )
+    {
+        vector<pair<string, long long>> ret;
+        string activity;
+        TimePoint time_point;
+        string tags;
+        bool provisional = false;
+        while (p_sorter.next(activity, time_point, tags, provisional))
+        {
+            if (p_tags) p_tags->push_back(tags);
+            auto const seconds = std::chrono::duration_cast<std::chrono::seconds>
+            (   time_point.time_since_epoch()
+            ).count();
+            ret.push_back(make_pair(activity, seconds));
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(entry_sorter_in_memory)
+{
+    EntrySorter sorter(1 << 20);
+    sorter.add("c", at(300));
+    sorter.add("a", at(100));
+    sorter.add("b", at(200));
+    sorter.add("b2", at(200));
+    vector<pair<string, long long>> const expected
+    {   {"a", 100}, {"b", 200}, {"b2", 200}, {"c", 300}
+    };
+    BOOST_CHECK(read_all(sorter) == expected);
+    BOOST_CHECK_EQUAL(sorter.num_runs(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(entry_sorter_spilling)
+{
+    // A tiny buffer forces a run to be spilled for every entry or two.
+    EntrySorter sorter(1);
+    vector<pair<string, long long>> expected;
+    for (long long i = 0; i != 50; ++i)
+    {
+        auto const seconds = (i * 37) % 50;
+        auto const activity = "activity " + std::to_string(seconds);
+        sorter.add(activity, at(seconds * 60));
+    }
+    for (long long i = 0; i != 50; ++i)
+    {
+        expected.push_back(make_pair("activity " + std::to_string(i), i * 60));
+    }
+    BOOST_CHECK(sorter.num_runs() > 1);
+    BOOST_CHECK(read_all(sorter) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(entry_sorter_provisional)
+{
+    for (auto const buffer_size: {1, 1 << 20})
+    {
+        EntrySorter sorter(buffer_size);
+        sorter.add("a", at(100));
+        sorter.add("", at(200), "", true);  // superseded by "b"
+        sorter.add("b", at(200));
+        sorter.add("", at(300), "", true);
+        sorter.add("", at(300), "", true);  // superseded by the one before
+        sorter.add("c", at(400));
+        vector<pair<string, long long>> const expected
+        {   {"a", 100}, {"b", 200}, {"", 300}, {"c", 400}
+        };
+        BOOST_CHECK(read_all(sorter) == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(entry_sorter_tags)
+{
+    for (auto const buffer_size: {1, 1 << 20})
+    {
+        EntrySorter sorter(buffer_size);
+        sorter.add("b", at(200), "billable client:acme");
+        sorter.add("a", at(100));
+        sorter.add("", at(300), "", true);
+        sorter.add("c", at(300), "TICKET-123");
+        vector<pair<string, long long>> const expected
+        {   {"a", 100}, {"b", 200}, {"c", 300}
+        };
+        vector<string> tags;
+        BOOST_CHECK(read_all(sorter, &tags) == expected);
+        BOOST_CHECK
+        (   tags == (vector<string>{"", "billable client:acme", "TICKET-123"})
+        );
+    }
+}
+
+}  // namespace test
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "goal_tracker.hpp"
+#include "time_log.hpp"
+#include "time_point.hpp"
+#include "temp_directory.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::vector;
+using swx::GoalTracker;
+using swx::TimeLog;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    unsigned int const k_formatted_buf_len = 80;
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    vector<unsigned long long> totals(GoalTracker& p_goal_tracker, TimePoint const& p_now)
+    {
+        vector<unsigned long long> ret;
+        for (auto const& status: p_goal_tracker.statuses(p_now))
+        {
+            ret.push_back(status.seconds);
+        }
+        return ret;
+    }
+
+    // The totals as counted afresh from the whole log, ignoring any state.
+    vector<unsigned long long> rebuilt_totals
+    (   TempDirectory const& p_dir,
+        TimeLog& p_time_log,
+        TimePoint const& p_now
+    )
+    {
+        std::remove(p_dir.path("goals.state").c_str());
+        GoalTracker goal_tracker(p_dir.path("goals"), p_dir.path("log.swx"), p_time_log);
+        goal_tracker.update(p_now);
+        return totals(goal_tracker, p_now);
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(goal_tracker_parsing)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "goals",
+        "# budgets\n"
+        "\n"
+        "  meetings   <= 8h/week\n"
+        "deep work >= 2.5h/day\n"
+        "admin <= 10h/month\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    GoalTracker goal_tracker(dir.path("goals"), dir.path("log.swx"), time_log);
+    auto const& goals = goal_tracker.goals();
+    BOOST_REQUIRE_EQUAL(goals.size(), 3u);
+    BOOST_CHECK_EQUAL(goals[0].activity, "meetings");
+    BOOST_CHECK(goals[0].is_maximum);
+    BOOST_CHECK_EQUAL(goals[0].seconds, 8u * 60 * 60);
+    BOOST_CHECK(goals[0].period == GoalTracker::Period::week);
+    BOOST_CHECK_EQUAL(goals[0].description, "meetings <= 8h/week");
+    BOOST_CHECK_EQUAL(goals[1].activity, "deep work");
+    BOOST_CHECK(!goals[1].is_maximum);
+    BOOST_CHECK_EQUAL(goals[1].seconds, 9000u);
+    BOOST_CHECK(goals[1].period == GoalTracker::Period::day);
+    BOOST_CHECK(goals[2].period == GoalTracker::Period::month);
+
+    for (auto const& bad: {"meetings < 8h/week\n", "meetings <= 8/week\n",
+        "meetings <= 8h/year\n", "<= 8h/week\n", "meetings <= -1h/day\n"})
+    {
+        dir.write("goals", bad);
+        BOOST_CHECK_THROW
+        (   GoalTracker(dir.path("goals"), dir.path("log.swx"), time_log),
+            runtime_error
+        );
+    }
+
+    // Without a goals file there are no goals, and nothing is saved.
+    std::remove(dir.path("goals").c_str());
+    GoalTracker no_goals(dir.path("goals"), dir.path("log.swx"), time_log);
+    BOOST_CHECK(no_goals.goals().empty());
+    no_goals.update(time_point("2020-03-04T12:00"));
+    BOOST_CHECK(!std::ifstream(dir.path("goals.state").c_str()));
+}
+
+BOOST_AUTO_TEST_CASE(goal_tracker_incremental_updates)
+{
+    TempDirectory const dir;
+    dir.write("goals", "meetings <= 2h/week\ncoding >= 3h/day\n");
+    dir.write
+    (   "log.swx",
+        "2020-03-03T09:00 meetings\n"
+        "2020-03-03T10:00 coding\n"
+        "2020-03-03T12:00 meetings\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    auto const goals = dir.path("goals");
+    auto const log = dir.path("log.swx");
+
+    auto now = time_point("2020-03-03T13:00");
+    {
+        GoalTracker goal_tracker(goals, log, time_log);
+        goal_tracker.update(now);
+        auto const statuses = goal_tracker.statuses(now);
+        BOOST_CHECK_EQUAL(statuses[0].seconds, 2u * 60 * 60);
+        BOOST_CHECK(!statuses[0].is_crossed());
+        BOOST_CHECK_EQUAL(statuses[1].seconds, 2u * 60 * 60);
+        BOOST_CHECK(!statuses[1].is_crossed());
+    }
+
+    // A switch counts only the stint it closes.
+    now = time_point("2020-03-03T14:00");
+    {
+        GoalTracker goal_tracker(goals, log, time_log);
+        time_log.append_entry("coding", time_point("2020-03-03T13:30"));
+        goal_tracker.update(now);
+        auto const statuses = goal_tracker.statuses(now);
+        BOOST_CHECK_EQUAL(statuses[0].seconds, 150u * 60);
+        BOOST_CHECK(statuses[0].is_crossed());
+        BOOST_CHECK_EQUAL(statuses[1].seconds, 150u * 60);
+        BOOST_CHECK(totals(goal_tracker, now) == rebuilt_totals(dir, time_log, now));
+    }
+
+    // Moving the last entry earlier takes time back from the stint before.
+    {
+        GoalTracker goal_tracker(goals, log, time_log);
+        time_log.amend_last("coding", time_point("2020-03-03T12:30"));
+        goal_tracker.update(now);
+        auto const statuses = goal_tracker.statuses(now);
+        BOOST_CHECK_EQUAL(statuses[0].seconds, 90u * 60);
+        BOOST_CHECK_EQUAL(statuses[1].seconds, 210u * 60);
+        BOOST_CHECK(statuses[1].is_crossed());
+        BOOST_CHECK(totals(goal_tracker, now) == rebuilt_totals(dir, time_log, now));
+    }
+
+    // Totals begin again with each period.
+    now = time_point("2020-03-04T09:00");
+    {
+        GoalTracker goal_tracker(goals, log, time_log);
+        time_log.append_entry("", time_point("2020-03-03T18:00"));
+        goal_tracker.update(now);
+        auto const statuses = goal_tracker.statuses(now);
+        BOOST_CHECK_EQUAL(statuses[0].seconds, 90u * 60);
+        BOOST_CHECK_EQUAL(statuses[1].seconds, 0u);
+        BOOST_CHECK(totals(goal_tracker, now) == rebuilt_totals(dir, time_log, now));
+    }
+    now = time_point("2020-03-10T09:00");
+    {
+        GoalTracker goal_tracker(goals, log, time_log);
+        time_log.append_entry("meetings", time_point("2020-03-10T08:00"));
+        goal_tracker.update(now);
+        auto const statuses = goal_tracker.statuses(now);
+        BOOST_CHECK_EQUAL(statuses[0].seconds, 60u * 60);
+        BOOST_CHECK_EQUAL(statuses[1].seconds, 0u);
+        BOOST_CHECK(totals(goal_tracker, now) == rebuilt_totals(dir, time_log, now));
+    }
+
+    // A change to the goals file causes the totals to be counted afresh.
+    dir.write("goals", "meetings <= 2h/week\ncoding >= 3h/month\n");
+    {
+        GoalTracker goal_tracker(goals, log, time_log);
+        goal_tracker.update(now);
+        auto const statuses = goal_tracker.statuses(now);
+        BOOST_CHECK_EQUAL(statuses[0].seconds, 60u * 60);
+        BOOST_CHECK_EQUAL(statuses[1].seconds, 450u * 60);
+    }
+}
+
+}  // namespace test
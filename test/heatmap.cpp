@@ -0,0 +1,141 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "heatmap.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+using std::string;
+using swx::Heatmap;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    unsigned long long total(Heatmap const& p_heatmap)
+    {
+        unsigned long long ret = 0;
+        for (std::size_t day = 0; day != Heatmap::k_days_per_week; ++day)
+        {
+            for (std::size_t hour = 0; hour != Heatmap::k_hours_per_day; ++hour)
+            {
+                ret += p_heatmap.seconds(day, hour);
+            }
+        }
+        return ret;
+    }
+
+    // Sets the local time zone for the lifetime of the object.
+    class TimeZoneGuard
+    {
+    public:
+        explicit TimeZoneGuard(char const* p_time_zone)
+        {
+            auto const original = std::getenv("TZ");
+            m_had_original = (original != nullptr);
+            if (m_had_original) m_original = original;
+            setenv("TZ", p_time_zone, 1);
+            tzset();
+        }
+        ~TimeZoneGuard()
+        {
+            if (m_had_original) setenv("TZ", m_original.c_str(), 1);
+            else unsetenv("TZ");
+            tzset();
+        }
+    private:
+        bool m_had_original;
+        string m_original;
+    };
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(heatmap)
+{
+    TimeZoneGuard const guard("UTC");
+    Heatmap heatmap;
+
+    // Monday 09:30 to 11:30
+    heatmap.add(time_point("2020-03-02T09:30"), time_point("2020-03-02T11:30"));
+    BOOST_CHECK_EQUAL(heatmap.seconds(0, 9), 1800u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(0, 10), 3600u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(0, 11), 1800u);
+    BOOST_CHECK_EQUAL(total(heatmap), 2u * 3600);
+
+    // Sunday 23:00 to Monday 01:00 wraps around the end of the week.
+    heatmap.add(time_point("2020-03-08T23:00"), time_point("2020-03-09T01:00"));
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 23), 3600u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(0, 0), 3600u);
+
+    // Periods of a week or more cover every hour.
+    Heatmap long_heatmap;
+    long_heatmap.add(time_point("2020-03-04T12:00"), time_point("2020-03-12T13:00"));
+    BOOST_CHECK_EQUAL(long_heatmap.seconds(0, 0), 3600u);
+    BOOST_CHECK_EQUAL(long_heatmap.seconds(2, 12), 2u * 3600);
+    BOOST_CHECK_EQUAL(long_heatmap.seconds(3, 12), 2u * 3600);
+    BOOST_CHECK_EQUAL(long_heatmap.seconds(3, 13), 3600u);
+    BOOST_CHECK_EQUAL(total(long_heatmap), (8u * 24 + 1) * 3600);
+}
+
+BOOST_AUTO_TEST_CASE(heatmap_daylight_saving)
+{
+    TimeZoneGuard const guard("America/New_York");
+    Heatmap heatmap;
+
+    // On Sunday 2020-03-08, clocks went forward from 02:00 to 03:00, so
+    // four hours elapsed between midnight and 05:00.
+    heatmap.add(time_point("2020-03-08T00:00"), time_point("2020-03-08T05:00"));
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 0), 3600u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 1), 3600u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 2), 0u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 3), 3600u);
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 4), 3600u);
+    BOOST_CHECK_EQUAL(total(heatmap), 4u * 3600);
+}
+
+BOOST_AUTO_TEST_CASE(heatmap_daylight_saving_twice)
+{
+    TimeZoneGuard const guard("America/New_York");
+    Heatmap heatmap;
+
+    // Twenty weeks, from Saturday noon to Saturday noon, in which clocks
+    // went back an hour at 02:00 on Sunday 2020-11-01 and forward an hour
+    // at 02:00 on Sunday 2021-03-14. The offset is the same at either end,
+    // but the hour from 01:00 on Sundays happened once more than the rest,
+    // and the hour from 02:00 once less.
+    heatmap.add(time_point("2020-10-31T12:00"), time_point("2021-03-20T12:00"));
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 1), 21u * 3600);
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 2), 19u * 3600);
+    BOOST_CHECK_EQUAL(heatmap.seconds(6, 3), 20u * 3600);
+    BOOST_CHECK_EQUAL(heatmap.seconds(0, 9), 20u * 3600);
+    BOOST_CHECK_EQUAL(total(heatmap), 20u * 7 * 24 * 3600);
+}
+
+}  // namespace test
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "merged_time_logs.hpp"
+#include "exact_activity_filter.hpp"
+#include "ordinary_activity_filter.hpp"
+#include "stint.hpp"
+#include "temp_directory.hpp"
+#include "time_point.hpp"
+#include "true_activity_filter.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::function;
+using std::runtime_error;
+using std::string;
+using std::vector;
+using swx::ActivityFilter;
+using swx::ExactActivityFilter;
+using swx::MergedTimeLogs;
+using swx::OrdinaryActivityFilter;
+using swx::Stint;
+using swx::TimePoint;
+using swx::TrueActivityFilter;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    unsigned int const k_formatted_buf_len = 80;
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    // The activity and beginning of each stint, as "ACTIVITY@BEGINNING".
+    vector<string> merged_stints
+    (   MergedTimeLogs const& p_logs,
+        ActivityFilter const& p_activity_filter,
+        vector<string> const& p_tags = vector<string>()
+    )
+    {
+        vector<string> ret;
+        p_logs.for_each_stint
+        (   p_activity_filter,
+            nullptr,
+            nullptr,
+            p_tags,
+            [&ret](Stint const& p_stint)
+            {
+                auto const beginning = p_stint.interval().beginning();
+                auto const minutes = std::chrono::duration_cast<std::chrono::minutes>
+                (   beginning - time_point("2020-03-02T00:00")
+                ).count();
+                ret.push_back(p_stint.activity() + "@" + std::to_string(minutes));
+            }
+        );
+        return ret;
+    }
+
+    // The message of the std::runtime_error thrown by \e p_action, or an
+    // empty string if none is thrown.
+    string error_message(function<void()> const& p_action)
+    {
+        try
+        {
+            p_action();
+        }
+        catch (runtime_error& e)
+        {
+            return e.what();
+        }
+        return string();
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(merged_time_logs_parse_source)
+{
+    auto const labelled = MergedTimeLogs::parse_source("anna=/logs/anna.swx");
+    BOOST_CHECK_EQUAL(labelled.label, "anna");
+    BOOST_CHECK_EQUAL(labelled.filepath, "/logs/anna.swx");
+
+    // An '=' after a '/' is part of the file path.
+    auto const slashed = MergedTimeLogs::parse_source("/logs/a=b.swx");
+    BOOST_CHECK_EQUAL(slashed.label, "");
+    BOOST_CHECK_EQUAL(slashed.filepath, "/logs/a=b.swx");
+
+    auto const unlabelled = MergedTimeLogs::parse_source("anna.swx");
+    BOOST_CHECK_EQUAL(unlabelled.label, "");
+    BOOST_CHECK_EQUAL(unlabelled.filepath, "anna.swx");
+}
+
+BOOST_AUTO_TEST_CASE(merged_time_logs_merging)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "anna.swx",
+        "2020-03-02T09:00 coding\t#client:acme\n"
+        "2020-03-02T10:00 emails\n"
+        "2020-03-02T11:00\n"
+    );
+    dir.write
+    (   "bob.swx",
+        "2020-03-02T08:00 emails\n"
+        "2020-03-02T09:00 coding\n"
+        "2020-03-02T10:30 testing\t#client:acme\n"
+        "2020-03-02T12:00\n"
+    );
+    TrueActivityFilter const true_filter;
+
+    // Stints are merged in order of their beginning; those beginning
+    // together come in the order of the sources. Inactive stints are not
+    // labelled.
+    MergedTimeLogs const unlabelled
+    (   {   MergedTimeLogs::parse_source(dir.path("anna.swx")),
+            MergedTimeLogs::parse_source(dir.path("bob.swx"))
+        },
+        k_time_format,
+        k_formatted_buf_len
+    );
+    BOOST_CHECK
+    (   merged_stints(unlabelled, true_filter) ==
+        (   vector<string>
+            {   "emails@480",
+                "coding@540",
+                "coding@540",
+                "emails@600",
+                "testing@630",
+                "@660",
+                "@720"
+            }
+        )
+    );
+
+    // Labels are prefixed before the activity filter is applied.
+    MergedTimeLogs const labelled
+    (   {   MergedTimeLogs::parse_source("bob=" + dir.path("bob.swx")),
+            MergedTimeLogs::parse_source("anna=" + dir.path("anna.swx"))
+        },
+        k_time_format,
+        k_formatted_buf_len
+    );
+    BOOST_CHECK
+    (   merged_stints(labelled, true_filter) ==
+        (   vector<string>
+            {   "bob emails@480",
+                "bob coding@540",
+                "anna coding@540",
+                "anna emails@600",
+                "bob testing@630",
+                "@660",
+                "@720"
+            }
+        )
+    );
+    BOOST_CHECK
+    (   merged_stints(labelled, OrdinaryActivityFilter("anna")) ==
+        (vector<string>{"anna coding@540", "anna emails@600"})
+    );
+    BOOST_CHECK
+    (   merged_stints(labelled, ExactActivityFilter("bob coding")) ==
+        (vector<string>{"bob coding@540"})
+    );
+    BOOST_CHECK(merged_stints(labelled, ExactActivityFilter("coding")).empty());
+
+    // Tags filter the stints of every log.
+    BOOST_CHECK
+    (   merged_stints(labelled, true_filter, {"client:acme"}) ==
+        (vector<string>{"anna coding@540", "bob testing@630"})
+    );
+    BOOST_CHECK(merged_stints(labelled, true_filter, {"unknown"}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(merged_time_logs_errors)
+{
+    TempDirectory const dir;
+    dir.write("good.swx", "2020-03-02T09:00 coding\n2020-03-02T10:00\n");
+    dir.write("bad.swx", "2020-03-02T09:00 coding\nnot a time stamp\n");
+    TrueActivityFilter const true_filter;
+
+    MergedTimeLogs const missing
+    (   {   MergedTimeLogs::parse_source(dir.path("good.swx")),
+            MergedTimeLogs::parse_source(dir.path("missing.swx"))
+        },
+        k_time_format,
+        k_formatted_buf_len
+    );
+    BOOST_CHECK_EQUAL
+    (   error_message([&]() { merged_stints(missing, true_filter); }),
+        "No time log at " + dir.path("missing.swx")
+    );
+
+    MergedTimeLogs const malformed
+    (   {   MergedTimeLogs::parse_source(dir.path("good.swx")),
+            MergedTimeLogs::parse_source("bad=" + dir.path("bad.swx"))
+        },
+        k_time_format,
+        k_formatted_buf_len
+    );
+    auto const message =
+        error_message([&]() { merged_stints(malformed, true_filter); });
+    auto const prefix = dir.path("bad.swx") + ": ";
+    BOOST_CHECK_EQUAL(message.substr(0, prefix.size()), prefix);
+    BOOST_CHECK_GT(message.size(), prefix.size());
+}
+
+}  // namespace test
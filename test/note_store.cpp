@@ -0,0 +1,132 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "note_store.hpp"
+#include "time_point.hpp"
+#include "temp_directory.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::runtime_error;
+using std::string;
+using std::vector;
+using swx::NoteStore;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    unsigned int const k_formatted_buf_len = 80;
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(note_store)
+{
+    TempDirectory const dir;
+
+    auto const nine = time_point("2020-03-02T09:00");
+    auto const ten = time_point("2020-03-02T10:00");
+    auto const eleven = time_point("2020-03-02T11:00");
+    {
+        NoteStore note_store(dir.path("notes"), k_time_format, k_formatted_buf_len);
+        BOOST_CHECK(note_store.notes_within(nine, eleven).empty());
+        note_store.add(ten, "reviewed the parser");
+        note_store.add(nine, "answered the backlog");
+        note_store.add(ten, "fixed the lexer");
+        BOOST_CHECK_THROW(note_store.add(ten, ""), runtime_error);
+        BOOST_CHECK_THROW(note_store.add(ten, "two\nlines"), runtime_error);
+        BOOST_CHECK
+        (   note_store.notes_within(ten, eleven) ==
+            (vector<string>{"reviewed the parser", "fixed the lexer"})
+        );
+    }
+
+    // A fresh store reads the saved index.
+    {
+        NoteStore note_store(dir.path("notes"), k_time_format, k_formatted_buf_len);
+        BOOST_CHECK
+        (   note_store.notes_within(nine, eleven) ==
+            (vector<string>{"answered the backlog", "reviewed the parser", "fixed the lexer"})
+        );
+        BOOST_CHECK(note_store.notes_within(nine, ten) == vector<string>{"answered the backlog"});
+        BOOST_CHECK(note_store.notes_within(eleven, eleven + std::chrono::hours(1)).empty());
+    }
+
+    // The index is rebuilt if the notes file is changed by other means.
+    dir.write
+    (   "notes",
+        "2020-03-02T10:30 rewritten by hand\n"
+        "2020-03-02T09:15 and out of order\n"
+    );
+    {
+        NoteStore note_store(dir.path("notes"), k_time_format, k_formatted_buf_len);
+        BOOST_CHECK
+        (   note_store.notes_within(nine, eleven) ==
+            (vector<string>{"and out of order", "rewritten by hand"})
+        );
+        note_store.add(eleven, "appended");
+    }
+    {
+        NoteStore note_store(dir.path("notes"), k_time_format, k_formatted_buf_len);
+        BOOST_CHECK
+        (   note_store.notes_within(ten, eleven + std::chrono::minutes(1)) ==
+            (vector<string>{"rewritten by hand", "appended"})
+        );
+
+        // A note added by the same store after the file is changed by other
+        // means, and left without a final newline, still gets a line of its
+        // own, and the index takes in both.
+        note_store.notes_within(nine, eleven);
+        dir.write
+        (   "notes",
+            "2020-03-02T10:30 rewritten by hand\n"
+            "2020-03-02T10:45 no final newline"
+        );
+        note_store.add(nine, "added after");
+        BOOST_CHECK
+        (   note_store.notes_within(nine, eleven) ==
+            (vector<string>{"added after", "rewritten by hand", "no final newline"})
+        );
+    }
+    {
+        NoteStore note_store(dir.path("notes"), k_time_format, k_formatted_buf_len);
+        BOOST_CHECK
+        (   note_store.notes_within(nine, eleven) ==
+            (vector<string>{"added after", "rewritten by hand", "no final newline"})
+        );
+    }
+    BOOST_CHECK_EQUAL
+    (   dir.read("notes"),
+        "2020-03-02T10:30 rewritten by hand\n"
+        "2020-03-02T10:45 no final newline\n"
+        "2020-03-02T09:00 added after\n"
+    );
+}
+
+}  // namespace test
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sliding_totals.hpp"
+#include "interval.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::max;
+using std::min;
+using std::minstd_rand;
+using std::size_t;
+using std::string;
+using std::uniform_int_distribution;
+using std::vector;
+using swx::Interval;
+using swx::Seconds;
+using swx::SlidingTotals;
+using swx::Stint;
+using swx::TimePoint;
+
+namespace test
+{
+
+namespace
+{
+    TimePoint at(long long p_seconds)
+    {
+        return TimePoint(std::chrono::seconds(p_seconds));
+    }
+
+    // Totals over the window computed from scratch, for comparison.
+    map<string, unsigned long long> brute_force_totals
+    (   vector<Stint> const& p_stints,
+        long long p_beginning,
+        long long p_ending
+    )
+    {
+        map<string, unsigned long long> ret;
+        for (auto const& stint: p_stints)
+        {
+            if (stint.activity().empty()) continue;
+            auto const interval = stint.interval();
+            auto const b = std::chrono::system_clock::to_time_t(interval.beginning());
+            auto const e = std::chrono::system_clock::to_time_t(interval.ending());
+            auto const overlap = min<long long>(e, p_ending) - max<long long>(b, p_beginning);
+            if (overlap > 0) ret[stint.activity()] += overlap;
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(sliding_totals_top)
+{
+    string const alpha = "alpha";
+    string const beta = "beta";
+    string const gamma = "gamma";
+    string const inactive;
+    vector<Stint> const stints
+    {   Stint(alpha, Interval(at(0), Seconds(100))),
+        Stint(beta, Interval(at(100), Seconds(50))),
+        Stint(inactive, Interval(at(150), Seconds(500))),
+        Stint(gamma, Interval(at(650), Seconds(50))),
+        Stint(alpha, Interval(at(700), Seconds(10)))
+    };
+    SlidingTotals totals(stints);
+    totals.move_to(at(0), at(1000));
+    auto top = totals.top(2);
+    BOOST_REQUIRE_EQUAL(top.size(), 2u);
+    BOOST_CHECK_EQUAL(*top[0].first, alpha);
+    BOOST_CHECK_EQUAL(top[0].second, 110u);
+    BOOST_CHECK_EQUAL(*top[1].first, beta);  // ties with gamma; ordered by name
+    BOOST_CHECK_EQUAL(top[1].second, 50u);
+    BOOST_CHECK(totals.top(0).empty());
+    BOOST_CHECK_EQUAL(totals.top(10).size(), 3u);
+
+    totals.move_to(at(90), at(1000));
+    top = totals.top(3);
+    BOOST_REQUIRE_EQUAL(top.size(), 3u);
+    BOOST_CHECK_EQUAL(*top[0].first, beta);
+    BOOST_CHECK_EQUAL(*top[1].first, gamma);
+    BOOST_CHECK_EQUAL(*top[2].first, alpha);
+    BOOST_CHECK_EQUAL(top[2].second, 20u);
+
+    // Moving past everything leaves nothing.
+    totals.move_to(at(2000), at(3000));
+    BOOST_CHECK(totals.top(3).empty());
+}
+
+BOOST_AUTO_TEST_CASE(sliding_totals_match_recomputation)
+{
+    vector<string> const activities{"", "a", "b", "c d", "e"};
+    minstd_rand engine(5);
+    uniform_int_distribution<int> activity_dist(0, activities.size() - 1);
+    uniform_int_distribution<int> duration_dist(1, 500);
+    vector<Stint> stints;
+    long long t = 0;
+    for (int i = 0; i != 2000; ++i)
+    {
+        auto const duration = duration_dist(engine);
+        stints.push_back
+        (   Stint(activities[activity_dist(engine)], Interval(at(t), Seconds(duration)))
+        );
+        t += duration;
+    }
+
+    SlidingTotals totals(stints);
+    uniform_int_distribution<int> step_dist(0, 3000);
+    long long beginning = -1000;
+    long long ending = 0;
+    while (beginning < t + 1000)
+    {
+        ending += step_dist(engine);
+        beginning = max(beginning + step_dist(engine), beginning);
+        if (beginning > ending) ending = beginning;
+        totals.move_to(at(beginning), at(ending));
+        auto const expected = brute_force_totals(stints, beginning, ending);
+        auto const top = totals.top(activities.size());
+        map<string, unsigned long long> actual;
+        for (auto const& entry: top) actual[*entry.first] = entry.second;
+        BOOST_REQUIRE(actual == expected);
+    }
+}
+
+}  // namespace test
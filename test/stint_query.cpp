@@ -0,0 +1,130 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "stint_query.hpp"
+#include "interval.hpp"
+#include "seconds.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <string>
+
+using std::runtime_error;
+using std::string;
+using swx::Interval;
+using swx::Seconds;
+using swx::StintQuery;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    string const k_short_time_format = "%H:%M";
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    Interval interval(string const& p_stamp, unsigned long long p_minutes)
+    {
+        return Interval(time_point(p_stamp), Seconds(p_minutes * 60), false);
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(stint_query_matches)
+{
+    StintQuery query
+    (   "(under \"client a\" or under 'client b') and not activity ~ meet "
+            "and duration > 15m",
+        k_time_format,
+        k_short_time_format
+    );
+    string const client_a = "client a";
+    string const client_a_code = "client a code";
+    string const client_a_meetings = "client a meetings";
+    string const client_c = "client c";
+    auto const morning = interval("2020-03-02T09:00", 60);
+    auto const brief = interval("2020-03-02T09:00", 15);
+    BOOST_CHECK(query.matches(client_a, morning, nullptr));
+    BOOST_CHECK(query.matches(client_a_code, morning, nullptr));
+    BOOST_CHECK(!query.matches(client_a_code, brief, nullptr));
+    BOOST_CHECK(!query.matches(client_a_meetings, morning, nullptr));
+    BOOST_CHECK(!query.matches(client_c, morning, nullptr));
+
+    // The results for an activity are cached, and the others still apply.
+    BOOST_CHECK(query.matches(client_a, morning, nullptr));
+    BOOST_CHECK(!query.matches(client_a, brief, nullptr));
+
+    StintQuery tagged
+    (   "tag billable and not tag internal and start >= 2020-03-02T09:00 "
+            "and start < 2020-03-03T00:00 and duration <= 1h",
+        k_time_format,
+        k_short_time_format
+    );
+    string const billable = "billable client:acme";
+    string const billable_internal = "billable internal";
+    string const other = "client:acme";
+    BOOST_CHECK(tagged.matches(client_a, morning, &billable));
+    BOOST_CHECK(!tagged.matches(client_a, morning, &billable_internal));
+    BOOST_CHECK(!tagged.matches(client_a, morning, &other));
+    BOOST_CHECK(!tagged.matches(client_a, morning, nullptr));
+    BOOST_CHECK(!tagged.matches(client_a, interval("2020-03-02T08:59", 60), &billable));
+    BOOST_CHECK(!tagged.matches(client_a, interval("2020-03-03T00:00", 60), &billable));
+    BOOST_CHECK(!tagged.matches(client_a, interval("2020-03-02T10:00", 61), &billable));
+
+    // "and" binds more tightly than "or", and "not" more tightly still.
+    StintQuery precedence
+    (   "activity = x or activity = y and not duration < 1h30m",
+        k_time_format,
+        k_short_time_format
+    );
+    string const x = "x";
+    string const y = "y";
+    BOOST_CHECK(precedence.matches(x, brief, nullptr));
+    BOOST_CHECK(!precedence.matches(y, morning, nullptr));
+    BOOST_CHECK(precedence.matches(y, interval("2020-03-02T09:00", 90), nullptr));
+}
+
+BOOST_AUTO_TEST_CASE(stint_query_errors)
+{
+    auto const parse = [](string const& p_expression)
+    {
+        StintQuery const query(p_expression, k_time_format, k_short_time_format);
+    };
+    BOOST_CHECK_NO_THROW(parse("under a"));
+    BOOST_CHECK_THROW(parse(""), runtime_error);
+    BOOST_CHECK_THROW(parse("under"), runtime_error);
+    BOOST_CHECK_THROW(parse("under a b"), runtime_error);
+    BOOST_CHECK_THROW(parse("(under a"), runtime_error);
+    BOOST_CHECK_THROW(parse("under a and"), runtime_error);
+    BOOST_CHECK_THROW(parse("activity < a"), runtime_error);
+    BOOST_CHECK_THROW(parse("activity ~ \"(\""), runtime_error);
+    BOOST_CHECK_THROW(parse("duration = 1h"), runtime_error);
+    BOOST_CHECK_THROW(parse("duration > 15"), runtime_error);
+    BOOST_CHECK_THROW(parse("duration > 15x"), runtime_error);
+    BOOST_CHECK_THROW(parse("start > yesterday"), runtime_error);
+    BOOST_CHECK_THROW(parse("under \"a"), runtime_error);
+    BOOST_CHECK_THROW(parse("colour = red"), runtime_error);
+}
+
+}  // namespace test
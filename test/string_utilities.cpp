@@ -18,6 +18,7 @@
 #include <boost/test/unit_test.hpp>
 #include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,7 @@ BOOST_AUTO_TEST_CASE(trim)
     BOOST_CHECK_EQUAL(trim("9hello "), "9hello");
     BOOST_CHECK_EQUAL(trim("\n\n\nhello "), "hello");
     BOOST_CHECK_EQUAL(trim(" \nhello there\t "), "hello there");
+    BOOST_CHECK_EQUAL(trim(" caf\xc3\xa9 r\xc3\xa9union\xc2\xa0 "), "caf\xc3\xa9 r\xc3\xa9union\xc2\xa0");
 }
 
 BOOST_AUTO_TEST_CASE(squish)
@@ -110,6 +112,31 @@ BOOST_AUTO_TEST_CASE(split)
     BOOST_CHECK(split(str7, ',') == vec7);
 }
 
+BOOST_AUTO_TEST_CASE(split_command_line)
+{
+    using swx::split_command_line;
+
+    BOOST_CHECK(split_command_line("").empty());
+    BOOST_CHECK(split_command_line("  \t ").empty());
+
+    vector<string> const vec0{"switch", "email", "admin"};
+    BOOST_CHECK(split_command_line("switch email admin") == vec0);
+    BOOST_CHECK(split_command_line("  switch\temail   admin ") == vec0);
+
+    vector<string> const vec1{"rename", "email admin", "mail"};
+    BOOST_CHECK(split_command_line("rename 'email admin' mail") == vec1);
+    BOOST_CHECK(split_command_line("rename \"email admin\" mail") == vec1);
+    BOOST_CHECK(split_command_line("rename email\\ admin mail") == vec1);
+
+    vector<string> const vec2{"p", "", "it's"};
+    BOOST_CHECK(split_command_line("p '' \"it's\"") == vec2);
+
+    vector<string> const vec3{"switch", "caf\xc3\xa9", "\xc3\xa9t\xc3\xa9"};
+    BOOST_CHECK(split_command_line("switch caf\xc3\xa9 \xc3\xa9t\xc3\xa9") == vec3);
+
+    BOOST_CHECK_THROW(split_command_line("s 'email"), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(wrap)
 {
     using swx::wrap;
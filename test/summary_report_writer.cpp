@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "summary_report_writer.hpp"
+#include "interval.hpp"
+#include "report_writer.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::ostringstream;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+using swx::Interval;
+using swx::ReportWriter;
+using swx::Seconds;
+using swx::Stint;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    Stint make_stint(string const& p_activity, string const& p_beginning, unsigned int p_hours)
+    {
+        return Stint(p_activity, Interval(time_point(p_beginning), Seconds(p_hours * 60 * 60)));
+    }
+
+    // A comparison of the day of 2020-03-02 with the period from the start
+    // of 2020-03-01 to 11:00 on 2020-03-02.
+    string write_comparison(ReportWriter::Flags::Type p_flags)
+    {
+        vector<Stint> const stints
+        {   make_stint("gamma", "2020-03-01T10:00", 2),
+            make_stint("alpha", "2020-03-02T09:00", 4),
+            make_stint("beta", "2020-03-02T14:00", 1)
+        };
+        vector<ReportWriter::Period> const periods
+        {   ReportWriter::Period
+            (   time_point("2020-03-02T00:00"),
+                time_point("2020-03-03T00:00")
+            ),
+            ReportWriter::Period
+            (   time_point("2020-03-01T00:00"),
+                time_point("2020-03-02T11:00")
+            )
+        };
+        ReportWriter::Options const options(1, 10, 1, 6, 80, k_time_format, 0, periods);
+        unique_ptr<ReportWriter> const writer
+        (   ReportWriter::create(stints, options, p_flags)
+        );
+        ostringstream oss;
+        writer->write(oss);
+        return oss.str();
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(summary_report_writer_comparison)
+{
+    // The stint for alpha is counted in both periods, in part in the
+    // second; beta and gamma are each in one period only.
+    string const periods =
+        "[1] 2020-03-02T00:00 to 2020-03-03T00:00\n"
+        "[2] 2020-03-01T00:00 to 2020-03-02T11:00\n"
+        "\n";
+    BOOST_CHECK_EQUAL
+    (   write_comparison(ReportWriter::Flags::none),
+        periods +
+        "     [1]     [2]  [1]-[2]\n"
+        "[    5.0     4.0    +1.0 ] \n"
+        "                          [    4.0     2.0    +2.0 ] alpha\n"
+        "                          [    1.0     0.0    +1.0 ] beta\n"
+        "                          [    0.0     2.0    -2.0 ] gamma\n"
+    );
+    BOOST_CHECK_EQUAL
+    (   write_comparison(ReportWriter::Flags::verbose),
+        periods +
+        "         [1]     [2]  [1]-[2]\n"
+        "alpha    4.0     2.0    +2.0\n"
+        "beta     1.0     0.0    +1.0\n"
+        "gamma    0.0     2.0    -2.0\n"
+        "\n"
+        "TOTAL    5.0     4.0    +1.0\n"
+    );
+    BOOST_CHECK_EQUAL
+    (   write_comparison(ReportWriter::Flags::succinct),
+        "   [1]     [2]  [1]-[2]\n"
+        "   5.0     4.0    +1.0\n"
+    );
+
+    string const csv_header =
+        "2020-03-02T00:00 to 2020-03-03T00:00,"
+        "2020-03-01T00:00 to 2020-03-02T11:00,"
+        "change from 2020-03-01T00:00 to 2020-03-02T11:00\n";
+    BOOST_CHECK_EQUAL
+    (   write_comparison(ReportWriter::Flags::csv),
+        "activity," + csv_header +
+        "alpha,4,2,2\n"
+        "beta,1,0,1\n"
+        "gamma,0,2,-2\n"
+    );
+    BOOST_CHECK_EQUAL
+    (   write_comparison(ReportWriter::Flags::csv | ReportWriter::Flags::succinct),
+        csv_header +
+        "5,4,1\n"
+    );
+}
+
+}  // namespace test
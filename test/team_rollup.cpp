@@ -0,0 +1,126 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "team_rollup.hpp"
+#include "seconds.hpp"
+#include "time_point.hpp"
+#include "temp_directory.hpp"
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+using std::string;
+using swx::Seconds;
+using swx::TeamRollup;
+using swx::TimePoint;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    unsigned int const k_formatted_buf_len = 80;
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    Seconds seconds_on
+    (   TeamRollup::Rollups const& p_rollups,
+        string const& p_day,
+        string const& p_activity
+    )
+    {
+        auto const day_it = p_rollups.find(time_point(p_day + "T00:00"));
+        if (day_it == p_rollups.end()) return Seconds(0);
+        auto const it = day_it->second.find(p_activity);
+        return (it == day_it->second.end()) ? Seconds(0) : it->second;
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(team_rollup)
+{
+    TempDirectory const dir;
+    string const anna_head =
+        "2020-03-02T09:00 emails\n"
+        "2020-03-02T10:00 coding\n"
+        "2020-03-02T11:30\n";
+    dir.write("anna.swx", anna_head);
+    dir.write("bob.swx", "2020-03-02T23:00 coding\n2020-03-03T01:00\n");
+    dir.write("notes.txt", "not a log\n");
+
+    TeamRollup rollup(dir.path(), k_time_format, k_formatted_buf_len);
+    BOOST_CHECK(rollup.refresh().empty());
+    auto const now = time_point("2020-03-04T00:00");
+    auto rollups = rollup.rollups(now);
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "emails") == Seconds(3600));
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "coding") == Seconds(5400 + 3600));
+    BOOST_CHECK(seconds_on(rollups, "2020-03-03", "coding") == Seconds(3600));
+
+    // Unchanged logs are not read again.
+    BOOST_CHECK(rollup.refresh().empty());
+    BOOST_CHECK_EQUAL(rollup.bytes_read_by_last_refresh(), 0u);
+
+    // Of a log that has grown, only the last line previously parsed, and
+    // what follows it, are read; and an incomplete final line is left
+    // until it is complete.
+    string const anna_tail = "2020-03-03T09:00 emails\n2020-03-03T09:3";
+    dir.write("anna.swx", anna_tail, true);
+    BOOST_CHECK(rollup.refresh().empty());
+    BOOST_CHECK_EQUAL
+    (   rollup.bytes_read_by_last_refresh(),
+        string("2020-03-02T11:30\n").size() + anna_tail.size()
+    );
+    rollups = rollup.rollups(now);
+    BOOST_CHECK(seconds_on(rollups, "2020-03-03", "emails") == Seconds(15 * 3600));
+    dir.write("anna.swx", "0\n", true);
+    BOOST_CHECK(rollup.refresh().empty());
+    rollups = rollup.rollups(now);
+    BOOST_CHECK(seconds_on(rollups, "2020-03-03", "emails") == Seconds(30 * 60));
+
+    // The incremental result matches that of parsing everything afresh.
+    TeamRollup fresh(dir.path(), k_time_format, k_formatted_buf_len);
+    BOOST_CHECK(fresh.refresh().empty());
+    BOOST_CHECK(fresh.rollups(now) == rollups);
+
+    // A log that is rewritten is parsed afresh, and its old contribution
+    // dropped.
+    dir.write("anna.swx", "2020-03-02T09:00 reading\n2020-03-02T09:06\n");
+    BOOST_CHECK(rollup.refresh().empty());
+    rollups = rollup.rollups(now);
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "emails") == Seconds(0));
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "reading") == Seconds(360));
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "coding") == Seconds(3600));
+
+    // A log that cannot be parsed is reported and left out.
+    dir.write("bob.swx", "garbage\n");
+    BOOST_CHECK_EQUAL(rollup.refresh().size(), 1u);
+    rollups = rollup.rollups(now);
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "coding") == Seconds(0));
+
+    // Labelling activities by user
+    dir.write("bob.swx", "2020-03-02T23:00 coding\n2020-03-03T01:00\n");
+    TeamRollup labelled(dir.path(), k_time_format, k_formatted_buf_len, true);
+    BOOST_CHECK(labelled.refresh().empty());
+    rollups = labelled.rollups(now);
+    BOOST_CHECK(seconds_on(rollups, "2020-03-02", "anna reading") == Seconds(360));
+    BOOST_CHECK(seconds_on(rollups, "2020-03-03", "bob coding") == Seconds(3600));
+}
+
+}  // namespace test
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "temp_directory.hpp"
+#include "file_utilities.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ios>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using std::ifstream;
+using std::ios;
+using std::ofstream;
+using std::ostringstream;
+using std::string;
+using swx::directory_entries;
+
+namespace test
+{
+
+TempDirectory::TempDirectory()
+{
+    char dirpath[] = "/tmp/swx_test_XXXXXX";
+    BOOST_REQUIRE(mkdtemp(dirpath) != nullptr);
+    m_dirpath = dirpath;
+}
+
+TempDirectory::~TempDirectory()
+{
+    try
+    {
+        for (auto const& filename: directory_entries(m_dirpath))
+        {
+            std::remove(path(filename).c_str());
+        }
+    }
+    catch (...)
+    {
+    }
+    rmdir(m_dirpath.c_str());
+}
+
+string const&
+TempDirectory::path() const
+{
+    return m_dirpath;
+}
+
+string
+TempDirectory::path(string const& p_filename) const
+{
+    return m_dirpath + '/' + p_filename;
+}
+
+void
+TempDirectory::write
+(   string const& p_filename,
+    string const& p_contents,
+    bool p_append
+) const
+{
+    ofstream ofs
+    (   path(p_filename).c_str(),
+        p_append ? (ios::out | ios::app) : (ios::out | ios::trunc)
+    );
+    ofs << p_contents;
+}
+
+string
+TempDirectory::read(string const& p_filename) const
+{
+    ifstream ifs(path(p_filename).c_str());
+    ostringstream oss;
+    oss << ifs.rdbuf();
+    return oss.str();
+}
+
+}  // namespace test
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_temp_directory_hpp_3064815927740521
+#define GUARD_temp_directory_hpp_3064815927740521
+
+#include <string>
+
+namespace test
+{
+
+/**
+ * A temporary directory for the files used by a test. It is removed on
+ * destruction, together with every file in it, whether or not the test
+ * has passed.
+ */
+class TempDirectory
+{
+// special member functions
+public:
+    TempDirectory();
+    TempDirectory(TempDirectory const& rhs) = delete;
+    TempDirectory(TempDirectory&& rhs) = delete;
+    TempDirectory& operator=(TempDirectory const& rhs) = delete;
+    TempDirectory& operator=(TempDirectory&& rhs) = delete;
+    ~TempDirectory();
+
+// ordinary member functions
+public:
+
+    /**
+     * @returns the path of the directory.
+     */
+    std::string const& path() const;
+
+    /**
+     * @returns the path of the file named \e p_filename in the directory,
+     * which need not exist.
+     */
+    std::string path(std::string const& p_filename) const;
+
+    /**
+     * Write \e p_contents to the file named \e p_filename in the directory,
+     * replacing its contents, or appending to them if \e p_append is true.
+     */
+    void write
+    (   std::string const& p_filename,
+        std::string const& p_contents,
+        bool p_append = false
+    ) const;
+
+    /**
+     * @returns the contents of the file named \e p_filename in the
+     * directory, or an empty string if there is no such file.
+     */
+    std::string read(std::string const& p_filename) const;
+
+// member variables
+private:
+    std::string m_dirpath;
+
+};  // class TempDirectory
+
+}  // namespace test
+
+#endif  // GUARD_temp_directory_hpp_3064815927740521
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "time_log.hpp"
+#include "exact_activity_filter.hpp"
+#include "interval.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include "true_activity_filter.hpp"
+#include "temp_directory.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::pair;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::vector;
+using swx::ExactActivityFilter;
+using swx::Stint;
+using swx::TimeLog;
+using swx::TimePoint;
+using swx::TrueActivityFilter;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+    unsigned int const k_formatted_buf_len = 80;
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    vector<string> stint_activities(vector<Stint> const& p_stints)
+    {
+        vector<string> ret;
+        for (auto const& stint: p_stints) ret.push_back(stint.activity());
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(time_log_activities_at)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "log.swx",
+        "2020-03-02T09:00 emails\n"
+        "2020-03-02T10:00 coding\n"
+        "2020-03-02T12:00\n"
+        "2020-03-02T13:00 coding\n"
+        "2020-03-02T13:30 meetings\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    vector<string> const stamps
+    {   "2020-03-02T12:30", "2020-03-02T08:59", "2020-03-02T09:00",
+        "2020-03-02T11:59", "2020-03-03T00:00", "2020-03-02T13:00"
+    };
+    vector<string> const expected
+    {   "", "", "emails", "coding", "meetings", "coding"
+    };
+    vector<TimePoint> time_points;
+    for (auto const& stamp: stamps) time_points.push_back(time_point(stamp));
+
+    // Few enough to be found by binary search.
+    for (size_t i = 0; i != time_points.size(); ++i)
+    {
+        auto const activities = time_log.activities_at(vector<TimePoint>{time_points[i]});
+        BOOST_REQUIRE_EQUAL(activities.size(), 1u);
+        BOOST_CHECK_EQUAL(activities[0], expected[i]);
+    }
+
+    // Enough to be sorted and found in a single pass.
+    auto const activities = time_log.activities_at(time_points);
+    BOOST_REQUIRE_EQUAL(activities.size(), expected.size());
+    for (size_t i = 0; i != expected.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(activities[i], expected[i]);
+    }
+    BOOST_CHECK(time_log.activities_at(vector<TimePoint>()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(time_log_tags)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "log.swx",
+        "2020-03-02T09:00 emails\n"
+        "2020-03-02T10:00 coding\t#billable #client:acme\n"
+        "2020-03-02T12:00\n"
+        "2020-03-02T13:00 coding\t#client:acme\n"
+        "2020-03-02T13:30 meetings\t#billable  #client:acme \n"
+        "2020-03-02T14:00 coding\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    TrueActivityFilter const true_filter;
+    auto const all = time_log.get_stints(true_filter, nullptr, nullptr);
+    BOOST_REQUIRE_EQUAL(all.size(), 6u);
+    BOOST_CHECK_EQUAL(all[1].activity(), "coding");
+    BOOST_CHECK_EQUAL(all[4].activity(), "meetings");
+
+    auto const acme = time_log.get_stints(true_filter, nullptr, nullptr, {"client:acme"});
+    BOOST_CHECK(stint_activities(acme) == (vector<string>{"coding", "coding", "meetings"}));
+    BOOST_CHECK(acme[0].interval().duration() == std::chrono::hours(2));
+    BOOST_CHECK(!acme[2].interval().is_live());
+
+    auto const billable_acme =
+        time_log.get_stints(true_filter, nullptr, nullptr, {"client:acme", "billable"});
+    BOOST_CHECK(stint_activities(billable_acme) == (vector<string>{"coding", "meetings"}));
+    BOOST_CHECK(time_log.get_stints(true_filter, nullptr, nullptr, {"unknown"}).empty());
+
+    // Tags combine with the activity filter and the date range.
+    auto const begin = time_point("2020-03-02T11:00");
+    auto const end = time_point("2020-03-02T13:40");
+    auto const ranged = time_log.get_stints
+    (   ExactActivityFilter("coding"),
+        &begin,
+        &end,
+        {"client:acme"}
+    );
+    BOOST_REQUIRE_EQUAL(ranged.size(), 2u);
+    BOOST_CHECK(ranged[0].interval().beginning() == begin);
+    BOOST_CHECK(ranged[0].interval().duration() == std::chrono::hours(1));
+    BOOST_CHECK(ranged[1].interval().beginning() == time_point("2020-03-02T13:00"));
+
+    // Tags survive appending, amending and saving, in a canonical order.
+    time_log.append_entry("emails", time_point("2020-03-02T15:00"), {"zeta", "alpha", "zeta"});
+    time_log.append_entry("reading", time_point("2020-03-02T16:00"), {"alpha"});
+    time_log.amend_last("writing", time_point("2020-03-02T16:00"), {"beta"});
+    BOOST_CHECK_THROW
+    (   time_log.append_entry("reading", time_point("2020-03-02T17:00"), {"a b"}),
+        runtime_error
+    );
+    TimeLog reloaded(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    auto const alpha = reloaded.get_stints(true_filter, nullptr, nullptr, {"alpha"});
+    BOOST_CHECK(stint_activities(alpha) == (vector<string>{"emails"}));
+    auto const beta = reloaded.get_stints(true_filter, nullptr, nullptr, {"beta"});
+    BOOST_CHECK(stint_activities(beta) == (vector<string>{"writing"}));
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-02T09:00 emails\n"
+        "2020-03-02T10:00 coding\t#billable #client:acme\n"
+        "2020-03-02T12:00\n"
+        "2020-03-02T13:00 coding\t#client:acme\n"
+        "2020-03-02T13:30 meetings\t#billable #client:acme\n"
+        "2020-03-02T14:00 coding\n"
+        "2020-03-02T15:00 emails\t#alpha #zeta\n"
+        "2020-03-02T16:00 writing\t#beta\n"
+    );
+
+    // Renaming re-indexes entries it causes to be merged, each merged
+    // entry bearing the tags of both.
+    reloaded.rename_activity(ExactActivityFilter("meetings"), "coding");
+    auto const renamed = reloaded.get_stints(true_filter, nullptr, nullptr, {"billable"});
+    BOOST_CHECK(stint_activities(renamed) == (vector<string>{"coding", "coding"}));
+    auto const merged = reloaded.get_stints(true_filter, nullptr, nullptr, {"client:acme"});
+    BOOST_CHECK(stint_activities(merged) == (vector<string>{"coding", "coding"}));
+    BOOST_CHECK(renamed[1].interval().duration() == std::chrono::hours(2));
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-02T09:00 emails\n"
+        "2020-03-02T10:00 coding\t#billable #client:acme\n"
+        "2020-03-02T12:00\n"
+        "2020-03-02T13:00 coding\t#billable #client:acme\n"
+        "2020-03-02T15:00 emails\t#alpha #zeta\n"
+        "2020-03-02T16:00 writing\t#beta\n"
+    );
+
+    // Switching to the current activity leaves its tags unchanged.
+    reloaded.append_entry("writing", time_point("2020-03-02T17:00"), {"gamma"});
+    BOOST_CHECK(reloaded.get_stints(true_filter, nullptr, nullptr, {"gamma"}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(time_log_tabbed_activities)
+{
+    // What follows a tab is only taken for tags if marked as such; so
+    // activities containing tabs, as in logs written before tags were
+    // supported, are read as before, and keep their tabs when saved.
+    TempDirectory const dir;
+    dir.write
+    (   "log.swx",
+        "2020-03-02T09:00 coding\tparser\n"
+        "2020-03-02T10:00 coding\tlexer\t#billable\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    TrueActivityFilter const true_filter;
+    auto const all = time_log.get_stints(true_filter, nullptr, nullptr);
+    BOOST_CHECK(stint_activities(all) == (vector<string>{"coding\tparser", "coding\tlexer"}));
+    auto const billable = time_log.get_stints(true_filter, nullptr, nullptr, {"billable"});
+    BOOST_CHECK(stint_activities(billable) == (vector<string>{"coding\tlexer"}));
+    time_log.append_entry("emails", time_point("2020-03-02T11:00"), {"admin"});
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-02T09:00 coding\tparser\n"
+        "2020-03-02T10:00 coding\tlexer\t#billable\n"
+        "2020-03-02T11:00 emails\t#admin\n"
+    );
+
+    // Tags that are marked, but not all marked, are ambiguous.
+    BOOST_CHECK_THROW
+    (   time_log.parse_entry("2020-03-02T12:00 coding\t#billable client:acme", 1),
+        runtime_error
+    );
+    BOOST_CHECK_THROW(time_log.parse_entry("2020-03-02T12:00 coding\t# billable", 1), runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(time_log_merge_provisional)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "log.swx",
+        "2020-03-02T10:00 beta\n"
+        "2020-03-02T12:00\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+
+    // The stints alpha 09:00-10:00 and gamma 11:00-11:30, as read from CSV;
+    // the cessation ending alpha yields to the existing entry for beta.
+    vector<pair<string, bool>> const merged
+    {   {"alpha", false}, {"", true}, {"gamma", false}, {"", true}
+    };
+    vector<string> const stamps
+    {   "2020-03-02T09:00", "2020-03-02T10:00", "2020-03-02T11:00", "2020-03-02T11:30"
+    };
+    size_t i = 0;
+    auto const num_added = time_log.merge_entries
+    (   [&]
+        (   string& p_activity,
+            TimePoint& p_time_point,
+            string& p_tags,
+            bool& p_provisional
+        )
+        {
+            if (i == merged.size()) return false;
+            p_activity = merged[i].first;
+            p_tags.clear();
+            p_provisional = merged[i].second;
+            p_time_point = time_point(stamps[i]);
+            ++i;
+            return true;
+        }
+    );
+    BOOST_CHECK_EQUAL(num_added, 2u);
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-02T09:00 alpha\n"
+        "2020-03-02T10:00 beta\n"
+        "2020-03-02T11:00 gamma\n"
+        "2020-03-02T11:30\n"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(time_log_merge_tags)
+{
+    TempDirectory const dir;
+    dir.write
+    (   "log.swx",
+        "2020-03-02T09:00 alpha\t#billable\n"
+        "2020-03-02T11:00\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+
+    // Entries read from another log keep their tags; and the entry for
+    // alpha at 10:00, being collapsed into the one at 09:00, adds its tags
+    // to those of that entry.
+    vector<string> const lines
+    {   "2020-03-02T10:00 alpha\t#client:acme #billable",
+        "2020-03-02T10:30 beta\t#TICKET-123",
+        "2020-03-02T12:00"
+    };
+    size_t i = 0;
+    auto const num_added = time_log.merge_entries
+    (   [&]
+        (   string& p_activity,
+            TimePoint& p_time_point,
+            string& p_tags,
+            bool& p_provisional
+        )
+        {
+            if (i == lines.size()) return false;
+            p_tags.clear();
+            auto const entry = time_log.parse_entry(lines[i], i + 1, &p_tags);
+            p_activity = entry.first;
+            p_time_point = entry.second;
+            p_provisional = false;
+            ++i;
+            return true;
+        }
+    );
+    BOOST_CHECK_EQUAL(num_added, 1u);
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-02T09:00 alpha\t#billable #client:acme\n"
+        "2020-03-02T10:30 beta\t#TICKET-123\n"
+        "2020-03-02T11:00\n"
+    );
+    TrueActivityFilter const true_filter;
+    auto const acme = time_log.get_stints(true_filter, nullptr, nullptr, {"client:acme"});
+    BOOST_CHECK(stint_activities(acme) == (vector<string>{"alpha"}));
+    auto const ticket = time_log.get_stints(true_filter, nullptr, nullptr, {"TICKET-123"});
+    BOOST_CHECK(stint_activities(ticket) == (vector<string>{"beta"}));
+}
+
+BOOST_AUTO_TEST_CASE(time_log_insert_and_delete)
+{
+    TempDirectory const dir;
+
+    // The first line is not as it would be written, so survives only for
+    // as long as changes are appended to the file, rather than rewriting it.
+    dir.write
+    (   "log.swx",
+        "2020-03-01T09:00  alpha\n"
+        "2020-03-02T09:00 beta\n"
+        "2020-03-03T09:00 gamma\n"
+        "2020-03-04T09:00 delta\n"
+        "2020-03-05T09:00 epsilon\n"
+        "2020-03-06T09:00 zeta\n"
+        "2020-03-07T09:00 eta\n"
+        "2020-03-08T09:00 theta\n"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    TrueActivityFilter const true_filter;
+
+    // Inserting an entry after the last one appends it.
+    BOOST_CHECK_EQUAL(time_log.insert_entry("iota", time_point("2020-03-09T09:00")), "theta");
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-01T09:00  alpha\n"
+        "2020-03-02T09:00 beta\n"
+        "2020-03-03T09:00 gamma\n"
+        "2020-03-04T09:00 delta\n"
+        "2020-03-05T09:00 epsilon\n"
+        "2020-03-06T09:00 zeta\n"
+        "2020-03-07T09:00 eta\n"
+        "2020-03-08T09:00 theta\n"
+        "2020-03-09T09:00 iota\n"
+    );
+
+    // Inserting a switch to the activity that follows absorbs the
+    // following entry; and inserting anywhere else rewrites the file.
+    BOOST_CHECK_EQUAL
+    (   time_log.insert_entry("eta", time_point("2020-03-07T08:00"), {"early"}),
+        "zeta"
+    );
+    BOOST_CHECK_EQUAL
+    (   time_log.insert_entry("zeta", time_point("2020-03-06T12:00")),
+        "zeta"
+    );
+    BOOST_CHECK_THROW
+    (   time_log.insert_entry("iota", time_point("2020-03-08T09:00")),
+        runtime_error
+    );
+    BOOST_CHECK_EQUAL
+    (   time_log.insert_entry("zeta", time_point("2020-03-07T20:00")),
+        "eta"
+    );
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-02T09:00 beta\n"
+        "2020-03-03T09:00 gamma\n"
+        "2020-03-04T09:00 delta\n"
+        "2020-03-05T09:00 epsilon\n"
+        "2020-03-06T09:00 zeta\n"
+        "2020-03-07T08:00 eta\t#early\n"
+        "2020-03-07T20:00 zeta\n"
+        "2020-03-08T09:00 theta\n"
+        "2020-03-09T09:00 iota\n"
+    );
+    auto const early = time_log.get_stints(true_filter, nullptr, nullptr, {"early"});
+    BOOST_REQUIRE_EQUAL(early.size(), 1u);
+    BOOST_CHECK(early[0].interval().duration() == std::chrono::hours(12));
+
+    // Deleting an entry between two of the same activity merges them.
+    BOOST_CHECK_EQUAL(time_log.delete_entry(time_point("2020-03-07T08:00")), "eta");
+    BOOST_CHECK_THROW(time_log.delete_entry(time_point("2020-03-07T08:00")), runtime_error);
+    BOOST_CHECK(time_log.get_stints(true_filter, nullptr, nullptr, {"early"}).empty());
+    TimeLog reloaded(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    auto const stints = reloaded.get_stints(true_filter, nullptr, nullptr);
+    BOOST_REQUIRE_EQUAL(stints.size(), 8u);
+    BOOST_CHECK_EQUAL(stints[5].activity(), "zeta");
+    BOOST_CHECK(stints[5].interval().duration() == std::chrono::hours(48));
+    BOOST_CHECK_EQUAL(reloaded.delete_entry(time_point("2020-03-02T09:00")), "beta");
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-03T09:00 gamma\n"
+        "2020-03-04T09:00 delta\n"
+        "2020-03-05T09:00 epsilon\n"
+        "2020-03-06T09:00 zeta\n"
+        "2020-03-08T09:00 theta\n"
+        "2020-03-09T09:00 iota\n"
+    );
+
+    // Appending to a file that does not end with the last entry as it
+    // would be written rewrites the file instead.
+    dir.write
+    (   "log.swx",
+        "2020-03-01T09:00  alpha\n"
+        "2020-03-02T09:00  beta\n"
+    );
+    TimeLog rewritten(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    rewritten.append_entry("gamma", time_point("2020-03-03T09:00"));
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-02T09:00 beta\n"
+        "2020-03-03T09:00 gamma\n"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(time_log_torn_append)
+{
+    TempDirectory const dir;
+    TrueActivityFilter const true_filter;
+
+    // An unreadable final line without a newline, as left by an append cut
+    // short, is ignored, and dropped when the log is next saved.
+    dir.write
+    (   "log.swx",
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-02T09:00 beta\n"
+        "2020-03-0"
+    );
+    TimeLog time_log(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    auto const stints = time_log.get_stints(true_filter, nullptr, nullptr);
+    BOOST_CHECK(stint_activities(stints) == (vector<string>{"alpha", "beta"}));
+    time_log.append_entry("gamma", time_point("2020-03-03T09:00"));
+    BOOST_CHECK_EQUAL
+    (   dir.read("log.swx"),
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-02T09:00 beta\n"
+        "2020-03-03T09:00 gamma\n"
+    );
+
+    // An unreadable line anywhere else is still an error.
+    dir.write
+    (   "log.swx",
+        "2020-03-01T09:00 alpha\n"
+        "2020-03-0\n"
+    );
+    TimeLog corrupt(dir.path("log.swx"), k_time_format, k_formatted_buf_len);
+    BOOST_CHECK_THROW(corrupt.get_stints(true_filter, nullptr, nullptr), runtime_error);
+}
+
+}  // namespace test
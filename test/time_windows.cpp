@@ -0,0 +1,197 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "time_windows.hpp"
+#include "interval.hpp"
+#include "recurring_window.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::minstd_rand;
+using std::runtime_error;
+using std::size_t;
+using std::string;
+using std::uniform_int_distribution;
+using std::vector;
+using swx::Interval;
+using swx::RecurringWindow;
+using swx::Seconds;
+using swx::Stint;
+using swx::TimePoint;
+using swx::TimeWindows;
+using swx::day_begin;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+
+    TimePoint time_point(string const& p_stamp)
+    {
+        return long_time_stamp_to_point(p_stamp, k_time_format);
+    }
+
+    bool is_in(vector<RecurringWindow> const& p_windows, TimePoint const& p_time_point)
+    {
+        for (int days_diff: {0, -1})
+        {
+            TimePoint beginning, ending;
+            for (auto const& window: p_windows)
+            {
+                if
+                (   window.occurs_on(day_begin(p_time_point, days_diff), beginning, ending) &&
+                    (beginning <= p_time_point) &&
+                    (p_time_point < ending)
+                )
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // The minutes of p_stint within the windows, counted one by one.
+    unsigned long long brute_force_minutes
+    (   Stint const& p_stint,
+        vector<RecurringWindow> const& p_within,
+        vector<RecurringWindow> const& p_except
+    )
+    {
+        unsigned long long ret = 0;
+        auto const interval = p_stint.interval();
+        for (auto t = interval.beginning(); t < interval.ending(); t += std::chrono::minutes(1))
+        {
+            if ((p_within.empty() || is_in(p_within, t)) && !is_in(p_except, t)) ++ret;
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(recurring_window)
+{
+    TimePoint beginning, ending;
+    RecurringWindow const working_hours("Mon-Fri 09:00-17:30");
+    BOOST_CHECK(working_hours.occurs_on(time_point("2020-03-02T00:00"), beginning, ending));
+    BOOST_CHECK(beginning == time_point("2020-03-02T09:00"));
+    BOOST_CHECK(ending == time_point("2020-03-02T17:30"));
+    BOOST_CHECK(working_hours.occurs_on(time_point("2020-03-06T00:00"), beginning, ending));
+    BOOST_CHECK(!working_hours.occurs_on(time_point("2020-03-07T00:00"), beginning, ending));
+
+    RecurringWindow const nights("22:00-06:00");
+    BOOST_CHECK(nights.occurs_on(time_point("2020-03-07T00:00"), beginning, ending));
+    BOOST_CHECK(beginning == time_point("2020-03-07T22:00"));
+    BOOST_CHECK(ending == time_point("2020-03-08T06:00"));
+
+    RecurringWindow const long_weekend("fri-MON");
+    BOOST_CHECK(long_weekend.occurs_on(time_point("2020-03-08T00:00"), beginning, ending));
+    BOOST_CHECK(beginning == time_point("2020-03-08T00:00"));
+    BOOST_CHECK(ending == time_point("2020-03-09T00:00"));
+    BOOST_CHECK(!long_weekend.occurs_on(time_point("2020-03-04T00:00"), beginning, ending));
+
+    RecurringWindow const odd_days("Mon,Wed 00:00-24:00");
+    BOOST_CHECK(odd_days.occurs_on(time_point("2020-03-04T00:00"), beginning, ending));
+    BOOST_CHECK(ending == time_point("2020-03-05T00:00"));
+    BOOST_CHECK(!odd_days.occurs_on(time_point("2020-03-03T00:00"), beginning, ending));
+
+    for (auto const& bad: {"", "Funday", "09:00", "09:00-25:00", "09:60-10:00",
+        "Mon 09:00-10:00 extra", "Mon Tue", "Mon-", "9:00-10:00"})
+    {
+        BOOST_CHECK_THROW(RecurringWindow{bad}, runtime_error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(time_windows_restrict)
+{
+    vector<RecurringWindow> const within
+    {   RecurringWindow("Mon-Fri 09:00-17:30"),
+        RecurringWindow("Sat 22:00-02:00"),
+        RecurringWindow("Tue 17:00-19:00")
+    };
+    vector<RecurringWindow> const except
+    {   RecurringWindow("12:30-13:30"),
+        RecurringWindow("Fri"),
+        RecurringWindow("Sun 01:00-01:30")
+    };
+    vector<string> const activities{"alpha", "beta", string()};
+
+    minstd_rand engine(5);
+    uniform_int_distribution<int> minutes_distribution(1, 60 * 30);
+    uniform_int_distribution<size_t> activity_distribution(0, activities.size() - 1);
+    for (int trial = 0; trial != 3; ++trial)
+    {
+        // With trial 2, the stints overlap, as when several logs are merged.
+        vector<Stint> stints;
+        auto beginning = time_point("2020-02-27T07:13");
+        auto const last_ending = time_point("2020-03-20T00:00");
+        while (beginning < last_ending)
+        {
+            auto const minutes = minutes_distribution(engine);
+            auto const& activity = activities[activity_distribution(engine)];
+            Interval const interval
+            (   beginning,
+                Seconds(minutes * 60),
+                (trial == 1) && (beginning + std::chrono::minutes(minutes) >= last_ending)
+            );
+            stints.push_back(Stint(activity, interval));
+            beginning += std::chrono::minutes((trial == 2) ? (minutes / 2 + 1) : minutes);
+        }
+
+        TimeWindows windows(within, except);
+        for (auto const& stint: stints)
+        {
+            auto const interval = stint.interval();
+            unsigned long long seconds = 0;
+            TimePoint previous_ending = interval.beginning();
+            bool has_live_part = false;
+            windows.restrict
+            (   stint,
+                [&](Stint const& p_part)
+                {
+                    auto const part = p_part.interval();
+                    BOOST_CHECK(&p_part.activity() == &stint.activity());
+                    BOOST_CHECK(part.beginning() >= previous_ending);
+                    BOOST_CHECK(part.ending() <= interval.ending());
+                    BOOST_CHECK(part.duration().count() > 0);
+                    previous_ending = part.ending();
+                    seconds += part.duration().count();
+                    has_live_part = has_live_part || part.is_live();
+                }
+            );
+            BOOST_CHECK_EQUAL(seconds, brute_force_minutes(stint, within, except) * 60);
+            if (has_live_part) BOOST_CHECK(interval.is_live());
+        }
+    }
+
+    // Without windows, stints are passed through unchanged.
+    TimeWindows const none{vector<RecurringWindow>(), vector<RecurringWindow>()};
+    BOOST_CHECK(none.is_unrestricted());
+}
+
+}  // namespace test
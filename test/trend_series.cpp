@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "trend_series.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using std::fabs;
+using std::invalid_argument;
+using std::min;
+using std::minstd_rand;
+using std::size_t;
+using std::uniform_int_distribution;
+using std::vector;
+using swx::TrendSeries;
+
+namespace test
+{
+
+BOOST_AUTO_TEST_CASE(trend_series_moving_averages)
+{
+    TrendSeries series(vector<size_t>{2, 3}, 1);
+    BOOST_CHECK_EQUAL(series.days(), 0u);
+    BOOST_CHECK_EQUAL(series.latest(), 0u);
+    BOOST_CHECK_EQUAL(series.moving_average(0), 0.0);
+
+    series.push(60);
+    BOOST_CHECK_EQUAL(series.latest(), 60u);
+    BOOST_CHECK_EQUAL(series.moving_average(0), 60.0);  // over the one day so far
+    BOOST_CHECK_EQUAL(series.moving_average(1), 60.0);
+
+    series.push(120);
+    series.push(0);
+    BOOST_CHECK_EQUAL(series.days(), 3u);
+    BOOST_CHECK_EQUAL(series.latest(), 0u);
+    BOOST_CHECK_EQUAL(series.sum(0), 120u);
+    BOOST_CHECK_EQUAL(series.sum(1), 180u);
+    BOOST_CHECK_EQUAL(series.moving_average(0), 60.0);
+    BOOST_CHECK_EQUAL(series.moving_average(1), 60.0);
+
+    series.push(30);
+    BOOST_CHECK_EQUAL(series.sum(0), 30u);
+    BOOST_CHECK_EQUAL(series.sum(1), 150u);
+
+    // With a span of one day, the smoothed average is just the latest day.
+    BOOST_CHECK_EQUAL(series.smoothed_average(), 30.0);
+
+    BOOST_CHECK_THROW(TrendSeries(vector<size_t>{0}, 1), invalid_argument);
+    BOOST_CHECK_THROW(TrendSeries(vector<size_t>{7}, 0), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(trend_series_smoothing_and_leading_days)
+{
+    // Span 3 gives each day a weight of a half.
+    TrendSeries series(vector<size_t>{2}, 3);
+    series.push(100);
+    BOOST_CHECK_EQUAL(series.smoothed_average(), 100.0);
+    series.push(0);
+    BOOST_CHECK_EQUAL(series.smoothed_average(), 50.0);
+    series.push(50);
+    BOOST_CHECK_EQUAL(series.smoothed_average(), 50.0);
+
+    // Leading days count as zeros, including for the smoothed average.
+    TrendSeries late(vector<size_t>{4}, 3, 2);
+    BOOST_CHECK_EQUAL(late.days(), 2u);
+    late.push(100);
+    BOOST_CHECK_EQUAL(late.sum(0), 100u);
+    BOOST_CHECK_EQUAL(late.moving_average(0), 100.0 / 3);
+    BOOST_CHECK_EQUAL(late.smoothed_average(), 50.0);
+}
+
+BOOST_AUTO_TEST_CASE(trend_series_match_recomputation)
+{
+    vector<size_t> const periods{1, 7, 30, 5};
+    TrendSeries series(periods, 10);
+    minstd_rand engine(11);
+    uniform_int_distribution<unsigned long long> seconds_dist(0, 8 * 60 * 60);
+    vector<unsigned long long> days;
+    double smoothed = 0.0;
+    for (int i = 0; i != 400; ++i)
+    {
+        auto const seconds = (i % 13 == 0) ? 0 : seconds_dist(engine);
+        days.push_back(seconds);
+        series.push(seconds);
+        smoothed = (i == 0) ? seconds : (smoothed + (2.0 / 11) * (seconds - smoothed));
+        for (size_t j = 0; j != periods.size(); ++j)
+        {
+            auto const n = min(periods[j], days.size());
+            unsigned long long expected = 0;
+            for (size_t k = days.size() - n; k != days.size(); ++k) expected += days[k];
+            BOOST_REQUIRE_EQUAL(series.sum(j), expected);
+            BOOST_REQUIRE_EQUAL(series.moving_average(j), static_cast<double>(expected) / n);
+        }
+        BOOST_REQUIRE(fabs(series.smoothed_average() - smoothed) < 1e-6);
+    }
+}
+
+}  // namespace test
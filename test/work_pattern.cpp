@@ -0,0 +1,129 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "work_pattern.hpp"
+#include "interval.hpp"
+#include "seconds.hpp"
+#include "stint.hpp"
+#include "time_point.hpp"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+using swx::Interval;
+using swx::Seconds;
+using swx::Stint;
+using swx::TimePoint;
+using swx::WorkPattern;
+using swx::long_time_stamp_to_point;
+
+namespace test
+{
+
+namespace
+{
+    string const k_time_format = "%Y-%m-%dT%H:%M";
+
+    // The stints from each stamp to the next, on the activity given with it.
+    vector<Stint> stints
+    (   vector<string const*> const& p_activities,
+        vector<string> const& p_stamps,
+        bool p_is_last_live = false
+    )
+    {
+        vector<Stint> ret;
+        for (vector<string>::size_type i = 0; i + 1 < p_stamps.size(); ++i)
+        {
+            auto const beginning = long_time_stamp_to_point(p_stamps[i], k_time_format);
+            auto const ending = long_time_stamp_to_point(p_stamps[i + 1], k_time_format);
+            auto const seconds = std::chrono::duration_cast<Seconds>(ending - beginning);
+            auto const is_live = p_is_last_live && (i + 2 == p_stamps.size());
+            ret.push_back(Stint(*p_activities[i], Interval(beginning, seconds, is_live)));
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(work_pattern)
+{
+    string const coding = "coding";
+    string const email = "email";
+    string const meetings = "meetings";
+    string const inactive;
+    auto const day_stints = stints
+    (   {&inactive, &coding, &email, &coding, &inactive, &meetings, &inactive, &email, &coding},
+        {   "2020-03-02T08:00", "2020-03-02T09:00", "2020-03-02T11:00", "2020-03-02T11:30",
+            "2020-03-02T12:00", "2020-03-02T13:00", "2020-03-02T14:00", "2020-03-03T09:00",
+            "2020-03-03T09:30", "2020-03-03T10:00"
+        },
+        true
+    );
+    WorkPattern pattern;
+    for (auto const& stint: day_stints) pattern.add(stint);
+    BOOST_CHECK_EQUAL(pattern.days(), 2u);
+    BOOST_CHECK_EQUAL(pattern.switches(), 3u);
+    BOOST_CHECK_EQUAL(pattern.most_daily_switches(), 2u);
+    BOOST_CHECK_CLOSE(pattern.mean_daily_switches(), 1.5, 0.0001);
+    BOOST_CHECK_CLOSE(pattern.median_daily_switches(), 1.5, 0.0001);
+
+    // The live stint is not a focus block, and the leading inactive stint
+    // is not a gap.
+    BOOST_CHECK_EQUAL(pattern.focus_blocks().count(), 5u);
+    BOOST_CHECK_EQUAL(pattern.focus_blocks().max(), 7200u);
+    BOOST_CHECK_EQUAL(pattern.focus_blocks().total(), (120u + 30 + 30 + 60 + 30) * 60);
+    BOOST_CHECK_EQUAL(pattern.idle_gaps().count(), 2u);
+    BOOST_CHECK_EQUAL(pattern.idle_gaps().total(), (60u + 19 * 60) * 60);
+
+    auto const top = pattern.top_switches(10);
+    BOOST_REQUIRE_EQUAL(top.size(), 1u);
+    BOOST_CHECK(top[0].first == &coding);
+    BOOST_CHECK(top[0].second == &email);
+    BOOST_CHECK_EQUAL(top[0].count, 3u);
+    BOOST_CHECK(pattern.top_switches(0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(work_pattern_included)
+{
+    string const coding = "coding";
+    string const email = "email";
+    string const meetings = "meetings";
+    auto const day_stints = stints
+    (   {&coding, &email, &meetings, &email, &coding, &meetings},
+        {   "2020-03-02T09:00", "2020-03-02T10:00", "2020-03-02T11:00", "2020-03-02T12:00",
+            "2020-03-02T13:00", "2020-03-02T14:00", "2020-03-02T15:00"
+        }
+    );
+    WorkPattern pattern;
+    for (auto const& stint: day_stints) pattern.add(stint, &stint.activity() == &coding);
+
+    // Only switches to or from coding are counted.
+    BOOST_CHECK_EQUAL(pattern.switches(), 3u);
+    BOOST_CHECK_EQUAL(pattern.focus_blocks().count(), 2u);
+    auto const top = pattern.top_switches(10);
+    BOOST_REQUIRE_EQUAL(top.size(), 2u);
+    BOOST_CHECK(top[0].first == &coding);
+    BOOST_CHECK(top[0].second == &email);
+    BOOST_CHECK_EQUAL(top[0].count, 2u);
+    BOOST_CHECK(top[1].second == &meetings);
+    BOOST_CHECK_EQUAL(top[1].count, 1u);
+}
+
+}  // namespace test
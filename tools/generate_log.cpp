@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.hpp"
+#include "log_generator.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::ostream;
+using std::runtime_error;
+using std::string;
+using std::stringstream;
+using swx::Config;
+using swx::LogGenerator;
+
+namespace
+{
+    string const k_usage =
+        "Usage: swx_generate_log [OPTION...] [FILE]\n"
+        "\n"
+        "Writes a synthetic time log to FILE, or to standard output.\n"
+        "\n"
+        "Options:\n"
+        "  --entries N                number of entries (default 100000)\n"
+        "  --seed N                   seed for the random number generator (default 1)\n"
+        "  --activities N             number of distinct activities (default 500)\n"
+        "  --zipf S                   exponent of the Zipf distribution of activity\n"
+        "                             popularity (default 1.0)\n"
+        "  --depth N                  maximum number of components in an activity\n"
+        "                             name (default 4)\n"
+        "  --fanout N                 number of possible components under each\n"
+        "                             parent (default 6)\n"
+        "  --burst-probability P      probability of an entry starting a burst of\n"
+        "                             rapid switching (default 0.03)\n"
+        "  --idle-probability P       probability of an entry being followed by an\n"
+        "                             idle gap (default 0.01)\n"
+        "  --long-name-probability P  probability of an entry having a very long\n"
+        "                             activity name (default 0.001)\n"
+        "  --format-string FORMAT     timestamp format (default %Y-%m-%dT%H:%M)\n"
+        "  --formatted-buf-len N      as for the configuration option (default 50)\n"
+        "  --config FILE              take the timestamp format and formatted_buf_len\n"
+        "                             from the swx configuration file FILE";
+
+    template <typename T>
+    T parse_arg(string const& p_option, string const& p_arg)
+    {
+        T ret;
+        stringstream ss(p_arg);
+        ss >> ret;
+        if (!ss || !ss.eof())
+        {
+            throw runtime_error("Could not parse argument to " + p_option + ": " + p_arg);
+        }
+        return ret;
+    }
+
+}  // end anonymous namespace
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        LogGenerator::Options options;
+        string output_filepath;
+        for (int i = 1; i < argc; ++i)
+        {
+            string const arg(argv[i]);
+            if (arg == "-h" || arg == "--help")
+            {
+                cout << k_usage << endl;
+                return EXIT_SUCCESS;
+            }
+            if (arg.empty() || arg[0] != '-')
+            {
+                if (!output_filepath.empty())
+                {
+                    cerr << k_usage << endl;
+                    return EXIT_FAILURE;
+                }
+                output_filepath = arg;
+                continue;
+            }
+            if (i + 1 == argc)
+            {
+                cerr << k_usage << endl;
+                return EXIT_FAILURE;
+            }
+            string const value(argv[++i]);
+            if (arg == "--entries") options.num_entries = parse_arg<size_t>(arg, value);
+            else if (arg == "--seed") options.seed = parse_arg<unsigned int>(arg, value);
+            else if (arg == "--activities") options.num_activities = parse_arg<size_t>(arg, value);
+            else if (arg == "--zipf") options.zipf_exponent = parse_arg<double>(arg, value);
+            else if (arg == "--depth") options.depth = parse_arg<unsigned int>(arg, value);
+            else if (arg == "--fanout") options.fanout = parse_arg<unsigned int>(arg, value);
+            else if (arg == "--burst-probability") options.burst_probability = parse_arg<double>(arg, value);
+            else if (arg == "--idle-probability") options.idle_probability = parse_arg<double>(arg, value);
+            else if (arg == "--long-name-probability") options.long_name_probability = parse_arg<double>(arg, value);
+            else if (arg == "--format-string") options.time_format = value;
+            else if (arg == "--formatted-buf-len") options.formatted_buf_len = parse_arg<unsigned int>(arg, value);
+            else if (arg == "--config")
+            {
+                Config const config(value);
+                options.time_format = config.time_format();
+                options.formatted_buf_len = config.formatted_buf_len();
+            }
+            else
+            {
+                cerr << k_usage << endl;
+                return EXIT_FAILURE;
+            }
+        }
+        LogGenerator const generator(options);
+        if (output_filepath.empty())
+        {
+            generator.write(cout);
+        }
+        else
+        {
+            ofstream ofs(output_filepath.c_str());
+            if (!ofs)
+            {
+                throw runtime_error("Could not open file for writing: " + output_filepath);
+            }
+            generator.write(ofs);
+        }
+        return EXIT_SUCCESS;
+    }
+    catch (runtime_error& e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "log_generator.hpp"
+#include "time_point.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::bernoulli_distribution;
+using std::min;
+using std::mt19937;
+using std::ostream;
+using std::pow;
+using std::runtime_error;
+using std::set;
+using std::size_t;
+using std::string;
+using std::to_string;
+using std::uint32_t;
+using std::uniform_int_distribution;
+using std::uniform_real_distribution;
+using std::upper_bound;
+using std::vector;
+
+namespace chrono = std::chrono;
+
+namespace swx
+{
+
+namespace
+{
+    // Component names for each level of the activity hierarchy; deeper
+    // levels reuse the last.
+    vector<string> const k_level_words
+    {   "area", "project", "task", "subtask", "item", "step", "part"
+    };
+
+    // Seconds between ordinary switches, between switches within a burst,
+    // and of idle gaps, respectively.
+    unsigned int const k_min_gap = 60;
+    unsigned int const k_max_gap = 30 * 60;
+    unsigned int const k_min_burst_gap = 0;
+    unsigned int const k_max_burst_gap = 2 * 60;
+    unsigned int const k_min_idle_gap = 4 * 60 * 60;
+    unsigned int const k_max_idle_gap = 24 * 60 * 60;
+
+    unsigned int const k_min_burst_length = 3;
+    unsigned int const k_max_burst_length = 12;
+
+    std::size_t const k_num_long_names = 8;
+    unsigned int const k_min_long_name_components = 20;
+    unsigned int const k_max_long_name_components = 200;
+
+    // Marks an entry recording a cessation of activity.
+    uint32_t const k_inactive = static_cast<uint32_t>(-1);
+
+    // Number of bytes to accumulate before writing to the output stream.
+    size_t const k_chunk_size = 1 << 16;
+
+    struct PlannedEntry
+    {
+        uint32_t activity;  // index into names, or k_inactive
+        uint32_t gap;  // seconds until the next entry
+    };
+
+    string component(unsigned int p_level, unsigned int p_index)
+    {
+        auto const& word = k_level_words[min<size_t>(p_level, k_level_words.size() - 1)];
+        return word + to_string(p_index + 1);
+    }
+
+}  // end anonymous namespace
+
+LogGenerator::LogGenerator(Options const& p_options): m_options(p_options)
+{
+}
+
+LogGenerator::~LogGenerator() = default;
+
+void
+LogGenerator::write(ostream& p_os, TimePoint const& p_latest) const
+{
+    auto const& opts = m_options;
+    if (opts.depth == 0 || opts.fanout == 0 || opts.num_activities == 0)
+    {
+        throw runtime_error("Depth, fan-out and number of activities must be positive.");
+    }
+    for (auto const probability:
+        {opts.burst_probability, opts.idle_probability, opts.long_name_probability})
+    {
+        if (probability < 0.0 || probability > 1.0)
+        {
+            throw runtime_error("Probabilities must be between 0 and 1.");
+        }
+    }
+    mt19937 engine(opts.seed);
+
+    // The pool of ordinary activity names, in descending order of
+    // popularity. It may be smaller than requested, if the hierarchy does
+    // not allow for that many activities.
+    auto const max_activities =
+        pow(static_cast<double>(opts.fanout), static_cast<double>(opts.depth));
+    auto const num_activities = static_cast<size_t>
+    (   min(static_cast<double>(opts.num_activities), max_activities)
+    );
+    vector<string> names;
+    set<string> seen;
+    uniform_int_distribution<unsigned int> depth_dist(1, opts.depth);
+    uniform_int_distribution<unsigned int> fanout_dist(0, opts.fanout - 1);
+    for (size_t attempts = 0; names.size() != num_activities; ++attempts)
+    {
+        if (attempts == num_activities * 100)
+        {
+            break;  // The hierarchy is too small; make do.
+        }
+        string name;
+        auto const depth = depth_dist(engine);
+        for (unsigned int level = 0; level != depth; ++level)
+        {
+            if (level != 0) name += ' ';
+            name += component(level, fanout_dist(engine));
+        }
+        if (seen.insert(name).second) names.push_back(name);
+    }
+    auto const num_ordinary_names = names.size();
+
+    // Very long names are kept apart from the Zipf-distributed pool, so
+    // that they remain rare.
+    uniform_int_distribution<unsigned int> long_length_dist
+    (   k_min_long_name_components,
+        k_max_long_name_components
+    );
+    for (size_t i = 0; i != k_num_long_names; ++i)
+    {
+        string name;
+        auto const length = long_length_dist(engine);
+        for (unsigned int level = 0; level != length; ++level)
+        {
+            if (level != 0) name += ' ';
+            name += component(level, fanout_dist(engine));
+        }
+        names.push_back(name);
+    }
+
+    // Cumulative Zipf weights, for sampling by binary search.
+    vector<double> cumulative_weights;
+    cumulative_weights.reserve(num_ordinary_names);
+    double total_weight = 0.0;
+    for (size_t rank = 1; rank <= num_ordinary_names; ++rank)
+    {
+        total_weight += 1.0 / pow(static_cast<double>(rank), opts.zipf_exponent);
+        cumulative_weights.push_back(total_weight);
+    }
+    uniform_real_distribution<double> weight_dist(0.0, total_weight);
+    auto const popular_activity = [&]()
+    {
+        auto const it = upper_bound
+        (   cumulative_weights.begin(),
+            cumulative_weights.end(),
+            weight_dist(engine)
+        );
+        auto const index = min<size_t>
+        (   it - cumulative_weights.begin(),
+            num_ordinary_names - 1
+        );
+        return static_cast<uint32_t>(index);
+    };
+
+    // Plan all the entries before writing any of them, so that the total
+    // span is known and the log can be anchored to end at p_latest.
+    bernoulli_distribution burst_dist(opts.burst_probability);
+    bernoulli_distribution idle_dist(opts.idle_probability);
+    bernoulli_distribution long_name_dist(opts.long_name_probability);
+    uniform_int_distribution<uint32_t> gap_dist(k_min_gap, k_max_gap);
+    uniform_int_distribution<uint32_t> burst_gap_dist(k_min_burst_gap, k_max_burst_gap);
+    uniform_int_distribution<uint32_t> idle_gap_dist(k_min_idle_gap, k_max_idle_gap);
+    uniform_int_distribution<unsigned int> burst_length_dist
+    (   k_min_burst_length,
+        k_max_burst_length
+    );
+    uniform_int_distribution<uint32_t> long_name_index_dist
+    (   static_cast<uint32_t>(num_ordinary_names),
+        static_cast<uint32_t>(names.size() - 1)
+    );
+    vector<PlannedEntry> plan;
+    plan.reserve(opts.num_entries);
+    unsigned int burst_remaining = 0;
+    unsigned long long total_seconds = 0;
+    while (plan.size() != opts.num_entries)
+    {
+        PlannedEntry entry;
+        if (burst_remaining != 0)
+        {
+            --burst_remaining;
+            entry.activity = popular_activity();
+            entry.gap = burst_gap_dist(engine);
+        }
+        else if (idle_dist(engine))
+        {
+            entry.activity = k_inactive;
+            entry.gap = idle_gap_dist(engine);
+        }
+        else
+        {
+            if (burst_dist(engine)) burst_remaining = burst_length_dist(engine);
+            entry.activity =
+                (long_name_dist(engine) ? long_name_index_dist(engine) : popular_activity());
+            entry.gap = gap_dist(engine);
+        }
+        plan.push_back(entry);
+        total_seconds += entry.gap;
+    }
+    if (!plan.empty()) total_seconds -= plan.back().gap;
+
+    auto time_point = p_latest - chrono::seconds(total_seconds);
+    string chunk;
+    chunk.reserve(k_chunk_size * 2);
+    for (auto const& entry: plan)
+    {
+        chunk += time_point_to_stamp(time_point, opts.time_format, opts.formatted_buf_len);
+        if (entry.activity != k_inactive)
+        {
+            chunk += ' ';
+            chunk += names[entry.activity];
+        }
+        chunk += '\n';
+        if (chunk.size() >= k_chunk_size)
+        {
+            p_os.write(chunk.data(), chunk.size());
+            chunk.clear();
+        }
+        time_point += chrono::seconds(entry.gap);
+    }
+    p_os.write(chunk.data(), chunk.size());
+    if (!p_os)
+    {
+        throw runtime_error("Error writing generated log.");
+    }
+}
+
+}  // namespace swx
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018 Matthew Harvey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GUARD_log_generator_hpp_2946610358817427
+#define GUARD_log_generator_hpp_2946610358817427
+
+#include "time_point.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace swx
+{
+
+/**
+ * Generates synthetic time logs, resembling those kept over years of real
+ * use, for benchmarking and for reproducing performance problems.
+ *
+ * Activities are named by paths of between one and Options::depth
+ * space-separated components, each level having Options::fanout possible
+ * components under each parent. Their popularity follows a Zipf
+ * distribution. Ordinary switches are interspersed with bursts of rapid
+ * switching, idle gaps (recorded as cessations of activity, followed by a
+ * long pause) and occasional very long activity names.
+ *
+ * The same Options (including the seed) always produce the same sequence
+ * of entries, apart from their placement in time: the log is placed to
+ * end no later than the time of generation.
+ */
+class LogGenerator
+{
+// nested types
+public:
+    struct Options
+    {
+        std::size_t num_entries = 100000;
+        unsigned int seed = 1;
+        std::size_t num_activities = 500;
+        double zipf_exponent = 1.0;
+        unsigned int depth = 4;
+        unsigned int fanout = 6;
+
+        /** Probability that an entry starts a burst of rapid switching. */
+        double burst_probability = 0.03;
+
+        /** Probability that an entry is a cessation followed by an idle gap. */
+        double idle_probability = 0.01;
+
+        /** Probability that an entry is for an activity with a very long name. */
+        double long_name_probability = 0.001;
+
+        std::string time_format = "%Y-%m-%dT%H:%M";
+        unsigned int formatted_buf_len = 50;
+    };
+
+// special member functions
+public:
+    explicit LogGenerator(Options const& p_options);
+    LogGenerator(LogGenerator const& rhs) = delete;
+    LogGenerator(LogGenerator&& rhs) = delete;
+    LogGenerator& operator=(LogGenerator const& rhs) = delete;
+    LogGenerator& operator=(LogGenerator&& rhs) = delete;
+    ~LogGenerator();
+
+// ordinary member functions
+public:
+
+    /**
+     * Write the entries to \e p_os, in the format in which TimeLog
+     * saves them, with the last entry no later than \e p_latest.
+     *
+     * @exception std::runtime_error if the options are invalid, or on
+     * failure to write to \e p_os.
+     */
+    void write(std::ostream& p_os, TimePoint const& p_latest = now()) const;
+
+// member variables
+private:
+    Options const m_options;
+
+};  // class LogGenerator
+
+}  // namespace swx
+
+#endif  // GUARD_log_generator_hpp_2946610358817427